@@ -0,0 +1,371 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.05.12 Initial version.
+//      2026.05.14 Added `queue_overflow_policy::conflate` support.
+//      2026.06.27 Messages are conflated by the conflation key.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include "writer_queue_limits.hpp"
+#include <pfs/assert.hpp>
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <utility>
+
+NETTY__NAMESPACE_BEGIN
+
+/**
+ * Pool of message queues (one per priority) with byte/message accounting and limits.
+ *
+ * @details Used by writer queues as storage for the outgoing messages.
+ */
+template <typename Archive, std::size_t N>
+class bounded_queue_pool
+{
+    static_assert(N > 0, "Priority count must be at least 1");
+
+public:
+    using archive_type = Archive;
+
+private:
+    struct item
+    {
+        archive_type data;
+        std::string key; // Conflation key
+    };
+
+    struct bucket
+    {
+        std::deque<item> q;
+        std::size_t bytes {0};
+        std::size_t max_bytes {0};
+        std::size_t max_messages {0};
+
+        // Front message is partially packed into a frame, so it can't be dropped
+        bool front_acquired {false};
+
+        std::size_t first_droppable () const noexcept
+        {
+            return front_acquired ? 1 : 0;
+        }
+    };
+
+private:
+    std::array<bucket, N> _buckets;
+    std::size_t _bytes {0};
+    std::size_t _messages {0};
+    writer_queue_limits _limits;
+
+public:
+    bounded_queue_pool () {}
+
+public:
+    writer_queue_limits const & limits () const noexcept
+    {
+        return _limits;
+    }
+
+    /**
+     * Sets limits for the whole pool and resets limits for each priority queue to
+     * @a limits.max_priority_bytes and @a limits.max_priority_messages.
+     */
+    void set_limits (writer_queue_limits const & limits)
+    {
+        _limits = limits;
+
+        for (auto & b: _buckets) {
+            b.max_bytes = limits.max_priority_bytes;
+            b.max_messages = limits.max_priority_messages;
+        }
+    }
+
+    /**
+     * Sets limits for the queue with specified @a priority.
+     */
+    void set_priority_limits (int priority, std::size_t max_bytes, std::size_t max_messages)
+    {
+        auto & b = _buckets.at(priority);
+        b.max_bytes = max_bytes;
+        b.max_messages = max_messages;
+    }
+
+    bool empty () const noexcept
+    {
+        return _messages == 0;
+    }
+
+    bool empty (int priority) const
+    {
+        return _buckets.at(priority).q.empty();
+    }
+
+    std::size_t bytes () const noexcept
+    {
+        return _bytes;
+    }
+
+    std::size_t bytes (int priority) const
+    {
+        return _buckets.at(priority).bytes;
+    }
+
+    std::size_t messages () const noexcept
+    {
+        return _messages;
+    }
+
+    std::size_t messages (int priority) const
+    {
+        return _buckets.at(priority).q.size();
+    }
+
+    queue_occupancy occupancy () const noexcept
+    {
+        queue_occupancy result;
+        result.bytes = _bytes;
+        result.messages = _messages;
+        return result;
+    }
+
+    /**
+     * Pushes message @a data into the queue with specified @a priority according to limits and
+     * overflow policy.
+     *
+     * @param key Conflation key: with queue_overflow_policy::conflate the pending messages with
+     *        the same key are dropped on overflow (e.g. the topic of the message).
+     */
+    queue_occupancy push (int priority, archive_type && data, std::string key = std::string{})
+    {
+        auto & b = _buckets.at(priority);
+        auto n = data.size();
+        std::array<std::size_t, N> drops; // Number of messages to drop from each queue
+        bool conflate = false;
+
+        drops.fill(0);
+
+        if (!plan_drops(priority, n, key, drops, & conflate)) {
+            auto result = occupancy();
+            result.accepted = false;
+            return result;
+        }
+
+        std::size_t dropped = 0;
+
+        if (conflate) {
+            dropped = drop_conflated(b, key, drops[priority]);
+        } else {
+            for (std::size_t i = 0; i < N; i++) {
+                if (drops[i] > 0) {
+                    drop_oldest(_buckets[i], drops[i]);
+                    dropped += drops[i];
+                }
+            }
+        }
+
+        b.q.push_back(item{std::move(data), std::move(key)});
+        b.bytes += n;
+        _bytes += n;
+        _messages++;
+
+        auto result = occupancy();
+        result.dropped = dropped;
+        return result;
+    }
+
+    /**
+     * Calls @a f with the front message of the queue with specified @a priority to consume
+     * (partially or entirely) its content.
+     *
+     * @details Callback @a f signature must match:
+     *          void (archive_type & front)
+     */
+    template <typename F>
+    void consume_front (int priority, F && f)
+    {
+        auto & b = _buckets.at(priority);
+
+        PFS__THROW_UNEXPECTED(!b.q.empty(), "");
+
+        auto & front = b.q.front().data;
+        auto initial_size = front.size();
+
+        f(front);
+
+        PFS__THROW_UNEXPECTED(front.size() <= initial_size, "");
+
+        auto consumed = initial_size - front.size();
+        b.bytes -= consumed;
+        _bytes -= consumed;
+
+        // Check topmost message is processed
+        if (front.empty()) {
+            b.q.pop_front();
+            b.front_acquired = false;
+            _messages--;
+        } else {
+            b.front_acquired = true;
+        }
+    }
+
+private:
+    static std::size_t excess (std::size_t value, std::size_t limit) noexcept
+    {
+        return (limit > 0 && value > limit) ? value - limit : 0;
+    }
+
+    /**
+     * Plans drops to free space for the new message of size @a n with conflation @a key.
+     *
+     * @param conflate Set to @c true if the pending messages with the same @a key must be dropped
+     *        in addition to the oldest ones (see drop_conflated()).
+     *
+     * @return @c false if message must be rejected.
+     */
+    bool plan_drops (int priority, std::size_t n, std::string const & key
+        , std::array<std::size_t, N> & drops, bool * conflate) const
+    {
+        auto const & b = _buckets[priority];
+
+        // Message never fits the limits
+        if ((b.max_bytes > 0 && n > b.max_bytes) || (_limits.max_bytes > 0 && n > _limits.max_bytes))
+            return false;
+
+        auto priority_excess_bytes = excess(b.bytes + n, b.max_bytes);
+        auto priority_excess_messages = excess(b.q.size() + 1, b.max_messages);
+        auto excess_bytes = excess(_bytes + n, _limits.max_bytes);
+        auto excess_messages = excess(_messages + 1, _limits.max_messages);
+
+        if (priority_excess_bytes == 0 && priority_excess_messages == 0
+                && excess_bytes == 0 && excess_messages == 0) {
+            return true;
+        }
+
+        if (_limits.overflow_policy == queue_overflow_policy::reject)
+            return false;
+
+        std::size_t freed_bytes = 0;
+        std::size_t freed_messages = 0;
+
+        auto plan_drop = [this, & drops, & freed_bytes, & freed_messages] (std::size_t index) {
+            auto const & bk = _buckets[index];
+            auto pos = bk.first_droppable() + drops[index];
+
+            if (pos >= bk.q.size())
+                return false;
+
+            freed_bytes += bk.q[pos].data.size();
+            freed_messages++;
+            drops[index]++;
+            return true;
+        };
+
+        // Drop pending messages of the same priority with the same key, i.e. keep the latest
+        // message per key. If it's not enough, drop the oldest messages with other keys.
+        if (_limits.overflow_policy == queue_overflow_policy::conflate) {
+            auto enough = [&] () {
+                return freed_bytes >= priority_excess_bytes && freed_messages >= priority_excess_messages
+                    && freed_bytes >= excess_bytes && freed_messages >= excess_messages;
+            };
+
+            for (auto i = b.first_droppable(); i < b.q.size(); i++) {
+                if (b.q[i].key == key) {
+                    freed_bytes += b.q[i].data.size();
+                    freed_messages++;
+                }
+            }
+
+            for (auto i = b.first_droppable(); i < b.q.size() && !enough(); i++) {
+                if (b.q[i].key != key) {
+                    freed_bytes += b.q[i].data.size();
+                    freed_messages++;
+                    drops[priority]++;
+                }
+            }
+
+            *conflate = true;
+            return enough();
+        }
+
+        // Priority queue limits exceeded: drop the oldest messages of the same priority
+        while (freed_bytes < priority_excess_bytes || freed_messages < priority_excess_messages) {
+            if (!plan_drop(static_cast<std::size_t>(priority)))
+                return false;
+        }
+
+        // Pool limits exceeded
+        while (freed_bytes < excess_bytes || freed_messages < excess_messages) {
+            if (_limits.overflow_policy == queue_overflow_policy::drop_oldest) {
+                if (!plan_drop(static_cast<std::size_t>(priority)))
+                    return false;
+            } else {
+                bool success = false;
+
+                for (auto i = static_cast<int>(N) - 1; !success && i >= priority; i--)
+                    success = plan_drop(static_cast<std::size_t>(i));
+
+                if (!success)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    void drop_oldest (bucket & b, std::size_t count)
+    {
+        auto first = b.q.begin() + b.first_droppable();
+        auto last = first + count;
+
+        for (auto pos = first; pos != last; ++pos) {
+            b.bytes -= pos->data.size();
+            _bytes -= pos->data.size();
+        }
+
+        b.q.erase(first, last);
+        _messages -= count;
+    }
+
+    /**
+     * Drops messages with the conflation @a key and @a count oldest messages with other keys.
+     *
+     * @return Number of dropped messages.
+     */
+    std::size_t drop_conflated (bucket & b, std::string const & key, std::size_t count)
+    {
+        auto first = b.q.begin() + b.first_droppable();
+        auto last = first;
+        std::size_t dropped = 0;
+
+        for (auto pos = first; pos != b.q.end(); ++pos) {
+            bool drop = pos->key == key;
+
+            if (!drop && count > 0) {
+                drop = true;
+                count--;
+            }
+
+            if (drop) {
+                b.bytes -= pos->data.size();
+                _bytes -= pos->data.size();
+                dropped++;
+            } else {
+                if (last != pos)
+                    *last = std::move(*pos);
+
+                ++last;
+            }
+        }
+
+        b.q.erase(last, b.q.end());
+        _messages -= dropped;
+        return dropped;
+    }
+};
+
+NETTY__NAMESPACE_END
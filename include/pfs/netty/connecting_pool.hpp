@@ -6,6 +6,7 @@
 // Changelog:
 //      2024.12.26 Initial version.
 //      2025.05.07 Replaced `std::function` with `callback_t`.
+//      2026.06.21 Added limit of the concurrent connects with priority queue.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "namespace.hpp"
@@ -17,6 +18,7 @@
 #include "socket4_addr.hpp"
 #include <pfs/i18n.hpp>
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <set>
@@ -70,6 +72,13 @@ private:
     std::set<deferred_connection_item> _deferred_connections;
     HandshakePool * _handshake_pool {nullptr};
 
+    // Maximum number of the outstanding connects (zero means unlimited)
+    std::size_t _max_connecting {0};
+
+    // Connections waiting for the free slot: priority -> options (higher priority first,
+    // FIFO order for equal priorities)
+    std::multimap<int, connection_options, std::greater<int>> _pending_connections;
+
 public:
     mutable callback_t<void (socket_id, error const &)> on_failure = [] (socket_id, error const &) {};
     mutable callback_t<void (socket_type &&)> on_connected = [] (socket_type &&) {};
@@ -155,50 +164,40 @@ public:
         }
     }
 
-    netty::conn_status connect (connection_options const & opts)
+    /**
+     * Sets maximum number of the concurrent outstanding connects @a n (zero means unlimited).
+     * Connections over the limit are postponed (see connect()).
+     */
+    void set_max_connecting (std::size_t n) noexcept
     {
-        Socket sock;
-        error err;
-        auto status = sock.connect(opts, & err);
-
-        switch (status) {
-            case netty::conn_status::connected:
-                this->on_connected(std::move(sock));
-                break;
-            case netty::conn_status::connecting: {
-                ConnectingPoller::add(sock.id(), & err);
-
-                if (!err) {
-                    _connecting_sockets[sock.id()] = std::move(sock);
-                } else {
-                    this->on_failure(sock.id(), err);
-                }
-
-                break;
-            }
-
-            case netty::conn_status::unreachable:
-                this->on_connection_refused(sock.saddr(), connection_failure_reason::unreachable);
-                break;
-
-            case netty::conn_status::failure:
-                this->on_failure(sock.id(), err);
-                break;
+        _max_connecting = n;
+    }
 
-            case netty::conn_status::deferred:
-            default:
-                break;
+    /**
+     * Initiates a connection.
+     *
+     * @param priority Connections postponed due to the concurrent connects limit are started in
+     *        order of decreasing @a priority.
+     *
+     * @return Connection status, netty::conn_status::deferred if connection is postponed.
+     */
+    netty::conn_status connect (connection_options const & opts, int priority = 0)
+    {
+        if (_max_connecting > 0 && _connecting_sockets.size() >= _max_connecting) {
+            _pending_connections.emplace(priority, opts);
+            return netty::conn_status::deferred;
         }
 
-        return status;
+        return connect_now(opts);
     }
 
-    netty::conn_status connect_timeout (connection_options const & opts, std::chrono::milliseconds timeout)
+    netty::conn_status connect_timeout (connection_options const & opts, std::chrono::milliseconds timeout
+        , int priority = 0)
     {
         if (timeout <= std::chrono::milliseconds{0})
-            return connect(opts);
+            return connect(opts, priority);
 
-        auto func = [this, opts] () { this->connect(opts); };
+        auto func = [this, opts, priority] () { this->connect(opts, priority); };
 
         _deferred_connections.insert(deferred_connection_item {
               std::chrono::steady_clock::now() + timeout
@@ -224,6 +223,14 @@ public:
             }
         }
 
+        // Start postponed connections if the outstanding ones are completed
+        while (!_pending_connections.empty()
+                && (_max_connecting == 0 || _connecting_sockets.size() < _max_connecting)) {
+            auto opts = std::move(_pending_connections.begin()->second);
+            _pending_connections.erase(_pending_connections.begin());
+            connect_now(opts);
+        }
+
         auto n = ConnectingPoller::poll(std::chrono::milliseconds{0}, perr);
 
         if (_handshake_pool != nullptr) {
@@ -238,7 +245,54 @@ public:
 
     bool empty () const noexcept
     {
-        return _connecting_sockets.empty();
+        return _connecting_sockets.empty() && _pending_connections.empty();
+    }
+
+    /**
+     * Returns number of connections postponed due to the concurrent connects limit.
+     */
+    std::size_t pending_count () const noexcept
+    {
+        return _pending_connections.size();
+    }
+
+private:
+    netty::conn_status connect_now (connection_options const & opts)
+    {
+        Socket sock;
+        error err;
+        auto status = sock.connect(opts, & err);
+
+        switch (status) {
+            case netty::conn_status::connected:
+                this->on_connected(std::move(sock));
+                break;
+            case netty::conn_status::connecting: {
+                ConnectingPoller::add(sock.id(), & err);
+
+                if (!err) {
+                    _connecting_sockets[sock.id()] = std::move(sock);
+                } else {
+                    this->on_failure(sock.id(), err);
+                }
+
+                break;
+            }
+
+            case netty::conn_status::unreachable:
+                this->on_connection_refused(sock.saddr(), connection_failure_reason::unreachable);
+                break;
+
+            case netty::conn_status::failure:
+                this->on_failure(sock.id(), err);
+                break;
+
+            case netty::conn_status::deferred:
+            default:
+                break;
+        }
+
+        return status;
     }
 };
 
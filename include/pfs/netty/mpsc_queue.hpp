@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.05.22 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+NETTY__NAMESPACE_BEGIN
+
+/**
+ * Unbounded intrusive multi-producer single-consumer queue (D. Vyukov's algorithm).
+ *
+ * @details `push` is wait-free (apart from node allocation) and can be called from any thread.
+ *          `try_pop` and `drain` must be called from a single (consumer) thread at a time.
+ *          Value type must be default constructible and move assignable.
+ */
+template <typename T>
+class mpsc_queue
+{
+public:
+    using value_type = T;
+
+private:
+    struct node
+    {
+        std::atomic<node *> next {nullptr};
+        value_type value;
+    };
+
+private:
+    std::atomic<node *> _head; // Last pushed node (producers side)
+    node * _tail;              // Next node to pop (consumer side)
+    node _stub;
+
+public:
+    mpsc_queue ()
+        : _head(& _stub)
+        , _tail(& _stub)
+    {}
+
+    mpsc_queue (mpsc_queue const &) = delete;
+    mpsc_queue (mpsc_queue &&) = delete;
+    mpsc_queue & operator = (mpsc_queue const &) = delete;
+    mpsc_queue & operator = (mpsc_queue &&) = delete;
+
+    ~mpsc_queue ()
+    {
+        value_type value;
+
+        while (try_pop(value))
+            ;
+    }
+
+public:
+    void push (value_type && value)
+    {
+        auto n = new node;
+        n->value = std::move(value);
+        push_node(n);
+    }
+
+    void push (value_type const & value)
+    {
+        auto n = new node;
+        n->value = value;
+        push_node(n);
+    }
+
+    /**
+     * Pops the oldest value.
+     *
+     * @return @c false if queue is empty or the producer has not completed the push yet.
+     */
+    bool try_pop (value_type & value)
+    {
+        auto tail = _tail;
+        auto next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == & _stub) {
+            if (next == nullptr)
+                return false;
+
+            _tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr) {
+            _tail = next;
+            value = std::move(tail->value);
+            delete tail;
+            return true;
+        }
+
+        // Producer is in progress
+        if (tail != _head.load(std::memory_order_acquire))
+            return false;
+
+        push_node(& _stub);
+        next = tail->next.load(std::memory_order_acquire);
+
+        if (next != nullptr) {
+            _tail = next;
+            value = std::move(tail->value);
+            delete tail;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Pops all available values and passes them to @a f.
+     *
+     * @details Callback @a f signature must match:
+     *          void (value_type &&)
+     *
+     * @return Number of values popped.
+     */
+    template <typename F>
+    std::size_t drain (F && f)
+    {
+        std::size_t n = 0;
+        value_type value;
+
+        while (try_pop(value)) {
+            f(std::move(value));
+            n++;
+        }
+
+        return n;
+    }
+
+private:
+    void push_node (node * n)
+    {
+        n->next.store(nullptr, std::memory_order_relaxed);
+        auto prev = _head.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+};
+
+NETTY__NAMESPACE_END
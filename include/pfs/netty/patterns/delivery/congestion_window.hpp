@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.25 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace delivery {
+
+/**
+ * Congestion state of the exchange with the peer.
+ */
+struct congestion_info
+{
+    std::size_t window {0};                // Congestion window (number of parts in flight)
+    std::chrono::microseconds srtt {0};    // Smoothed round-trip time (zero if not measured yet)
+    std::chrono::microseconds rttvar {0};  // Round-trip time variation
+};
+
+/**
+ * Adaptive congestion window (additive increase, multiplicative decrease) measured in message
+ * parts.
+ *
+ * @details The window grows by the number of acknowledged parts until the slow start threshold
+ *          (slow start), then by one part per window of acknowledged parts (congestion
+ *          avoidance). On the part loss the window is halved, at most once per round-trip time.
+ *          The window grows only while it limits the transmission.
+ */
+class congestion_window
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point_type = clock_type::time_point;
+
+public:
+    // Using function avoids 'multiple definition' error prior to C++17.
+    static constexpr std::size_t INITIAL_SIZE () { return 16; }
+    static constexpr std::size_t MIN_SIZE () { return 2; }
+    static constexpr std::size_t MAX_SIZE () { return 4096; }
+
+private:
+    double _size {static_cast<double>(INITIAL_SIZE())};
+    double _ssthresh {static_cast<double>(MAX_SIZE())};
+
+    std::chrono::microseconds _srtt {0};
+    std::chrono::microseconds _rttvar {0};
+
+    // Losses detected before this time point belong to the same congestion event
+    time_point_type _recovery_end;
+
+    // Duration of the recovery period while RTT is not measured
+    std::chrono::milliseconds _default_recovery;
+
+public:
+    congestion_window (std::chrono::milliseconds default_recovery = std::chrono::milliseconds{1000})
+        : _default_recovery(default_recovery)
+    {}
+
+public:
+    /**
+     * Returns current window size (number of parts).
+     */
+    std::size_t size () const noexcept
+    {
+        return static_cast<std::size_t>(_size);
+    }
+
+    std::chrono::microseconds srtt () const noexcept
+    {
+        return _srtt;
+    }
+
+    std::chrono::microseconds rttvar () const noexcept
+    {
+        return _rttvar;
+    }
+
+    /**
+     * Grows the window for @a parts newly acknowledged parts.
+     *
+     * @param in_flight Number of the parts in flight before the acknowledgement.
+     */
+    void acknowledged (std::size_t parts, std::size_t in_flight) noexcept
+    {
+        // Application limited, the window is not validated by the transmission
+        if (in_flight * 2 < size())
+            return;
+
+        if (_size < _ssthresh)
+            _size += static_cast<double>(parts);
+        else
+            _size += static_cast<double>(parts) / _size;
+
+        _size = (std::min)(_size, static_cast<double>(MAX_SIZE()));
+    }
+
+    /**
+     * Updates round-trip time estimation by the @a sample (RFC 6298).
+     */
+    void rtt_sample (std::chrono::microseconds sample) noexcept
+    {
+        if (_srtt.count() == 0) {
+            _srtt = sample;
+            _rttvar = sample / 2;
+            return;
+        }
+
+        auto delta = _srtt > sample ? _srtt - sample : sample - _srtt;
+        _rttvar = (_rttvar * 3 + delta) / 4;
+        _srtt = (_srtt * 7 + sample) / 8;
+    }
+
+    /**
+     * Shrinks the window on the part loss (retransmission).
+     */
+    void lost (time_point_type now) noexcept
+    {
+        if (now < _recovery_end)
+            return;
+
+        _ssthresh = (std::max)(_size / 2, static_cast<double>(MIN_SIZE()));
+        _size = _ssthresh;
+
+        if (_srtt.count() > 0)
+            _recovery_end = now + _srtt + _rttvar * 4;
+        else
+            _recovery_end = now + _default_recovery;
+    }
+
+    congestion_info info () const noexcept
+    {
+        return congestion_info {size(), _srtt, _rttvar};
+    }
+};
+
+} // namespace delivery
+
+NETTY__NAMESPACE_END
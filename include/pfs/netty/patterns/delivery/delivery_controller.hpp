@@ -6,12 +6,16 @@
 // Changelog:
 //      2025.01.16 Initial version (incoming_controller).
 //      2025.07.02 Initial version (merge of `incoming_controller` and `outgoing_controller`).
+//      2026.06.23 Message parts are acknowledged by batched cumulative/selective ACK.
+//      2026.06.25 Added adaptive congestion window.
+//      2026.06.27 Parts are acknowledged by ACK per part until the peer advertises SACK support.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../callback.hpp"
 #include "../../error.hpp"
 #include "../../namespace.hpp"
 #include "../../trace.hpp"
+#include "congestion_window.hpp"
 #include "multipart_assembler.hpp"
 #include "multipart_tracker.hpp"
 #include "protocol.hpp"
@@ -41,6 +45,15 @@ public:
 
     static constexpr std::size_t PRIORITY_COUNT = PriorityTracker::SIZE;
 
+private:
+    // Using function avoids 'multiple definition' error prior to C++17.
+
+    // Maximum number of the received parts acknowledged by the single ACK
+    static constexpr std::size_t ACK_BATCH_SIZE () { return 16; }
+
+    // Maximum delay of the acknowledgement
+    static constexpr std::chrono::milliseconds ACK_DELAY () { return std::chrono::milliseconds{5}; }
+
 private:
     using address_type = Address;
     using message_id = MessageId;
@@ -59,6 +72,12 @@ private:
         serial_number last_sn {0};
 
         pfs::optional<multipart_assembler_type> assembler;
+
+        // Number of the received parts not acknowledged yet
+        std::size_t unacked_parts {0};
+
+        // Time point until which the acknowledgement may be delayed
+        time_point_type ack_deadline;
     };
 
     struct multipart_tracker_item
@@ -95,6 +114,9 @@ private:
 
     syn_status _syn_state {syn_status::initial};
 
+    // Peer supports selective acknowledgement (advertised by the SYN packet version)
+    bool _sack_supported {false};
+
     std::uint32_t _part_size {0}; // Message portion size
     std::chrono::milliseconds _exp_timeout {3000}; // Expiration timeout
 
@@ -102,6 +124,9 @@ private:
 
     std::array<multipart_tracker_item, PRIORITY_COUNT> _trackers;
 
+    // Congestion window shared by the messages of all priorities
+    congestion_window _cwnd;
+
     bool _suspended {false};
 
 public:
@@ -110,6 +135,7 @@ public:
         : _peer_addr(peer_addr)
         , _part_size(part_size)
         , _exp_timeout(exp_timeout)
+        , _cwnd(exp_timeout)
     {}
 
 public:
@@ -147,6 +173,16 @@ public:
                         break;
                     }
 
+                    case packet_enum::sack: {
+                        sack_packet pkt {h, in};
+
+                        if (!in.commit_transaction())
+                            break;
+
+                        process_sack_packet(m, priority, pkt);
+                        break;
+                    }
+
                     case packet_enum::message: {
                         archive_type part;
                         message_packet<message_id> pkt {h, in, part};
@@ -248,16 +284,24 @@ public:
         return true;
     }
 
+    /**
+     * Returns current congestion window and round-trip time estimation.
+     */
+    congestion_info congestion () const noexcept
+    {
+        return _cwnd.info();
+    }
+
     template <typename Manager>
     unsigned int step (Manager * m)
     {
         if (_suspended)
             return 0;
 
-        if (nothing_transmit())
-            return 0;
+        unsigned int n = flush_acks(m);
 
-        unsigned int n = 0;
+        if (nothing_transmit())
+            return n;
 
         // Initiate synchronization if needed.
         // Send SYN packet to synchronize serial numbers.
@@ -285,6 +329,9 @@ public:
         auto saved_priority = _priority_tracker.current();
         auto priority = _priority_tracker.current();
 
+        // New parts are not sent while the congestion window is full
+        auto window_open = in_flight_count() < _cwnd.size();
+
         // Try to acquire next part of the current sending message according to priority
         do {
             auto & t = _trackers.at(priority);
@@ -298,9 +345,14 @@ public:
 
             archive_type ar;
             serializer_type out {ar};
-            auto sn = mt->acquire_next_part(out);
+            auto retransmission_count = mt->retransmission_count();
+            auto sn = mt->acquire_next_part(out, window_open);
 
             if (sn > 0) {
+                // Part lost (or its acknowledgement)
+                if (mt->retransmission_count() != retransmission_count)
+                    _cwnd.lost(clock_type::now());
+
                 PFS__THROW_UNEXPECTED(mt->priority() == priority
                     , "Fix delivery::delivery_controller algorithm");
 
@@ -377,6 +429,7 @@ private:
     {
         for (auto & a: _assemblers) {
             a.last_sn = 0;
+            a.unacked_parts = 0;
 
             if (a.assembler) {
                 m->process_message_lost(_peer_addr, a.assembler->msgid());
@@ -409,6 +462,37 @@ private:
         return success;
     }
 
+    /**
+     * Returns number of the parts sent but not acknowledged yet.
+     */
+    std::size_t in_flight_count () const
+    {
+        std::size_t n = 0;
+
+        for (auto const & x: _trackers) {
+            if (!x.q.empty())
+                n += x.q.front().in_flight_count();
+        }
+
+        return n;
+    }
+
+    /**
+     * Updates congestion window by the acknowledgement @a summary.
+     */
+    void update_congestion (ack_summary const & summary, std::size_t in_flight)
+    {
+        if (summary.newly_acked == 0)
+            return;
+
+        _cwnd.acknowledged(summary.newly_acked, in_flight);
+
+        if (summary.sent != time_point_type{}) {
+            _cwnd.rtt_sample(std::chrono::duration_cast<std::chrono::microseconds>(
+                clock_type::now() - summary.sent));
+        }
+    }
+
     /**
      * Checks whether no messages to transmit.
      */
@@ -422,6 +506,39 @@ private:
         return true;
     }
 
+    /**
+     * Enqueues cumulative/selective acknowledgement of the parts received by the assembler
+     * with @a priority.
+     */
+    template <typename Manager>
+    void enqueue_sack_packet (Manager * m, int priority)
+    {
+        auto & a = _assemblers.at(priority);
+        a.unacked_parts = 0;
+
+        if (_suspended || !a.assembler)
+            return;
+
+        auto sn = a.assembler->cumulative_sn();
+
+        archive_type ar;
+        serializer_type out {ar};
+        sack_packet ack_pkt {sn, a.assembler->received_ranges(sack_packet::MAX_RANGES())};
+        ack_pkt.serialize(out);
+        auto success = m->enqueue_private(_peer_addr, std::move(ar), priority);
+
+        if (!success) {
+            m->process_error(tr::f_("there is a problem in communication with the"
+                " receiver: {} while sending ACK packet (serial number={})"
+                ", message delivery paused.", to_string(_peer_addr), sn));
+            suspend();
+        }
+    }
+
+    /**
+     * Enqueues acknowledgement of the single part with serial number @a sn (for peers not
+     * supporting selective acknowledgement).
+     */
     template <typename Manager>
     void enqueue_ack_packet (Manager * m, int priority, serial_number sn)
     {
@@ -442,9 +559,56 @@ private:
         }
     }
 
+    /**
+     * Acknowledges received part with serial number @a sn: acknowledgement is sent if
+     * @a immediately is @c true, the batch of parts is filled or the message is complete, delayed
+     * otherwise (see flush_acks()). Each part is acknowledged immediately if the peer does not
+     * support selective acknowledgement.
+     */
+    template <typename Manager>
+    void schedule_ack (Manager * m, int priority, serial_number sn, bool immediately)
+    {
+        if (!_sack_supported) {
+            enqueue_ack_packet(m, priority, sn);
+            return;
+        }
+
+        auto & a = _assemblers.at(priority);
+
+        if (a.unacked_parts++ == 0)
+            a.ack_deadline = clock_type::now() + ACK_DELAY();
+
+        if (immediately || a.unacked_parts >= ACK_BATCH_SIZE() || a.assembler->is_complete())
+            enqueue_sack_packet(m, priority);
+    }
+
+    /**
+     * Sends delayed acknowledgements.
+     *
+     * @return Number of acknowledgements sent.
+     */
+    template <typename Manager>
+    unsigned int flush_acks (Manager * m)
+    {
+        unsigned int n = 0;
+
+        for (std::size_t i = 0; i < PRIORITY_COUNT; i++) {
+            auto & a = _assemblers[i];
+
+            if (a.unacked_parts > 0 && a.ack_deadline <= clock_type::now()) {
+                enqueue_sack_packet(m, static_cast<int>(i));
+                n++;
+            }
+        }
+
+        return n;
+    }
+
     template <typename Manager>
     void process_syn_packet (Manager * m, syn_packet<message_id> const & pkt)
     {
+        _sack_supported = pkt.supports_sack();
+
         switch (pkt.type()) {
             case packet_enum::syn_rst:
                 reset_assemblers(m);
@@ -501,12 +665,43 @@ private:
             return;
 
         auto & mt = t.q.front();
-        auto success = mt.acknowledge_part(pkt.sn());
+        auto in_flight = in_flight_count();
+        ack_summary summary;
+        auto success = mt.acknowledge_part(pkt.sn(), & summary);
 
         // Serial number is out of bounds
         if (!success)
             return;
 
+        update_congestion(summary, in_flight);
+
+        // The message has been delivered completely
+        if (mt.is_complete()) {
+            auto msgid = mt.msgid();
+            t.q.pop();
+            m->process_message_delivered(_peer_addr, msgid);
+        }
+    }
+
+    template <typename Manager>
+    void process_sack_packet (Manager * m, int priority, sack_packet const & pkt)
+    {
+        auto & t = _trackers.at(priority);
+
+        if (t.q.empty())
+            return;
+
+        auto & mt = t.q.front();
+        auto in_flight = in_flight_count();
+        ack_summary summary;
+        auto success = mt.acknowledge_parts(pkt.sn(), pkt.ranges(), & summary);
+
+        // Serial number is out of bounds (acknowledgement of the previous message)
+        if (!success)
+            return;
+
+        update_congestion(summary, in_flight);
+
         // The message has been delivered completely
         if (mt.is_complete()) {
             auto msgid = mt.msgid();
@@ -548,7 +743,10 @@ private:
             a.assembler = std::move(assembler);
 
             newly_acknowledged = a.assembler->acknowledge_part(h->sn(), part);
-            enqueue_ack_packet(m, priority, h->sn());
+
+            // Message heading is acknowledged immediately: sender waits for it before sending
+            // the rest of the parts
+            schedule_ack(m, priority, h->sn(), true);
 
             if (newly_acknowledged)
                 m->process_message_begin(_peer_addr, a.assembler->msgid(), a.assembler->total_size());
@@ -560,7 +758,10 @@ private:
                 return;
 
             newly_acknowledged = a.assembler->acknowledge_part(h->sn(), part);
-            enqueue_ack_packet(m, priority, h->sn());
+
+            // Repeated part means the acknowledgement is lost or expired, so it is acknowledged
+            // immediately
+            schedule_ack(m, priority, h->sn(), !newly_acknowledged);
         }
 
         if (newly_acknowledged) {
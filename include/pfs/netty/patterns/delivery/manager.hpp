@@ -6,16 +6,19 @@
 // Changelog:
 //      2025.04.16 Initial version.
 //      2025.07.02 Refactored.
+//      2026.06.25 Added method `congestion()`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
 #include "../../callback.hpp"
 #include "../../tag.hpp"
 #include "../../trace.hpp"
+#include "congestion_window.hpp"
 #include <pfs/assert.hpp>
 #include <pfs/countdown_timer.hpp>
 #include <pfs/i18n.hpp>
 #include <pfs/log.hpp>
+#include <pfs/optional.hpp>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -279,6 +282,22 @@ public:
         }
     }
 
+    /**
+     * Returns current congestion window and round-trip time estimation of the exchange with the
+     * node @a addr.
+     */
+    pfs::optional<congestion_info> congestion (address_type addr)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+
+        auto pos = _controllers.find(addr);
+
+        if (pos == _controllers.end())
+            return pfs::nullopt;
+
+        return pos->second.congestion();
+    }
+
     bool enqueue_message (address_type addr, message_id msgid, int priority, archive_type msg)
     {
         std::unique_lock<writer_mutex_type> locker{_writer_mtx};
@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2025.04.23 Initial version.
+//      2026.06.23 Added cumulative and selective acknowledgement support.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../error.hpp"
@@ -14,6 +15,7 @@
 #include <pfs/i18n.hpp>
 #include <algorithm>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 NETTY__NAMESPACE_BEGIN
@@ -27,7 +29,7 @@ namespace delivery {
 // +-------------------------------------------------------------------------------------------+
 //   ^       ^                                                                               ^
 //   |       |                                                                               |
-//   |       +--- lowest_acked_sn()                                                          |
+//   |       +--- lowest_acked_sn(), cumulative_sn()                                         |
 //   |                                                                                       |
 //   +--- _first_sn                                                              _last_sn ---+
 
@@ -46,6 +48,12 @@ private:
     archive_type _payload;
     std::size_t _remain_parts {0};
 
+    // Number of the contiguous received parts starting from the first one
+    std::size_t _received_prefix {0};
+
+    // Index of the part following the highest received one
+    std::size_t _received_end {0};
+
     // For track progress
     std::size_t _received_size {0};
 
@@ -114,6 +122,11 @@ public:
             _received_size += part.size();
             _payload.copy(part.data(), part.size(), index * _part_size);
             _parts_received[index] = true;
+            _received_end = (std::max)(_received_end, index + 1);
+
+            while (_received_prefix < _parts_received.size() && _parts_received[_received_prefix])
+                _received_prefix++;
+
             return true;
         }
 
@@ -152,6 +165,41 @@ public:
         return 0;
     }
 
+    /**
+     * Returns serial number of the last part of the contiguous received parts starting from the
+     * first one (cumulative acknowledgement) or zero if the first part is not received yet.
+     */
+    serial_number cumulative_sn () const noexcept
+    {
+        return _received_prefix == 0 ? serial_number{0} : _first_sn + (_received_prefix - 1);
+    }
+
+    /**
+     * Returns ranges (first and last serial numbers) of the parts received beyond the cumulative
+     * acknowledgement (selective acknowledgement), no more than @a max_ranges lowest ones.
+     */
+    std::vector<std::pair<serial_number, serial_number>> received_ranges (std::size_t max_ranges) const
+    {
+        std::vector<std::pair<serial_number, serial_number>> result;
+        auto i = _received_prefix;
+
+        while (i < _received_end && result.size() < max_ranges) {
+            if (!_parts_received[i]) {
+                i++;
+                continue;
+            }
+
+            auto first = i;
+
+            while (i < _received_end && _parts_received[i])
+                i++;
+
+            result.emplace_back(_first_sn + first, _first_sn + (i - 1));
+        }
+
+        return result;
+    }
+
     archive_type const & payload () const noexcept
     {
         return _payload;
@@ -5,6 +5,10 @@
 //
 // Changelog:
 //      2025.04.21 Initial version.
+//      2026.06.23 Added cumulative and selective acknowledgement of the parts.
+//      2026.06.25 Fixed window replaced by the window of the delivery controller (congestion
+//                 control), added RTT sampling and retransmissions counting.
+//      2026.06.27 Expired parts are retransmitted while the congestion window is full.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../error.hpp"
@@ -40,6 +44,19 @@ namespace delivery {
 //   |                                                   +--- _current_index                 |
 //   +--- _first_sn                                                              _last_sn ---+
 
+/**
+ * Result of the acknowledgement processing.
+ */
+struct ack_summary
+{
+    // Number of newly acknowledged parts
+    std::size_t newly_acked {0};
+
+    // Send time of the latest sent newly acknowledged part (RTT sample), parts sent more than once
+    // are not sampled (Karn's algorithm)
+    std::chrono::steady_clock::time_point sent;
+};
+
 template <typename MessageId, typename Archive>
 class multipart_tracker
 {
@@ -64,9 +81,11 @@ private:
 
     std::vector<bool> _parts_acked;       // Parts acknowledged
     std::vector<bool> _parts_acquired;    // Parts acqired
+    std::vector<time_point_type> _parts_sent; // Send time of the parts (zero for retransmitted parts)
     std::size_t _remain_parts_count {0};  // Number of unacknowledged parts
     std::size_t _part_acquired_count {0};
     std::size_t _current_index {0};       // Index of the first not acquired part
+    std::size_t _acked_prefix {0};        // Number of the contiguous acknowledged parts (lower bound)
 
     // Expiration timeout (for _heading_exp_timepoint and _exp_timepoint)
     std::chrono::milliseconds _exp_timeout {3000};
@@ -77,11 +96,8 @@ private:
     // The message part (excluding heading) acknowledgement expiration timepoint
     time_point_type _exp_timepoint;
 
-    // NOTE 200 is better than 500 when exchanging bitween demo programs running on host and
-    // virtial box machines.
-    // Maybe there is some algorithm to calculate this value.
-    // Using windows size transmission may occur intermittently.
-    std::size_t _window_size {200}; // Max number of parts awaiting acknowledgement
+    // Number of the parts sent more than once
+    std::size_t _retransmission_count {0};
 
 public:
     multipart_tracker (message_id msgid, int priority, std::uint32_t part_size
@@ -159,17 +175,44 @@ public:
      *
      * @return @c false if @a sn is out of bounds.
      */
-    bool acknowledge_part (serial_number sn)
+    bool acknowledge_part (serial_number sn, ack_summary * summary = nullptr)
     {
         if (sn < _first_sn || sn > _last_sn)
             return false;
 
-        auto index = sn - _first_sn;
+        std::size_t index = sn - _first_sn;
+        acknowledge_range(index, index, summary);
+
+        // Update expiration time point
+        update_exp_timepoint();
+
+        return true;
+    }
+
+    /**
+     * Acknowledges delivered message parts: all parts up to @a cumulative_sn (cumulative
+     * acknowledgement) and parts in the @a ranges (selective acknowledgement). Ranges out of
+     * bounds are ignored.
+     *
+     * @return @c false if @a cumulative_sn is out of bounds.
+     */
+    bool acknowledge_parts (serial_number cumulative_sn
+        , std::vector<std::pair<serial_number, serial_number>> const & ranges
+        , ack_summary * summary = nullptr)
+    {
+        if (!check_range(cumulative_sn))
+            return false;
+
+        std::size_t index = cumulative_sn - _first_sn;
+
+        if (index >= _acked_prefix) {
+            acknowledge_range(_acked_prefix, index, summary);
+            _acked_prefix = index + 1;
+        }
 
-        if (!_parts_acked[index]) {
-            PFS__THROW_UNEXPECTED(_remain_parts_count > 0, "Fix delivery::multipart_tracker algorithm");
-            _parts_acked[index] = true;
-            _remain_parts_count--;
+        for (auto const & r: ranges) {
+            if (r.first <= r.second && check_range(r.first) && check_range(r.second))
+                acknowledge_range(r.first - _first_sn, r.second - _first_sn, summary);
         }
 
         // Update expiration time point
@@ -183,14 +226,37 @@ public:
         return _remain_parts_count == 0;
     }
 
+    /**
+     * Returns number of the parts sent but not acknowledged yet.
+     */
+    std::size_t in_flight_count () const noexcept
+    {
+        auto acked_parts_count = _parts_acked.size() - _remain_parts_count;
+
+        return _part_acquired_count > acked_parts_count
+            ? _part_acquired_count - acked_parts_count
+            : 0;
+    }
+
+    /**
+     * Returns number of the parts sent more than once (lost or acknowledgement expired).
+     */
+    std::size_t retransmission_count () const noexcept
+    {
+        return _retransmission_count;
+    }
+
     /**
      * Acquires next message part.
      *
+     * @param window_open @c false if the congestion window is full: new parts are not acquired,
+     *        but the parts which acknowledgement has expired are retransmitted anyway.
+     *
      * @return The serial number of the next message part or zero if all parts was acquired
      *         or there are no expired parts.
      */
     template <typename Serializer>
-    serial_number acquire_next_part (Serializer & out)
+    serial_number acquire_next_part (Serializer & out, bool window_open = true)
     {
         // Message sending is completed
         if (_remain_parts_count == 0)
@@ -198,19 +264,11 @@ public:
 
         // All parts are acquired, wait acknowledgement for them
         // NOTE This code allows to avoid duplicate message part sending.
-        if (_part_acquired_count == _part_count) {
+        if (_part_acquired_count == _part_count && _current_index >= _parts_acked.size()) {
             if (_exp_timepoint > clock_type::now())
                 return 0;
         }
 
-        auto acked_parts_count = _parts_acked.size() - _remain_parts_count;
-
-        // Check out-of-window
-        if (_part_acquired_count > acked_parts_count
-                && _part_acquired_count - acked_parts_count > _window_size) {
-            return 0;
-        }
-
         // Heading not acknowledged yet
         if (_current_index > 0 && !_parts_acked[0]) {
             // Waiting for message heading acknowledgement has expired
@@ -228,37 +286,36 @@ public:
             return 0;
         }
 
+        // There are X-parts in the tracker and waiting for their acknowledgement has expired: go
+        // back to the first of them. Acquired parts are retransmitted even if the congestion window
+        // is full, otherwise the lost parts would hold the window closed forever.
+        if (_exp_timepoint <= clock_type::now()) {
+            for (std::size_t i = 0; i < _current_index && i < _parts_acked.size(); i++) {
+                if (!_parts_acked[i]) {
+                    _current_index = i;
+                    update_exp_timepoint();
+                    break;
+                }
+            }
+        }
+
         bool found = false;
 
-        if (_current_index < _parts_acked.size()) {
-            if (!_parts_acked[_current_index]) {
+        for (auto i = _current_index; i < _parts_acked.size(); i++) {
+            if (!_parts_acked[i]) {
+                _current_index = i;
                 found = true;
-            } else {
-                for (auto i = _current_index; i < _parts_acked.size(); i++) {
-                    if (!_parts_acked[i]) {
-                        _current_index = i;
-                        found = true;
-                        break;
-                    }
-                }
-            }
-        } else {
-            // There are X-parts in the tracker
-            if (_exp_timepoint <= clock_type::now()) {
-                // Find first expired part.
-                for (std::size_t i = 0; i < _parts_acked.size(); i++) {
-                    if (!_parts_acked[i]) {
-                        _current_index = i;
-                        found = true;
-                        break;
-                    }
-                }
+                break;
             }
         }
 
         if (!found)
             return 0;
 
+        // Out-of-window, new parts are not sent
+        if (!window_open && !_parts_acquired[_current_index])
+            return 0;
+
         auto sn = _first_sn + _current_index++;
 
         acquire_part<Serializer>(out, sn);
@@ -288,6 +345,7 @@ public:
                 _parts_acked[i] = true;
 
             _current_index = index + 1;
+            _acked_prefix = _current_index;
 
             for (std::size_t i = _current_index; i < _parts_acked.size(); i++)
                 _parts_acked[i] = false;
@@ -315,8 +373,11 @@ private:
         _part_acquired_count = 0;
         _parts_acquired.clear();
         _parts_acquired.resize(_remain_parts_count, false);
+        _parts_sent.clear();
+        _parts_sent.resize(_remain_parts_count);
 
         _current_index = 0;
+        _acked_prefix = 0;
         _exp_timepoint = clock_type::now();
         _heading_exp_timepoint = clock_type::now();
     }
@@ -336,6 +397,27 @@ private:
         return sn >= _first_sn && sn <= _last_sn;
     }
 
+    /**
+     * Acknowledges parts by indices in range [@a first, @a last].
+     */
+    void acknowledge_range (std::size_t first, std::size_t last, ack_summary * summary)
+    {
+        for (auto i = first; i <= last; i++) {
+            if (!_parts_acked[i]) {
+                PFS__THROW_UNEXPECTED(_remain_parts_count > 0, "Fix delivery::multipart_tracker algorithm");
+                _parts_acked[i] = true;
+                _remain_parts_count--;
+
+                if (summary != nullptr) {
+                    summary->newly_acked++;
+
+                    if (_parts_sent[i] > summary->sent)
+                        summary->sent = _parts_sent[i];
+                }
+            }
+        }
+    }
+
     /**
      * Acquires part by serial number.
      *
@@ -379,6 +461,10 @@ private:
         if (!_parts_acquired[index]) {
             _parts_acquired[index] = true;
             _part_acquired_count++;
+            _parts_sent[index] = clock_type::now();
+        } else {
+            _retransmission_count++;
+            _parts_sent[index] = time_point_type{};
         }
     }
 };
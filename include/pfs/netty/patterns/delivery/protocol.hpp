@@ -7,6 +7,8 @@
 //      2025.02.13 Initial version.
 //      2025.04.20 Serial ID replaced by serial number.
 //                 packet_enum::payload replaced by packet_enum::message.
+//      2026.06.23 Added cumulative acknowledgement with selective acknowledgement ranges.
+//      2026.06.27 SYN packets of version 2 advertise support of `sack_packet`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../error.hpp"
@@ -47,6 +49,9 @@ enum class packet_enum: std::uint8_t
 
     , report = 7
         /// Report (message without need acknowledgement).
+
+    , sack = 8
+        /// Cumulative message receive acknowledgement with selective acknowledgement ranges.
 };
 
 // Header:
@@ -121,20 +126,27 @@ protected:
 //
 // syn_packet contains last acknowleged serial numbers
 //
+// SYN packets of version 2 and above advertise support of the selective acknowledgement
+// (sack_packet). Parts received from the nodes of version 1 are acknowledged by ack_packet.
+//
 template <typename MessageId>
 class syn_packet: public header
 {
     std::vector<std::pair<MessageId, serial_number>> _snumbers;
 
+public:
+    // Using function avoids 'multiple definition' error prior to C++17.
+    static constexpr int VERSION () { return 2; }
+
 public:
     // Request/reset constructor
     syn_packet (bool is_reset = true) noexcept
-        : header(is_reset ? packet_enum::syn_rst : packet_enum::syn_req)
+        : header(is_reset ? packet_enum::syn_rst : packet_enum::syn_req, VERSION())
     {}
 
     // Reply constructor
     syn_packet (std::vector<std::pair<MessageId, serial_number>> snumbers) noexcept
-        : header(packet_enum::syn_rep)
+        : header(packet_enum::syn_rep, VERSION())
         , _snumbers(std::move(snumbers))
     {
         PFS__TERMINATE(!_snumbers.empty(), "serial numbers vector is empty");
@@ -161,6 +173,14 @@ public:
     }
 
 public:
+    /**
+     * Checks whether the sender of the packet supports selective acknowledgement.
+     */
+    bool supports_sack () const noexcept
+    {
+        return version() >= 2;
+    }
+
     std::size_t count () const noexcept
     {
         return _snumbers.size();
@@ -308,6 +328,68 @@ public:
     }
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// sack_packet
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// +-+--------+--+--------+--------+-----
+// |H|  CSN   |N | first  |  last  | ...
+// +-+--------+--+--------+--------+-----
+//  1     8    1     8        8
+//
+// CSN - serial number of the last part of the contiguous received parts starting from the message
+//       heading (cumulative acknowledgement).
+// N   - number of the ranges of the parts received beyond CSN (selective acknowledgement).
+//
+class sack_packet: public header
+{
+    std::vector<std::pair<serial_number, serial_number>> _ranges;
+
+public:
+    // Using function avoids 'multiple definition' error prior to C++17.
+    static constexpr std::size_t MAX_RANGES () { return 32; }
+
+public:
+    sack_packet (serial_number cumulative_sn
+        , std::vector<std::pair<serial_number, serial_number>> ranges = {}) noexcept
+        : header(packet_enum::sack)
+        , _ranges(std::move(ranges))
+    {
+        _h.sn = cumulative_sn;
+    }
+
+    template <typename Deserializer>
+    sack_packet (header const & h, Deserializer & in)
+        : header(h)
+    {
+        std::uint8_t size = 0;
+        in >> size;
+
+        for (int i = 0; i < size && in.is_good(); i++) {
+            std::pair<serial_number, serial_number> r;
+            in >> r.first >> r.second;
+            _ranges.push_back(r);
+        }
+    }
+
+public:
+    std::vector<std::pair<serial_number, serial_number>> const & ranges () const noexcept
+    {
+        return _ranges;
+    }
+
+    template <typename Serializer>
+    void serialize (Serializer & out)
+    {
+        PFS__THROW_UNEXPECTED(_ranges.size() <= MAX_RANGES(), "Fix delivery::sack_packet algorithm");
+
+        header::serialize(out);
+        out << static_cast<std::uint8_t>(_ranges.size());
+
+        for (auto const & r: _ranges)
+            out << r.first << r.second;
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // report_packet
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -5,20 +5,23 @@
 //
 // Changelog:
 //      2025.03.30 Initial version.
+//      2026.06.17 Channels are stored in the flat vector instead of the bimaps.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
 #include "../../callback.hpp"
-#include "unordered_bimap.hpp"
 #include <pfs/assert.hpp>
+#include <algorithm>
 #include <functional>
-#include <set>
 #include <utility>
+#include <vector>
 
 NETTY__NAMESPACE_BEGIN
 
 namespace meshnet {
 
+// There will rarely be more than dozens channels (sibling nodes), so linear search in the
+// contiguous storage is faster than hashing node IDs.
 template <typename NodeId, typename SocketId>
 class channel_map
 {
@@ -27,8 +30,15 @@ public:
     using socket_id = SocketId;
 
 private:
-    unordered_bimap<node_id, socket_id> _readers;
-    unordered_bimap<node_id, socket_id> _writers;
+    struct channel
+    {
+        node_id id;
+        socket_id reader_sid;
+        socket_id writer_sid;
+    };
+
+private:
+    std::vector<channel> _channels;
 
 public:
     mutable callback_t<void(socket_id)> close_socket = [] (socket_id) {
@@ -41,34 +51,55 @@ public:
 public:
     socket_id const * locate_reader (node_id id) const
     {
-        return _readers.locate_by_first(id);
+        auto ptr = find(id);
+        return ptr == nullptr ? nullptr : & ptr->reader_sid;
     }
 
     node_id const * locate_reader (socket_id sid) const
     {
-        return _readers.locate_by_second(sid);
+        for (auto const & x: _channels) {
+            if (x.reader_sid == sid)
+                return & x.id;
+        }
+
+        return nullptr;
     }
 
     socket_id const * locate_writer (node_id id) const
     {
-        return _writers.locate_by_first(id);
+        auto ptr = find(id);
+        return ptr == nullptr ? nullptr : & ptr->writer_sid;
     }
 
     node_id const * locate_writer (socket_id sid) const
     {
-        return _writers.locate_by_second(sid);
+        for (auto const & x: _channels) {
+            if (x.writer_sid == sid)
+                return & x.id;
+        }
+
+        return nullptr;
     }
 
+    /**
+     * Inserts channel with node @a id. On conflict (node or one of the sockets is already
+     * associated with the channel) the channel with node @a id is removed (without closing
+     * sockets).
+     */
     bool insert (node_id id, socket_id reader_sid, socket_id writer_sid)
     {
-        auto success = _readers.insert(id, reader_sid) && _writers.insert(id, writer_sid);
-
-        if (!success) {
-            _readers.erase_by_first(id);
-            _writers.erase_by_first(id);
+        bool conflict = std::any_of(_channels.begin(), _channels.end()
+            , [& id, & reader_sid, & writer_sid] (channel const & x) {
+                return x.id == id || x.reader_sid == reader_sid || x.writer_sid == writer_sid;
+            });
+
+        if (conflict) {
+            erase(id);
+            return false;
         }
 
-        return success;
+        _channels.push_back(channel{id, reader_sid, writer_sid});
+        return true;
     }
 
     std::pair<bool, node_id> has_channel (socket_id sid) const
@@ -90,27 +121,20 @@ public:
      */
     bool close_channel (node_id id)
     {
-        socket_id const * reader_sid_ptr = locate_reader(id);
-        socket_id const * writer_sid_ptr = locate_writer(id);
+        auto ptr = find(id);
 
-        if (reader_sid_ptr != nullptr && writer_sid_ptr != nullptr) {
-            auto reader_sid = *reader_sid_ptr;
-            auto writer_sid = *writer_sid_ptr;
+        if (ptr == nullptr)
+            return false;
 
-            _readers.erase_by_first(id);
-            _writers.erase_by_first(id);
+        auto reader_sid = ptr->reader_sid;
+        auto writer_sid = ptr->writer_sid;
 
-            close_socket(reader_sid);
-            close_socket(writer_sid);
+        erase(id);
 
-            return true;
-        } else if (reader_sid_ptr == nullptr && writer_sid_ptr == nullptr) {
-            ;
-        } else {
-            PFS__THROW_UNEXPECTED(false, "Fix channel_map");
-        }
+        close_socket(reader_sid);
+        close_socket(writer_sid);
 
-        return false;
+        return true;
     }
 
     /**
@@ -118,30 +142,41 @@ public:
      */
     void clear ()
     {
-        // Collect all node identifiers
-        std::set<node_id> tmp;
-
-        if (!_readers.empty())
-            _readers.for_each([& tmp] (node_id id, socket_id) {tmp.insert(id);});
+        // Closing socket may modify the collection
+        auto channels = std::move(_channels);
+        _channels.clear();
 
-        if (!_writers.empty())
-            _writers.for_each([& tmp] (node_id id, socket_id) {tmp.insert(id);});
-
-        if (!tmp.empty()) {
-            // Close all channels
-            for (auto const & id: tmp)
-                close_channel(id);
-
-            _readers.clear();
-            _writers.clear();
+        for (auto const & x: channels) {
+            close_socket(x.reader_sid);
+            close_socket(x.writer_sid);
         }
     }
 
     template <typename F>
     void for_each_writer (F && f)
     {
-        if (!_writers.empty())
-            _writers.for_each(std::forward<F>(f));
+        for (auto const & x: _channels)
+            f(x.id, x.writer_sid);
+    }
+
+private:
+    channel const * find (node_id const & id) const
+    {
+        for (auto const & x: _channels) {
+            if (x.id == id)
+                return & x;
+        }
+
+        return nullptr;
+    }
+
+    void erase (node_id const & id)
+    {
+        auto pos = std::find_if(_channels.begin(), _channels.end()
+            , [& id] (channel const & x) { return x.id == id; });
+
+        if (pos != _channels.end())
+            _channels.erase(pos);
     }
 };
 
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.17 Initial version.
+//      2026.06.27 Fixed object size note.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include "local_id.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace meshnet {
+
+/**
+ * Gateway chain of local node indices. Short chains (the most common case) are stored inline
+ * without heap allocation.
+ */
+class compact_chain
+{
+public:
+    // Chain size of the most routes does not exceed it (inline storage and the size take 32 bytes,
+    // the whole object with the empty heap vector is about 56 bytes on 64-bit platforms).
+    // Used by value only, so out-of-class definition is not required prior to C++17.
+    static constexpr std::size_t INLINE_CAPACITY = 7;
+
+    using const_iterator = local_id_t const *;
+
+private:
+    std::uint32_t _size {0};
+    local_id_t _inline[INLINE_CAPACITY] {};
+    std::vector<local_id_t> _heap;
+
+public:
+    compact_chain () = default;
+
+    template <typename InputIt>
+    compact_chain (InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+public:
+    std::size_t size () const noexcept
+    {
+        return _size;
+    }
+
+    bool empty () const noexcept
+    {
+        return _size == 0;
+    }
+
+    local_id_t const * data () const noexcept
+    {
+        return _size <= INLINE_CAPACITY ? _inline : _heap.data();
+    }
+
+    const_iterator begin () const noexcept
+    {
+        return data();
+    }
+
+    const_iterator end () const noexcept
+    {
+        return data() + _size;
+    }
+
+    local_id_t operator [] (std::size_t i) const noexcept
+    {
+        return data()[i];
+    }
+
+    void push_back (local_id_t lid)
+    {
+        if (_size < INLINE_CAPACITY) {
+            _inline[_size++] = lid;
+            return;
+        }
+
+        // Move to the heap
+        if (_size == INLINE_CAPACITY)
+            _heap.assign(_inline, _inline + _size);
+
+        _heap.push_back(lid);
+        _size++;
+    }
+
+    bool operator == (compact_chain const & other) const noexcept
+    {
+        return _size == other._size && std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator != (compact_chain const & other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+} // namespace meshnet
+
+NETTY__NAMESPACE_END
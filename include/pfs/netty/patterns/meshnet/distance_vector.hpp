@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.15 Initial version (extracted from `routing_table.hpp`).
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include "route_update_info.hpp"
+#include <pfs/optional.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace meshnet {
+
+/**
+ * Result of the incremental route update processing.
+ */
+enum class route_update_result
+{
+      ignored     // Update is stale or not better than the current route
+    , updated     // Route changed (should be propagated)
+    , route_ready // Destination became reachable
+    , route_lost  // Destination became unreachable through the route
+};
+
+/**
+ * Routes learned by incremental (distance-vector) updates: destination (node or segment) -> next
+ * hop, metric (number of gateways) and sequence number originated by the destination.
+ * Unreachable routes are kept to reject stale updates.
+ */
+template <typename DestId, typename NodeId>
+class distance_vector
+{
+    using dest_id = DestId;
+    using node_id = NodeId;
+    using update_info = route_update_info<dest_id>;
+
+    struct route
+    {
+        node_id next_hop;
+        std::uint8_t hops {0};
+        std::uint32_t seqno {0};
+    };
+
+private:
+    std::unordered_map<dest_id, route> _routes;
+
+public:
+    /**
+     * Processes route to @a dest through the sibling node @a neighbor_id with metric @a hops
+     * (already incremented by the caller).
+     *
+     * @details Update is accepted if it has a newer sequence number or the same sequence number
+     *          and a better metric (or it is received from the current next hop).
+     */
+    route_update_result update (dest_id dest, node_id neighbor_id, std::uint8_t hops
+        , std::uint32_t seqno)
+    {
+        auto pos = _routes.find(dest);
+
+        if (pos == _routes.end()) {
+            // Unknown destination is unreachable already
+            if (hops == update_info::UNREACHABLE())
+                return route_update_result::ignored;
+
+            _routes.emplace(dest, route{neighbor_id, hops, seqno});
+            return route_update_result::route_ready;
+        }
+
+        auto & r = pos->second;
+
+        bool accepted = seqno_newer(seqno, r.seqno)
+            || (seqno == r.seqno && (hops < r.hops || (neighbor_id == r.next_hop && hops != r.hops)));
+
+        if (!accepted)
+            return route_update_result::ignored;
+
+        bool was_reachable = r.hops != update_info::UNREACHABLE();
+
+        r.next_hop = neighbor_id;
+        r.hops = hops;
+        r.seqno = seqno;
+
+        if (was_reachable && hops == update_info::UNREACHABLE())
+            return route_update_result::route_lost;
+
+        if (!was_reachable && hops != update_info::UNREACHABLE())
+            return route_update_result::route_ready;
+
+        return route_update_result::updated;
+    }
+
+    /**
+     * Marks routes through the sibling node @a neighbor_id as unreachable (with odd sequence
+     * number) and calls @a f for each affected destination.
+     *
+     * @param f Invokable object with signature void (dest_id).
+     */
+    template <typename F>
+    void invalidate_via (node_id neighbor_id, F && f)
+    {
+        std::vector<dest_id> ids;
+
+        for (auto & x: _routes) {
+            auto & r = x.second;
+
+            if (r.next_hop != neighbor_id || r.hops == update_info::UNREACHABLE())
+                continue;
+
+            r.hops = update_info::UNREACHABLE();
+
+            if (r.seqno % 2 == 0)
+                r.seqno++;
+
+            ids.push_back(x.first);
+        }
+
+        for (auto const & id: ids)
+            f(id);
+    }
+
+    pfs::optional<node_id> next_hop (dest_id dest) const
+    {
+        auto pos = _routes.find(dest);
+
+        if (pos == _routes.end() || pos->second.hops == update_info::UNREACHABLE())
+            return pfs::nullopt;
+
+        return pos->second.next_hop;
+    }
+
+    bool has_route (dest_id dest) const
+    {
+        return !!next_hop(dest);
+    }
+
+    /**
+     * Returns number of gateways of the route to @a dest.
+     */
+    std::size_t hops (dest_id dest) const
+    {
+        auto pos = _routes.find(dest);
+        return pos == _routes.end() ? 0 : pos->second.hops;
+    }
+
+    /**
+     * Returns entry to advertise for destination @a dest.
+     */
+    pfs::optional<update_info> entry_for (dest_id dest) const
+    {
+        auto pos = _routes.find(dest);
+
+        if (pos == _routes.end())
+            return pfs::nullopt;
+
+        return update_info{dest, pos->second.hops, pos->second.seqno};
+    }
+
+    /**
+     * Iterates over all entries (including unreachable ones).
+     *
+     * @param f Invokable object with signature void (route_update_info<dest_id> const &).
+     */
+    template <typename F>
+    void foreach_entry (F && f) const
+    {
+        for (auto const & x: _routes)
+            f(update_info{x.first, x.second.hops, x.second.seqno});
+    }
+
+    /**
+     * Iterates over reachable destinations.
+     *
+     * @param f Invokable object with signature void (dest_id, node_id next_hop).
+     */
+    template <typename F>
+    void foreach_route (F && f) const
+    {
+        for (auto const & x: _routes) {
+            if (x.second.hops != update_info::UNREACHABLE())
+                f(x.first, x.second.next_hop);
+        }
+    }
+
+public: // static
+    /**
+     * Returns metric of the route through the sibling gateway advertised route with @a hops.
+     */
+    static std::uint8_t next_hops (std::uint8_t hops) noexcept
+    {
+        return hops >= update_info::UNREACHABLE() - 1
+            ? update_info::UNREACHABLE()
+            : static_cast<std::uint8_t>(hops + 1);
+    }
+
+    /**
+     * Compares sequence numbers using serial number arithmetic (wraparound safe).
+     */
+    static bool seqno_newer (std::uint32_t a, std::uint32_t b) noexcept
+    {
+        return static_cast<std::int32_t>(a - b) > 0;
+    }
+};
+
+} // namespace meshnet
+
+NETTY__NAMESPACE_END
@@ -5,14 +5,22 @@
 //
 // Changelog:
 //      2025.01.17 Initial version.
+//      2026.06.01 Added RTT measurement.
+//      2026.06.09 Indexed heartbeat schedule by socket ID.
+//                 Added heartbeat suppression on active channels.
+//      2026.06.11 Added failure detector policy.
+//      2026.06.27 Timestamps are sent only to the nodes supporting them.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "protocol.hpp"
+#include "timeout_detector.hpp"
 #include "../../namespace.hpp"
 #include "../../callback.hpp"
 #include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <functional>
-#include <set>
+#include <map>
 #include <unordered_map>
 #include <vector>
 
@@ -20,7 +28,13 @@ NETTY__NAMESPACE_BEGIN
 
 namespace meshnet {
 
-template <typename SocketId, typename SerializerTraits>
+/**
+ * Heartbeat controller.
+ *
+ * @tparam FailureDetector Channel failure detection policy: `timeout_detector` (fixed expiration
+ *         timeout) or `phi_accrual_detector` (adaptive).
+ */
+template <typename SocketId, typename SerializerTraits, typename FailureDetector = timeout_detector>
 class heartbeat_controller
 {
     using socket_id = SocketId;
@@ -28,18 +42,22 @@ class heartbeat_controller
     using serializer_type = typename serializer_traits_type::serializer_type;
     using archive_type = typename serializer_traits_type::archive_type;
     using time_point_type = std::chrono::steady_clock::time_point;
+    using failure_detector_type = FailureDetector;
+
+    // Time point -> socket ID, sorted by ascending order
+    using schedule_type = std::multimap<time_point_type, socket_id>;
 
     struct heartbeat_item
     {
-        socket_id sid;
-        time_point_type t;
+        typename schedule_type::iterator pos; // Position in heartbeats schedule
+        time_point_type last_sent;            // Last time any frame was sent (suppression mode)
     };
 
-    // Sort by ascending order
-    friend constexpr bool operator < (heartbeat_item const & lhs, heartbeat_item const & rhs)
+    struct limit_item
     {
-        return lhs.t < rhs.t;
-    }
+        typename schedule_type::iterator pos; // Position in expirations schedule
+        failure_detector_type detector;
+    };
 
 private:
     // Expiration timeout
@@ -47,16 +65,46 @@ private:
 
     std::chrono::seconds _interval {5};
 
-    std::set<heartbeat_item> _q;
+    // Any frame refreshes liveness, heartbeats are not sent to the recently active channels
+    bool _suppression {false};
+
+    // Heartbeats schedule and index by writer socket ID
+    schedule_type _q;
+    std::unordered_map<socket_id, heartbeat_item> _heartbeats;
     std::vector<socket_id> _tmp;
 
-    // TODO May be not optimized for large number of sockets
-    std::unordered_map<socket_id, time_point_type> _limits;
+    // Expirations schedule and index by reader socket ID
+    schedule_type _expirations;
+    std::unordered_map<socket_id, limit_item> _limits;
+
+    struct rtt_item
+    {
+        // Last timestamp received from the remote side and time of its receiving
+        std::uint64_t echo_timestamp {0};
+        time_point_type echo_received;
+
+        // Smoothed RTT and RTT variation (RFC 6298), microseconds
+        double srtt {0};
+        double rttvar {0};
+        bool measured {false};
+
+        // Remote side accepts heartbeats with timestamps
+        bool supported {false};
+    };
+
+    // Writer socket ID -> RTT measurement
+    std::unordered_map<socket_id, rtt_item> _rtts;
 
 public:
     mutable callback_t<void (socket_id, archive_type)> enqueue_packet;
     mutable callback_t<void (socket_id)> on_expired = [] (socket_id) {};
 
+    /**
+     * Called on each new RTT sample with the writer socket ID, smoothed RTT and RTT variation.
+     */
+    mutable callback_t<void (socket_id, std::chrono::microseconds, std::chrono::microseconds)> on_rtt_updated
+        = [] (socket_id, std::chrono::microseconds, std::chrono::microseconds) {};
+
 public:
     heartbeat_controller (std::chrono::seconds exp_timeout = std::chrono::seconds{15}
         , std::chrono::seconds interval = std::chrono::seconds{5})
@@ -64,34 +112,180 @@ public:
         , _interval(interval)
     {}
 
-private:
-    void insert (socket_id sid)
+public:
+    /**
+     * Enables/disables heartbeat suppression. If enabled, any received frame refreshes liveness of
+     * the channel and heartbeats are not sent while data was sent through the channel during the
+     * last heartbeat interval.
+     *
+     * @note Must be enabled on both sides of the channel, otherwise the remote side expires
+     *       the busy channel.
+     */
+    void set_suppression (bool enable) noexcept
     {
-        _q.insert(heartbeat_item{sid, std::chrono::steady_clock::now() + _interval});
+        _suppression = enable;
     }
 
-public:
+    /**
+     * Schedules heartbeats for writer socket @a sid.
+     */
     void update (socket_id sid)
     {
-        remove(sid);
-        insert(sid);
+        auto now = std::chrono::steady_clock::now();
+        auto pos = _heartbeats.find(sid);
+
+        if (pos != _heartbeats.end()) {
+            _q.erase(pos->second.pos);
+            pos->second.pos = _q.emplace(now + _interval, sid);
+        } else {
+            _heartbeats.emplace(sid, heartbeat_item{_q.emplace(now + _interval, sid), time_point_type{}});
+        }
+    }
+
+    /**
+     * Enables timestamps in heartbeats sent through writer socket @a sid (remote side supports
+     * them). Otherwise heartbeats are sent in the previous format and RTT is not measured.
+     */
+    void enable_timestamps (socket_id sid)
+    {
+        _rtts[sid].supported = true;
     }
 
     void remove (socket_id sid)
     {
-        for (auto pos = _q.begin(); pos != _q.end();) {
-            if (pos->sid == sid)
-                pos = _q.erase(pos);
-            else
-                ++pos;
+        auto pos = _heartbeats.find(sid);
+
+        if (pos != _heartbeats.end()) {
+            _q.erase(pos->second.pos);
+            _heartbeats.erase(pos);
         }
 
-        _limits.erase(sid);
+        auto lpos = _limits.find(sid);
+
+        if (lpos != _limits.end()) {
+            _expirations.erase(lpos->second.pos);
+            _limits.erase(lpos);
+        }
+
+        _rtts.erase(sid);
     }
 
     void process (socket_id sid, heartbeat_packet const & /*pkt*/)
     {
-        _limits[sid] = std::chrono::steady_clock::now() + _exp_timeout;
+        auto now = std::chrono::steady_clock::now();
+        auto pos = _limits.find(sid);
+
+        if (pos != _limits.end()) {
+            auto & detector = pos->second.detector;
+            detector.heartbeat(now);
+            _expirations.erase(pos->second.pos);
+            pos->second.pos = _expirations.emplace(detector.deadline(), sid);
+        } else {
+            failure_detector_type detector {_exp_timeout, now};
+            auto deadline = detector.deadline();
+            _limits.emplace(sid, limit_item{_expirations.emplace(deadline, sid), std::move(detector)});
+        }
+    }
+
+    /**
+     * Notifies that frame received by reader socket @a sid (used in suppression mode only).
+     */
+    void notify_received (socket_id sid)
+    {
+        if (!_suppression)
+            return;
+
+        auto pos = _limits.find(sid);
+
+        // Expiration is rescheduled lazily by step()
+        if (pos != _limits.end())
+            pos->second.detector.refresh(std::chrono::steady_clock::now());
+    }
+
+    /**
+     * Notifies that frame sent by writer socket @a sid (used in suppression mode only).
+     */
+    void notify_sent (socket_id sid)
+    {
+        if (!_suppression)
+            return;
+
+        auto pos = _heartbeats.find(sid);
+
+        // Heartbeat is postponed lazily by step()
+        if (pos != _heartbeats.end())
+            pos->second.last_sent = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * Processes heartbeat packet received by @a reader_sid socket from the remote side of the
+     * channel, heartbeats to which are sent through the @a writer_sid socket.
+     */
+    void process (socket_id reader_sid, socket_id writer_sid, heartbeat_packet const & pkt)
+    {
+        process(reader_sid, pkt);
+
+        if (!pkt.has_timestamps())
+            return;
+
+        auto now = std::chrono::steady_clock::now();
+        auto & item = _rtts[writer_sid];
+
+        item.supported = true;
+        item.echo_timestamp = pkt.timestamp();
+        item.echo_received = now;
+
+        // Remote side has not received our heartbeat yet
+        if (pkt.echo_timestamp() == 0)
+            return;
+
+        auto sent = static_cast<std::int64_t>(pkt.echo_timestamp());
+        auto rtt = timestamp_of(now) - sent - static_cast<std::int64_t>(pkt.echo_delay());
+
+        if (rtt < 0)
+            rtt = 0;
+
+        auto sample = static_cast<double>(rtt);
+
+        if (!item.measured) {
+            item.srtt = sample;
+            item.rttvar = sample / 2;
+            item.measured = true;
+        } else {
+            item.rttvar = 0.75 * item.rttvar + 0.25 * std::abs(item.srtt - sample);
+            item.srtt = 0.875 * item.srtt + 0.125 * sample;
+        }
+
+        on_rtt_updated(writer_sid
+            , std::chrono::microseconds{static_cast<std::int64_t>(item.srtt)}
+            , std::chrono::microseconds{static_cast<std::int64_t>(item.rttvar)});
+    }
+
+    /**
+     * Returns suspicion level of the failure detector for the channel with reader socket @a sid
+     * or zero if no heartbeat received yet.
+     */
+    double suspicion (socket_id sid) const
+    {
+        auto pos = _limits.find(sid);
+
+        if (pos == _limits.end())
+            return 0;
+
+        return pos->second.detector.suspicion(std::chrono::steady_clock::now());
+    }
+
+    /**
+     * Returns smoothed RTT for the channel with writer socket @a sid or zero if not measured yet.
+     */
+    std::chrono::microseconds srtt (socket_id sid) const
+    {
+        auto pos = _rtts.find(sid);
+
+        if (pos == _rtts.end() || !pos->second.measured)
+            return std::chrono::microseconds{0};
+
+        return std::chrono::microseconds{static_cast<std::int64_t>(pos->second.srtt)};
     }
 
     unsigned int step ()
@@ -100,48 +294,89 @@ public:
 
         if (!_q.empty()) {
             auto now = std::chrono::steady_clock::now();
-            auto pos = _q.begin();
-
-            archive_type ar;
-            serializer_type out {ar};
-            heartbeat_packet pkt {0};
-            pkt.serialize(out);
 
             _tmp.clear();
 
-            while (!_q.empty() && pos->t <= now) {
-                enqueue_packet(pos->sid, std::move(ar));
-                auto sid = pos->sid;
-                pos = _q.erase(pos);
-                _tmp.push_back(sid);
-            }
+            for (auto pos = _q.begin(); pos != _q.end() && pos->first <= now; pos = _q.erase(pos))
+                _tmp.push_back(pos->second);
 
             for (auto sid: _tmp) {
-                insert(sid);
+                auto & item = _heartbeats[sid];
+
+                // Channel is active, postpone heartbeat
+                if (_suppression && item.last_sent + _interval > now) {
+                    item.pos = _q.emplace(item.last_sent + _interval, sid);
+                    continue;
+                }
+
+                item.pos = _q.emplace(now + _interval, sid);
+                enqueue_packet(sid, make_heartbeat(sid, now));
                 result++;
             }
 
             _tmp.clear();
         }
 
-        if (!_limits.empty()) {
+        if (!_expirations.empty()) {
             auto now = std::chrono::steady_clock::now();
 
-            for (auto pos = _limits.begin(); pos != _limits.end();) {
-                if (pos->second <= now) {
-                    result++;
-                    auto sid = pos->first;
-                    pos = _limits.erase(pos);
-                    remove(sid);
-                    this->on_expired(sid);
-                } else {
-                    ++pos;
+            while (!_expirations.empty() && _expirations.begin()->first <= now) {
+                auto sid = _expirations.begin()->second;
+                auto pos = _limits.find(sid);
+
+                _expirations.erase(_expirations.begin());
+
+                // Deadline moved by the frames received after scheduling
+                auto deadline = pos->second.detector.deadline();
+
+                if (deadline > now) {
+                    pos->second.pos = _expirations.emplace(deadline, sid);
+                    continue;
                 }
+
+                result++;
+                _limits.erase(pos);
+                remove(sid);
+                this->on_expired(sid);
             }
         }
 
         return result;
     }
+
+private:
+    static std::int64_t timestamp_of (time_point_type t)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(t.time_since_epoch()).count();
+    }
+
+    archive_type make_heartbeat (socket_id sid, time_point_type now)
+    {
+        archive_type ar;
+        serializer_type out {ar};
+
+        auto pos = _rtts.find(sid);
+
+        if (pos == _rtts.end() || !pos->second.supported) {
+            heartbeat_packet pkt {0};
+            pkt.serialize(out);
+            return ar;
+        }
+
+        std::uint64_t echo_timestamp = 0;
+        std::uint32_t echo_delay = 0;
+
+        if (pos->second.echo_timestamp != 0) {
+            echo_timestamp = pos->second.echo_timestamp;
+            echo_delay = static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                now - pos->second.echo_received).count());
+        }
+
+        heartbeat_packet pkt {0, static_cast<std::uint64_t>(timestamp_of(now)), echo_timestamp
+            , echo_delay};
+        pkt.serialize(out);
+        return ar;
+    }
 };
 
 } // namespace meshnet
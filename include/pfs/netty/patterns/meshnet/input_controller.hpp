@@ -9,6 +9,8 @@
 //                 Class `basic_input_processor` renamed to `basic_input_controller`.
 //      2025.11.20 Added callbacks.
 //                 Merged with input_account.
+//      2026.06.05 Added cut-through forwarding of global data.
+//      2026.06.13 Added incremental route update packet.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../error.hpp"
@@ -63,14 +65,29 @@ class input_controller
 protected:
     std::unordered_map<socket_id, account> _accounts;
 
+    // Cut-through forwarding of the global data addressed to other nodes (gateway only)
+    bool _cut_through {false};
+    node_id _self_id {};
+
+    // Verify checksum of the forwarded global data
+    bool _verify_forwarded_checksum {false};
+
 public:
     mutable callback_t<void (socket_id, handshake_packet<node_id> &&)> on_handshake;
     mutable callback_t<void (socket_id, heartbeat_packet &&)> on_heartbeat;
     mutable callback_t<void (socket_id, unreachable_packet<node_id> &&)> on_unreachable;
     mutable callback_t<void (socket_id, route_packet<node_id> &&)> on_route;
+    mutable callback_t<void (socket_id, route_update_packet<node_id> &&)> on_route_update;
     mutable callback_t<void (socket_id, int /*priority*/, archive_type &&)> on_ddata;
     mutable callback_t<void (socket_id, int /*priority*/, gdata_packet<node_id> &&, archive_type &&)> on_gdata;
 
+    /**
+     * Called in cut-through mode for the global data addressed to other node with the serialized
+     * packet as is (@a data is valid during the call only).
+     */
+    mutable callback_t<void (socket_id, int /*priority*/, gdata_packet<node_id> const &
+        , char const * /*data*/, std::size_t /*len*/)> on_gdata_forward;
+
 public:
     input_controller () = default;
 
@@ -87,6 +104,25 @@ private:
     }
 
 public:
+    /**
+     * Enables cut-through forwarding: unicast global data not addressed to @a self_id is passed
+     * to on_gdata_forward without payload copying and decoding.
+     */
+    void enable_cut_through (node_id self_id)
+    {
+        _cut_through = true;
+        _self_id = self_id;
+    }
+
+    /**
+     * Enables/disables checksum verification of the global data forwarded in cut-through mode
+     * (disabled by default, checksum is verified by the receiver).
+     */
+    void verify_forwarded_checksum (bool enable) noexcept
+    {
+        _verify_forwarded_checksum = enable;
+    }
+
     void add (socket_id sid)
     {
         auto * pacc = locate_account(sid);
@@ -123,6 +159,7 @@ public:
             bool has_more_packets = true;
 
             while (has_more_packets && in.available() > 0) {
+                auto packet_offset = ar.size() - in.available();
                 in.start_transaction();
                 header h {in};
 
@@ -177,6 +214,17 @@ public:
                         break;
                     }
 
+                    case packet_enum::rupdate: {
+                        route_update_packet<node_id> pkt {h, in};
+
+                        if (in.commit_transaction())
+                            on_route_update(sid, std::move(pkt));
+                        else
+                            has_more_packets = false;
+
+                        break;
+                    }
+
                     case packet_enum::ddata: {
                         archive_type bytes_in;
                         ddata_packet pkt {h, in, bytes_in};
@@ -190,8 +238,24 @@ public:
                     }
 
                     case packet_enum::gdata: {
+                        gdata_packet<node_id> pkt {h, in};
+
+                        if (_cut_through && !pkt.is_multicast() && pkt.receiver_id() != _self_id) {
+                            pkt.skip_payload(in, _verify_forwarded_checksum);
+
+                            if (in.commit_transaction()) {
+                                auto packet_size = ar.size() - in.available() - packet_offset;
+                                on_gdata_forward(sid, priority, pkt, ar.data() + packet_offset
+                                    , packet_size);
+                            } else {
+                                has_more_packets = false;
+                            }
+
+                            break;
+                        }
+
                         archive_type bytes_in;
-                        gdata_packet<node_id> pkt {h, in, bytes_in};
+                        pkt.read_payload(in, bytes_in);
 
                         if (in.commit_transaction())
                             on_gdata(sid, priority, std::move(pkt), std::move(bytes_in));
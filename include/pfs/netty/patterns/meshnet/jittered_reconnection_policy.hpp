@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.21 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace meshnet {
+
+/**
+ * Infinite reconnection policy with exponential backoff and decorrelated jitter.
+ *
+ * @details The first retry is fast (random timeout up to BASE_TIMEOUT()), the next timeouts
+ *          are random values between BASE_TIMEOUT() and the tripled previous timeout bounded by
+ *          MAX_TIMEOUT(). Randomization spreads reconnections of the many peers after the remote
+ *          node restart instead of the synchronized waves.
+ */
+class jittered_reconnection_policy
+{
+    unsigned int _attempts {0};
+    std::chrono::milliseconds _timeout {0};
+
+public:
+    // Using function avoids 'multiple definition' error prior to C++17.
+    static constexpr std::chrono::milliseconds BASE_TIMEOUT () { return std::chrono::milliseconds{200}; }
+    static constexpr std::chrono::milliseconds MAX_TIMEOUT () { return std::chrono::milliseconds{15000}; }
+
+public:
+    jittered_reconnection_policy (bool is_gateway)
+    {
+        (void)is_gateway;
+    }
+
+public:
+    bool required () const noexcept
+    {
+        return true;
+    }
+
+    unsigned int attempts () const noexcept
+    {
+        return _attempts;
+    }
+
+    std::chrono::milliseconds fetch_timeout ()
+    {
+        _attempts++;
+
+        if (_attempts == 1) {
+            _timeout = BASE_TIMEOUT();
+            return std::chrono::milliseconds{random(0, BASE_TIMEOUT().count())};
+        }
+
+        auto upper_bound = (std::min)(_timeout.count() * 3, MAX_TIMEOUT().count());
+        _timeout = std::chrono::milliseconds{random(BASE_TIMEOUT().count(), upper_bound)};
+        return _timeout;
+    }
+
+public: // static
+    static bool supported () noexcept
+    {
+        return true;
+    }
+
+private:
+    static std::chrono::milliseconds::rep random (std::chrono::milliseconds::rep a
+        , std::chrono::milliseconds::rep b)
+    {
+        static thread_local std::minstd_rand generator {std::random_device{}()};
+        return std::uniform_int_distribution<std::chrono::milliseconds::rep>{a, b}(generator);
+    }
+};
+
+} // namespace meshnet
+
+NETTY__NAMESPACE_END
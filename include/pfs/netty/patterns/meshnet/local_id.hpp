@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace meshnet {
+
+// Dense local index of the node ID (valid within single routing table only)
+using local_id_t = std::uint32_t;
+constexpr local_id_t INVALID_LOCAL_ID = (std::numeric_limits<local_id_t>::max)();
+
+/**
+ * Interns node IDs into dense local indices (started from 0). Node ID is hashed once at the
+ * routing table boundary, internal structures use local indices only (flat vectors indexed by
+ * local ID, cheap hashing and comparison).
+ *
+ * @details Local indices are never released, so the number of interned IDs is limited by the
+ *          number of distinct nodes ever known.
+ */
+template <typename NodeId>
+class node_interner
+{
+    using node_id = NodeId;
+
+private:
+    std::unordered_map<node_id, local_id_t> _local_ids;
+    std::vector<node_id> _node_ids;
+
+public:
+    /**
+     * Returns local index of the node @a id, assigns new one if the node is not interned yet.
+     */
+    local_id_t intern (node_id const & id)
+    {
+        auto res = _local_ids.emplace(id, static_cast<local_id_t>(_node_ids.size()));
+
+        if (res.second)
+            _node_ids.push_back(id);
+
+        return res.first->second;
+    }
+
+    /**
+     * Returns local index of the node @a id or INVALID_LOCAL_ID if the node is not interned.
+     */
+    local_id_t find (node_id const & id) const
+    {
+        auto pos = _local_ids.find(id);
+        return pos == _local_ids.end() ? INVALID_LOCAL_ID : pos->second;
+    }
+
+    node_id const & node_id_of (local_id_t lid) const
+    {
+        return _node_ids[lid];
+    }
+
+    std::size_t size () const noexcept
+    {
+        return _node_ids.size();
+    }
+};
+
+} // namespace meshnet
+
+NETTY__NAMESPACE_END
@@ -9,30 +9,60 @@
 //      2025.08.08 `interruptable` inheritance.
 //      2025.12.18 Renamed to `node.hpp`.
 //                 `node_pool` renamed to `node`.
+//      2026.05.12 Added queue limits and watermark callbacks.
+//      2026.05.26 Added writer index by sibling node.
+//      2026.05.30 Added multipath routing of global data.
+//      2026.06.01 Added latency-aware route metric.
+//      2026.06.03 Added multicast global data.
+//      2026.06.05 Added method `set_forward_checksum_verification()`.
+//      2026.06.07 Separated I/O lock from the writer (enqueue) lock.
+//      2026.06.09 Added staging (lock-free submission) mode.
+//                 Added method `set_heartbeat_suppression()`.
+//      2026.06.11 Added method `suspicion()`.
+//      2026.06.13 Added incremental (distance-vector) route propagation mode.
+//                 Added control traffic counters.
+//                 Added aggregation, hold-down and duplicate suppression of unreachable
+//                 notifications.
+//      2026.06.15 Added hierarchical (segment) routing.
+//      2026.06.19 Added routing snapshot export/import (warm start).
+//      2026.06.27 Method `suspicion()` does not acquire I/O lock.
+//                 Unreachable notifications state moved to `unreachable_tracker`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
 #include "../../callback.hpp"
 #include "../../interruptable.hpp"
+#include "../../mpsc_queue.hpp"
 #include "../../trace.hpp"
+#include "../../writer_queue_limits.hpp"
 #include "protocol.hpp"
 #include "peer_index.hpp"
 #include "peer_interface.hpp"
 #include "route_info.hpp"
+#include "route_update_info.hpp"
+#include "routing_table.hpp"
+#include "segment_id.hpp"
 #include "session_id.hpp"
 #include "tag.hpp"
+#include "unreachable_tracker.hpp"
 #include <pfs/assert.hpp>
 #include <pfs/countdown_timer.hpp>
 #include <pfs/i18n.hpp>
 #include <pfs/log.hpp>
 #include <pfs/numeric_cast.hpp>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #if NETTY__TELEMETRY_ENABLED
@@ -43,6 +73,15 @@ NETTY__NAMESPACE_BEGIN
 
 namespace meshnet {
 
+/**
+ * Control traffic (route discovery, unreachable and route update packets) counters.
+ */
+struct control_counters
+{
+    std::uint64_t packets {0};
+    std::uint64_t bytes {0};
+};
+
 template <typename NodeId
     , typename RoutingTable
     , typename RecursiveWriterMutex>
@@ -51,6 +90,7 @@ class node: public interruptable
     using serializer_traits_type = typename RoutingTable::serializer_traits_type;
     using archive_type = typename serializer_traits_type::archive_type;
     using serializer_type = typename serializer_traits_type::serializer_type;
+    using deserializer_type = typename serializer_traits_type::deserializer_type;
     using peer_interface_type = peer_interface<NodeId, archive_type>;
     using peer_interface_ptr = std::unique_ptr<peer_interface_type>;
     using routing_table_type = RoutingTable;
@@ -65,6 +105,15 @@ public:
     using address_type = node_id;
     using gateway_chain_type = typename routing_table_type::gateway_chain_type;
 
+private:
+    // Message enqueued in staging mode
+    struct staged_message
+    {
+        node_id receiver_id;
+        int priority {0};
+        archive_type payload;
+    };
+
 private:
     node_id _id;
     session_id_t _session_id;
@@ -75,11 +124,52 @@ private:
     // There will rarely be more than dozens endpoints, so vector is a optimal choice
     std::vector<peer_interface_ptr> _endpoints;
 
+    // Sibling node -> endpoint which has the writer to it (maintained by channel callbacks)
+    std::unordered_map<node_id, peer_interface_type *> _sibling_writers;
+
     routing_table_type _rtab;
 
-    // Writer mutex to protect sending
+    // Writer mutex to protect routing state while enqueueing (producers and I/O callbacks)
     recursive_mutex_type _writer_mtx;
 
+    // I/O mutex to serialize endpoints stepping, producers never acquire it
+    recursive_mutex_type _io_mtx;
+
+    // Messages enqueued in staging mode, drained by `step()`
+    mpsc_queue<staged_message> _staged;
+    std::atomic_bool _staging {false};
+
+    route_propagation _propagation {route_propagation::discovery};
+
+    // Sequence number of the own route entry (even, odd numbers are used by neighbors to
+    // advertise the unreachability)
+    std::uint32_t _seqno {0};
+
+    // Destinations (including own ID) with routes changed since the last route update flush
+    std::unordered_set<node_id> _changed_routes;
+
+    // Maps node to its segment (hierarchical routing), must be consistent on all nodes
+    callback_t<segment_id_t (node_id)> _segment_resolver;
+
+    // Own segment (zero if hierarchical routing is disabled)
+    segment_id_t _segment {0};
+
+    // Sequence number of the own segment entry advertised by the border gateways (even)
+    std::uint32_t _segment_seqno {0};
+
+    // Segments (including own segment) with routes changed since the last route update flush
+    std::unordered_set<segment_id_t> _changed_segments;
+
+    control_counters _control_traffic;
+
+    // Hold-down of the originated and duplicate suppression of the received unreachable
+    // notifications
+    unreachable_tracker<node_id> _unreachable;
+
+    // Provisional routes (imported from the snapshot) not confirmed until this deadline are removed
+    pfs::optional<std::chrono::steady_clock::time_point> _provisional_deadline;
+    std::chrono::milliseconds _provisional_timeout {std::chrono::seconds{30}};
+
     // Thread where node created
     std::thread::id _thread_id;
 
@@ -98,6 +188,9 @@ private:
     callback_t<void (node_id, std::size_t)> _on_route_lost;
     callback_t<void (node_id)> _on_node_unreachable;
     callback_t<void (node_id, int, typename archive_type::container_type)> _on_data_received;
+    callback_t<void (node_id, std::size_t)> _on_queue_high;
+    callback_t<void (node_id, std::size_t)> _on_queue_low;
+    callback_t<void (node_id, std::chrono::microseconds, std::chrono::microseconds)> _on_rtt_updated;
 
 public:
     node (node_id id, bool is_gateway = false)
@@ -189,6 +282,8 @@ public: // Set callbacks
      * @details Callback @a f signature must match:
      *          void (node_id peer_id, std::size_t route_index, gateway_chain_type)
      *          `route_index` has a special case of zero occurs when `peer_id` is a sibling node.
+     *          For routes learned by incremental updates `route_index` is 1 and gateway chain
+     *          contains the next hop only.
      */
     template <typename F>
     node & on_route_ready (F && f)
@@ -236,6 +331,46 @@ public: // Set callbacks
         return *this;
     }
 
+    /**
+     * Notify when output queue to the sibling node reaches the high watermark, i.e. producers
+     * should throttle sending through this node.
+     *
+     * @details Callback @a f signature must match:
+     *          void (node_id peer_id, std::size_t queued_bytes)
+     */
+    template <typename F>
+    node & on_queue_high (F && f)
+    {
+        _on_queue_high = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Notify when output queue to the congested sibling node falls to the low watermark.
+     *
+     * @details Callback @a f signature must match:
+     *          void (node_id peer_id, std::size_t queued_bytes)
+     */
+    template <typename F>
+    node & on_queue_low (F && f)
+    {
+        _on_queue_low = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Notify when round-trip time to the sibling node measured by heartbeats is updated.
+     *
+     * @details Callback @a f signature must match:
+     *          void (node_id peer_id, std::chrono::microseconds srtt, std::chrono::microseconds rttvar)
+     */
+    template <typename F>
+    node & on_rtt_updated (F && f)
+    {
+        _on_rtt_updated = std::forward<F>(f);
+        return *this;
+    }
+
 public:
     node_id id () const noexcept
     {
@@ -263,13 +398,20 @@ public:
 
         ep->on_error(_on_error);
 
+        auto ep_ptr = &*ep;
+
         for (ListenerOptsIt pos = first; pos != last; ++pos)
             ep->add_listener(*pos);
 
         //
         // Assign endpoint callbacks
         //
-        ep->on_channel_established([this] (peer_index_t index, node_id peer_id, bool is_gateway) {
+        ep->on_channel_established([this, ep_ptr] (peer_index_t index, node_id peer_id, bool is_gateway) {
+            std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+            _sibling_writers[peer_id] = ep_ptr;
+
+            // Channel reestablished during the hold-down interval (link flapping)
+            _unreachable.restored(peer_id);
             _on_channel_established(index, peer_id, is_gateway);
 
             // Add direct route
@@ -279,26 +421,33 @@ public:
             if (is_gateway) {
                 _rtab.add_sibling_gateway(peer_id);
 
-                archive_type msg = _rtab.serialize_request(_session_id, _id);
-                this->enqueue_packet(peer_id, 0, std::move(msg));
-
-                // Send available routes to connected gateway on behalf of destination (according to
-                // routing table) nodes.
-                if (_is_gateway) {
-                    // TODO Should all known routes be sent or only sibling nodes are sufficient?
-
-                    _rtab.foreach_sibling_node([this, peer_id] (node_id initiator_id) {
-                        if (initiator_id != peer_id) {
-                            route_info<node_id> rinfo;
-                            rinfo.session_id = _session_id; // Use own session ID here
-                            rinfo.initiator_id = initiator_id;
-                            archive_type msg1 = _rtab.serialize_request(_id, rinfo);
-                            this->enqueue_packet(peer_id, 0, std::move(msg1));
-                        }
-                    });
+                if (_propagation == route_propagation::discovery) {
+                    archive_type msg = _rtab.serialize_request(_session_id, _id);
+                    this->enqueue_packet(peer_id, 0, std::move(msg));
+
+                    // Send available routes to connected gateway on behalf of destination
+                    // (according to routing table) nodes.
+                    if (_is_gateway) {
+                        // TODO Should all known routes be sent or only sibling nodes are sufficient?
+
+                        _rtab.foreach_sibling_node([this, peer_id] (node_id initiator_id) {
+                            if (initiator_id != peer_id) {
+                                route_info<node_id> rinfo;
+                                rinfo.session_id = _session_id; // Use own session ID here
+                                rinfo.initiator_id = initiator_id;
+                                archive_type msg1 = _rtab.serialize_request(_id, rinfo
+                                    , _rtab.link_latency(initiator_id));
+                                this->enqueue_packet(peer_id, 0, std::move(msg1));
+                            }
+                        });
+                    }
                 }
             }
 
+            // Regular nodes exchange routes through gateways only
+            if (_propagation == route_propagation::incremental && (is_gateway || _is_gateway))
+                send_route_updates(peer_id);
+
             if (route_added) {
                 if (_on_route_ready) {
                     NETTY__TRACE(MESHNET_TAG, "route ready: {} (hops={})", to_string(peer_id), 0);
@@ -307,10 +456,26 @@ public:
             }
         });
 
-        ep->on_channel_destroyed([this] (peer_index_t index, node_id peer_id) {
+        ep->on_channel_destroyed([this, ep_ptr] (peer_index_t index, node_id peer_id) {
+            std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+            auto pos = _sibling_writers.find(peer_id);
+
+            if (pos != _sibling_writers.end() && pos->second == ep_ptr)
+                _sibling_writers.erase(pos);
+
             if (_on_channel_destroyed)
                 _on_channel_destroyed(peer_id);
 
+            // Before removing sibling to report its unreachability properly
+            if (_propagation == route_propagation::incremental) {
+                invalidate_routes_via(peer_id);
+
+                _rtab.invalidate_segment_routes_via(peer_id, [this] (segment_id_t segment) {
+                    if (_is_gateway)
+                        _changed_segments.insert(segment);
+                });
+            }
+
             auto n = _rtab.remove_routes(node_id{}, peer_id
                 , [this] (node_id dest_id, std::size_t gw_chain_index) {
                     if (_on_route_lost)
@@ -323,8 +488,9 @@ public:
             );
 
             if (n > 0) {
-                if (_is_gateway)
-                    broadcast_unreachable(peer_id);
+                if (_is_gateway && _propagation == route_propagation::discovery) {
+                    _unreachable.lost(peer_id, std::chrono::steady_clock::now());
+                }
             }
         });
 
@@ -334,16 +500,37 @@ public:
             });
         }
 
+        ep->on_rtt_updated([this] (node_id id, std::chrono::microseconds srtt
+                , std::chrono::microseconds rttvar) {
+            std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+
+            // One-way link latency is estimated as a half of the round-trip time
+            _rtab.set_link_latency(id, srtt / 2);
+
+            if (_on_rtt_updated)
+                _on_rtt_updated(id, srtt, rttvar);
+        });
+
         ep->on_unreachable_received([this] (peer_index_t index, node_id id
                 , unreachable_info<node_id> const & uinfo) {
+            std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
             process_unreachable_received(index, id, uinfo);
         });
 
         ep->on_route_received([this] (peer_index_t index, node_id id
                 , bool is_response, route_info<node_id> const & rinfo) {
+            std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
             process_route_received(index, id, is_response, rinfo);
         });
 
+        ep->on_route_update_received([this] (peer_index_t index, node_id id
+                , std::vector<route_update_info<node_id>> const & entries
+                , std::vector<route_update_info<segment_id_t>> const & segment_entries) {
+            std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+            process_route_update_received(index, id, entries);
+            process_segment_update_received(id, segment_entries);
+        });
+
         if (_on_data_received) {
             ep->on_domestic_data_received([this] (node_id id, int priority, archive_type bytes) {
                 _on_data_received(id, priority, bytes.move_container());
@@ -360,8 +547,11 @@ public:
                 , archive_type packet) {
             PFS__THROW_UNEXPECTED(_id != receiver_id && _is_gateway, "Fix meshnet::node algorithm");
 
+            std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+
             node_id gw_id;
-            auto receiver_ptr = locate_writer(receiver_id, & gw_id);
+            auto receiver_ptr = locate_writer(sender_id, receiver_id, priority, packet.size(), & gw_id
+                , false);
 
             if (receiver_ptr != nullptr) {
                 receiver_ptr->enqueue_packet(gw_id, priority, std::move(packet));
@@ -376,6 +566,24 @@ public:
             // The corresponding unreachable_packet must be sent at the moment the channel destroyed.
         });
 
+        ep->on_forward_global_multicast([this] (int priority, node_id sender_id
+                , std::vector<node_id> receivers, archive_type data) {
+            PFS__THROW_UNEXPECTED(_is_gateway, "Fix meshnet::node algorithm");
+
+            std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+            enqueue_multicast_helper(sender_id, receivers, priority, data.data(), data.size());
+        });
+
+        ep->on_queue_high([this] (node_id peer_id, std::size_t bytes) {
+            if (_on_queue_high)
+                _on_queue_high(peer_id, bytes);
+        });
+
+        ep->on_queue_low([this] (node_id peer_id, std::size_t bytes) {
+            if (_on_queue_low)
+                _on_queue_low(peer_id, bytes);
+        });
+
         _endpoints.push_back(std::move(ep));
 
         peer_index_t index = static_cast<peer_index_t>(_endpoints.size());
@@ -406,7 +614,7 @@ public:
      */
     void listen ()
     {
-        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        std::unique_lock<recursive_mutex_type> locker{_io_mtx};
 
         for (auto & x: _endpoints)
             x->listen();
@@ -436,7 +644,7 @@ public:
 
     void disconnect (peer_index_t index, node_id peer_id)
     {
-        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        std::unique_lock<recursive_mutex_type> locker{_io_mtx};
 
         auto ep = locate_endpoint(index);
 
@@ -468,6 +676,227 @@ public:
         ep->set_frame_size(peer_id, frame_size);
     }
 
+    /**
+     * Sets output queue limits for all channels of all peers.
+     */
+    void set_queue_limits (writer_queue_limits const & limits)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+
+        for (auto & x: _endpoints)
+            x->set_queue_limits(limits);
+    }
+
+    /**
+     * Enables/disables checksum verification of the global data forwarded by this gateway.
+     *
+     * @details Forwarded packets are passed to the next hop as is (without payload decoding), so
+     *          checksum is verified by the receiver anyway. Disabled by default.
+     */
+    void set_forward_checksum_verification (bool enable)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_io_mtx};
+
+        for (auto & x: _endpoints)
+            x->set_forward_checksum_verification(enable);
+    }
+
+    /**
+     * Enables/disables heartbeat suppression for all peers.
+     *
+     * @details If enabled, any received frame refreshes the channel liveness and heartbeats are
+     *          not sent through the channels which sent data during the last heartbeat interval.
+     *          Must be enabled on all nodes of the network. Disabled by default.
+     */
+    void set_heartbeat_suppression (bool enable)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_io_mtx};
+
+        for (auto & x: _endpoints)
+            x->set_heartbeat_suppression(enable);
+    }
+
+    /**
+     * Sets multipath mode for the intersegment (global) data.
+     *
+     * @details Alternative routes differ from the optimal one by no more than @a max_extra_hops
+     *          hops. Routes with extra hops are used for messages originated by this node only,
+     *          forwarded messages are balanced between equal-cost routes.
+     */
+    void set_multipath (multipath_mode mode, std::size_t max_extra_hops = 0)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        _rtab.set_multipath(mode, max_extra_hops);
+    }
+
+    /**
+     * Sets route metric used to select the optimal route.
+     *
+     * @details With route_metric::latency the route with minimum expected latency is selected.
+     *          Latency of the first hop is measured by heartbeats, latencies of the remaining
+     *          links are collected during route discovery. Selected route is replaced only if the
+     *          best route is faster by more than @a hysteresis_percent percent.
+     *
+     * @note Link latencies are added to the route packets with route_metric::latency only, so
+     *       all nodes of the network must use the same metric and must support it.
+     */
+    void set_route_metric (route_metric metric, unsigned int hysteresis_percent = 20)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        _rtab.set_route_metric(metric, hysteresis_percent);
+    }
+
+    /**
+     * Sets route propagation mode (route_propagation::discovery by default).
+     *
+     * @details In route_propagation::incremental mode the nodes advertise only changed
+     *          reachability (destination, number of gateways and sequence number) in batched
+     *          route update packets instead of flooding route requests with full gateway chains.
+     *          Must be set on all nodes of the network before connecting.
+     */
+    void set_route_propagation (route_propagation mode)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        _propagation = mode;
+    }
+
+    /**
+     * Sets segment resolver for hierarchical routing (route_propagation::incremental mode only).
+     *
+     * @details Gateways advertise routes to the individual nodes within their own segment only
+     *          and summarize the other segments by a single entry per segment. Messages to the
+     *          node of the remote segment are routed toward the nearest border gateway of that
+     *          segment. Zero segment means that the node does not belong to any segment (it is
+     *          advertised to all nodes). Must be set on all nodes of the network before
+     *          connecting.
+     *
+     *          Resolver @a f signature must match:
+     *          segment_id_t (node_id)
+     */
+    template <typename F>
+    void set_segment_resolver (F && f)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        _segment_resolver = std::forward<F>(f);
+        _segment = _segment_resolver ? _segment_resolver(_id) : segment_id_t{0};
+    }
+
+    /**
+     * Sets hold-down interval of the unreachable notifications originated by this gateway (50 ms
+     * by default).
+     *
+     * @details Notifications about the lost sibling nodes are delayed by @a interval, aggregated
+     *          into a single packet and cancelled if the channel is reestablished during this
+     *          interval (link flapping). Zero interval aggregates the nodes lost during one step.
+     */
+    void set_unreachable_hold_down (std::chrono::milliseconds interval)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        _unreachable.set_hold_down(interval);
+    }
+
+    /**
+     * Sets revalidation timeout of the routes imported from the routing snapshot (30 seconds by
+     * default). Must be called before import_routing_snapshot().
+     */
+    void set_provisional_route_timeout (std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        _provisional_timeout = timeout;
+    }
+
+    /**
+     * Exports routing snapshot (session ID and routes learned by route discovery) to restore it
+     * by import_routing_snapshot() after the node restart.
+     */
+    archive_type export_routing_snapshot ()
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+
+        archive_type ar;
+        serializer_type out {ar};
+        out << _session_id;
+        _rtab.export_snapshot(out);
+        return ar;
+    }
+
+    /**
+     * Imports routing snapshot exported by export_routing_snapshot() (warm start). Must be called
+     * before the listeners and connections are started.
+     *
+     * @details Imported routes are provisional: they are used as soon as their first gateway is
+     *          reconnected and confirmed by the regular route discovery. Routes not confirmed
+     *          during the provisional route timeout are removed. Session ID is restored, so the
+     *          route responses to the requests of the previous instance of the node are not
+     *          considered as a duplicate ID.
+     *
+     * @return @c false if snapshot is malformed or has unsupported version (nothing imported).
+     */
+    bool import_routing_snapshot (char const * data, std::size_t len)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+
+        deserializer_type in {data, len};
+        session_id_t session_id;
+        in >> session_id;
+
+        if (!in.is_good() || !_rtab.import_snapshot(in))
+            return false;
+
+        _session_id = session_id;
+        _provisional_deadline = std::chrono::steady_clock::now() + _provisional_timeout;
+        return true;
+    }
+
+    bool import_routing_snapshot (archive_type const & snapshot)
+    {
+        return import_routing_snapshot(snapshot.data(), snapshot.size());
+    }
+
+    /**
+     * Returns control traffic sent by this node (each copy of the broadcasted or forwarded packet
+     * is counted).
+     */
+    control_counters control_traffic ()
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        return _control_traffic;
+    }
+
+    /**
+     * Iterates over routes usage counters (collected in multipath mode).
+     *
+     * @details Callback @a f signature must match:
+     *          void (node_id dest_id, std::size_t route_index, route_counters const &)
+     */
+    template <typename F>
+    void foreach_route_counters (F && f)
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        _rtab.foreach_route_counters(std::forward<F>(f));
+    }
+
+    /**
+     * Returns suspicion level of the heartbeat failure detector for the channel with sibling
+     * node @a peer_id (zero if there is no channel or no heartbeat received yet).
+     */
+    double suspicion (node_id peer_id)
+    {
+        // Sibling writers are modified under writer lock by the channel callbacks
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+
+        auto pos = _sibling_writers.find(peer_id);
+
+        if (pos == _sibling_writers.end())
+            return 0;
+
+        // Endpoints live as long as the node, so the peer is queried outside of the writer lock
+        auto ep_ptr = pos->second;
+        locker.unlock();
+
+        return ep_ptr->suspicion(peer_id);
+    }
+
     /**
      * Enqueues message for delivery to specified node ID @a id.
      *
@@ -476,14 +905,55 @@ public:
      * @param data Message content.
      * @param len Length of the message content.
      *
-     * @return @c true if route found to @a receiver_id.
+     * @return @c true if route found to @a receiver_id and message accepted by the output queue.
      */
     bool enqueue (node_id receiver_id, int priority, char const * data, std::size_t len)
     {
+        if (_staging.load(std::memory_order_acquire)) {
+            stage(receiver_id, priority, data, len);
+            return true;
+        }
+
         std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        return enqueue_unsafe(receiver_id, priority, data, len);
+    }
+
+    /**
+     * Enqueues message for delivery to specified node ID @a id.
+     *
+     * @param receiver_id Receiver ID.
+     * @param priority Message priority.
+     * @param data Message content.
+     *
+     * @return @c true if route found to @a receiver_id and message accepted by the output queue.
+     */
+    bool enqueue (node_id receiver_id, int priority, archive_type const & data)
+    {
+        return enqueue(receiver_id, priority, data.data(), data.size());
+    }
+
+    /**
+     * Enables/disables staging mode. In staging mode `enqueue()` does not lock the writer mutex:
+     * messages are queued (wait-free apart from memory allocation) and routed/serialized by
+     * `step()` in the I/O thread. `enqueue()` returns @c true in this mode, routing failures are
+     * reported through the error callback.
+     */
+    void set_staging (bool enable)
+    {
+        std::unique_lock<recursive_mutex_type> io_locker{_io_mtx};
+        _staging.store(enable, std::memory_order_release);
+
+        if (!enable)
+            drain_staged();
+    }
 
+    /**
+     * Same as `enqueue()` but writer mutex must be locked by the caller.
+     */
+    bool enqueue_unsafe (node_id receiver_id, int priority, char const * data, std::size_t len)
+    {
         node_id gw_id;
-        auto wr = locate_writer(receiver_id, & gw_id);
+        auto wr = locate_writer(_id, receiver_id, priority, len, & gw_id, true);
 
         if (wr == nullptr) {
             _on_error(tr::f_("peer not found to send data to: {}", to_string(receiver_id)));
@@ -505,22 +975,34 @@ public:
             pkt.serialize(out, data, len);
         }
 
-        wr->enqueue_packet(gw_id, priority, std::move(ar));
-        return true;
+        return wr->enqueue_packet(gw_id, priority, std::move(ar));
     }
 
     /**
-     * Enqueues message for delivery to specified node ID @a id.
+     * Enqueues multicast message for delivery to nodes @a receivers.
      *
-     * @param receiver_id Receiver ID.
-     * @param priority Message priority.
-     * @param data Message content.
+     * @details Receivers are grouped by the next hop, so the message is serialized and sent once
+     *          per outgoing channel. Gateways fork the message in the same way, so the message
+     *          crosses each link of the forwarding tree only once.
      *
-     * @return @c true if route found to @a receiver_id.
+     * @return @c true if routes found to all receivers and message accepted by the output queues.
      */
-    bool enqueue (node_id receiver_id, int priority, archive_type const & data)
+    bool enqueue_multicast (std::vector<node_id> const & receivers, int priority
+        , char const * data, std::size_t len)
     {
-        return enqueue(receiver_id, priority, data.data(), data.size());
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        return enqueue_multicast_helper(_id, receivers, priority, data, len);
+    }
+
+    /**
+     * Enqueues multicast message for delivery to nodes @a receivers.
+     *
+     * @return @c true if routes found to all receivers and message accepted by the output queues.
+     */
+    bool enqueue_multicast (std::vector<node_id> const & receivers, int priority
+        , archive_type const & data)
+    {
+        return enqueue_multicast(receivers, priority, data.data(), data.size());
     }
 
     /**
@@ -528,13 +1010,18 @@ public:
      */
     unsigned int step ()
     {
-        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+        // Producers are blocked only while endpoint callbacks update routing state or sending
+        std::unique_lock<recursive_mutex_type> locker{_io_mtx};
 
-        unsigned int result = 0;
+        unsigned int result = drain_staged();
 
         for (auto & x: _endpoints)
             result += x->step();
 
+        result += flush_unreachable();
+        result += flush_route_updates();
+        result += expire_provisional_routes();
+
         return result;
     }
 
@@ -553,7 +1040,7 @@ public:
 
     bool is_reachable (node_id id) const
     {
-        return _rtab.is_reachable(id);
+        return _rtab.is_reachable(id) || !!segment_gateway_for(id);
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -590,10 +1077,39 @@ public:
             result.push_back(fmt::format("{}: {}", to_string(dest_id), stringify(gw_chain)));
         });
 
+        _rtab.foreach_segment_route([& result] (segment_id_t segment, node_id next_hop) {
+            result.push_back(fmt::format("segment {}: {}", segment, to_string(next_hop)));
+        });
+
         return result;
     }
 
 private:
+    void stage (node_id receiver_id, int priority, char const * data, std::size_t len)
+    {
+        staged_message msg;
+        msg.receiver_id = receiver_id;
+        msg.priority = priority;
+        msg.payload = archive_type{data, len};
+        _staged.push(std::move(msg));
+    }
+
+    /**
+     * Routes and serializes staged messages (I/O mutex must be locked).
+     *
+     * @return Number of drained messages.
+     */
+    unsigned int drain_staged ()
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+
+        auto n = _staged.drain([this] (staged_message && msg) {
+            enqueue_unsafe(msg.receiver_id, msg.priority, msg.payload.data(), msg.payload.size());
+        });
+
+        return static_cast<unsigned int>(n);
+    }
+
     peer_interface_type * locate_endpoint (node_id id)
     {
         if (_endpoints[0]->id() == id)
@@ -624,6 +1140,10 @@ private:
 
         auto gw_id_opt = _rtab.gateway_for(id);
 
+        // Route to the border gateway of the node segment
+        if (!gw_id_opt)
+            gw_id_opt = segment_gateway_for(id);
+
         // No route or it is unreachable
         if (!gw_id_opt)
             return nullptr;
@@ -631,6 +1151,12 @@ private:
         if (gw_id != nullptr)
             *gw_id = *gw_id_opt;
 
+        auto pos = _sibling_writers.find(*gw_id_opt);
+
+        if (pos != _sibling_writers.end())
+            return pos->second;
+
+        // Fallback for the writer of not yet established channel
         if (_endpoints[0]->has_writer(*gw_id_opt))
             return &*_endpoints[0];
 
@@ -643,6 +1169,45 @@ private:
         return nullptr;
     }
 
+    /**
+     * Locates writer for the global data according to multipath mode.
+     */
+    peer_interface_type * locate_writer (node_id sender_id, node_id receiver_id, int priority
+        , std::size_t size, node_id * gw_id, bool originated)
+    {
+        if (_rtab.multipath() == multipath_mode::disabled)
+            return locate_writer(receiver_id, gw_id);
+
+        std::hash<node_id> hasher;
+        auto flow_hash = hasher(sender_id) ^ (hasher(receiver_id) * 31)
+            ^ static_cast<std::size_t>(priority);
+
+        auto gw_id_opt = _rtab.select_gateway(receiver_id, flow_hash, size
+            , [this] (node_id id) -> std::size_t {
+                auto pos = _sibling_writers.find(id);
+                return pos != _sibling_writers.end()
+                    ? pos->second->queued_bytes(id)
+                    : (std::numeric_limits<std::size_t>::max)();
+            }, originated);
+
+        if (!gw_id_opt)
+            gw_id_opt = segment_gateway_for(receiver_id);
+
+        if (!gw_id_opt)
+            return nullptr;
+
+        *gw_id = *gw_id_opt;
+        auto pos = _sibling_writers.find(*gw_id_opt);
+
+        if (pos != _sibling_writers.end())
+            return pos->second;
+
+        return locate_writer(*gw_id_opt);
+    }
+
+    /**
+     * Enqueues control packet to the sibling node @a id.
+     */
     bool enqueue_packet (node_id id, int priority, archive_type data)
     {
         auto ptr = locate_writer(id);
@@ -652,10 +1217,14 @@ private:
             return false;
         }
 
+        count_control(data.size());
         ptr->enqueue_packet(id, priority, std::move(data));
         return true;
     }
 
+    /**
+     * Enqueues control packet to the sibling node @a id.
+     */
     bool enqueue_packet (node_id id, int priority, char const * data, std::size_t len)
     {
         auto ptr = locate_writer(id);
@@ -665,10 +1234,17 @@ private:
             return false;
         }
 
+        count_control(len);
         ptr->enqueue_packet(id, priority, data, len);
         return true;
     }
 
+    void count_control (std::size_t size, std::size_t copies = 1)
+    {
+        _control_traffic.packets += copies;
+        _control_traffic.bytes += size * copies;
+    }
+
     void process_unreachable_received (peer_index_t /*idx*/, node_id peer_id
         , unreachable_info<node_id> const & uinfo)
     {
@@ -676,26 +1252,86 @@ private:
         if (_id == uinfo.gw_id)
             return;
 
-        // `uinfo.id` node cannot be reached through the gateway `uinfo.gw_id`.
-        // Disable all routes containing the specified subchain.
-        auto n = _rtab.remove_routes(uinfo.gw_id, uinfo.id
-            , [this] (node_id dest_id, std::size_t gw_chain_index) {
-                if (_on_route_lost)
-                    _on_route_lost(dest_id, gw_chain_index);
-            }
-            , [this] (node_id dest_id) {
-                if (_on_node_unreachable)
-                    _on_node_unreachable(dest_id);
-            }
-        );
+        auto now = std::chrono::steady_clock::now();
+        unreachable_info<node_id> forward_info {uinfo.gw_id, {}, uinfo.generation};
 
-        if (n > 0) {
-            // Forward packet to sibling nodes excluding `peer_id`.
-            if (_is_gateway) {
-                archive_type ar = _rtab.serialize(uinfo);
-                forward_packet(peer_id, ar);
-            }
+        for (auto const & id: uinfo.ids) {
+            // Duplicate received by the other path or outdated notification
+            if (!_unreachable.accept(uinfo.gw_id, id, uinfo.generation, now))
+                continue;
+
+            // `id` node cannot be reached through the gateway `uinfo.gw_id`.
+            // Disable all routes containing the specified subchain.
+            auto n = _rtab.remove_routes(uinfo.gw_id, id
+                , [this] (node_id dest_id, std::size_t gw_chain_index) {
+                    if (_on_route_lost)
+                        _on_route_lost(dest_id, gw_chain_index);
+                }
+                , [this] (node_id dest_id) {
+                    if (_on_node_unreachable)
+                        _on_node_unreachable(dest_id);
+                }
+            );
+
+            if (n > 0)
+                forward_info.ids.push_back(id);
         }
+
+        // Forward packet to sibling nodes excluding `peer_id`.
+        if (_is_gateway && !forward_info.ids.empty()) {
+            archive_type ar = _rtab.serialize(std::move(forward_info));
+            forward_packet(peer_id, ar);
+        }
+    }
+
+    /**
+     * Broadcasts aggregated notifications about the sibling nodes lost before the hold-down
+     * deadline and purges expired records of the processed notifications.
+     *
+     * @return Number of broadcasted packets.
+     */
+    unsigned int flush_unreachable ()
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+
+        auto now = std::chrono::steady_clock::now();
+
+        _unreachable.purge(now);
+
+        if (_unreachable.pending_count() == 0)
+            return 0;
+
+        auto ids = _unreachable.fetch_expired(now);
+        unsigned int n = 0;
+
+        split_batches(ids, [this, & n] (std::vector<node_id> batch) {
+            broadcast_unreachable(std::move(batch));
+            ++n;
+        });
+
+        return n;
+    }
+
+    /**
+     * Removes provisional routes not confirmed during the provisional route timeout.
+     */
+    unsigned int expire_provisional_routes ()
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+
+        if (!_provisional_deadline || std::chrono::steady_clock::now() < *_provisional_deadline)
+            return 0;
+
+        _provisional_deadline = pfs::nullopt;
+
+        auto n = _rtab.remove_provisional_routes([this] (node_id dest_id) {
+            if (_on_node_unreachable)
+                _on_node_unreachable(dest_id);
+        });
+
+        NETTY__TRACE(MESHNET_TAG, "provisional routes expired: {}", n);
+
+        return static_cast<unsigned int>(n);
     }
 
     void process_route_received (peer_index_t /*idx*/, node_id id, bool is_response
@@ -728,6 +1364,7 @@ private:
                     auto res = _rtab.add_route(dest_id, rinfo.route);
                     gw_chain_index = res.first;
                     new_route_added = res.second;
+                    _rtab.set_route_latency(dest_id, gw_chain_index, tail_latencies(rinfo, 1));
                 }
             } else if (_is_gateway) {
                 // Add route to responder to routing table and forward response.
@@ -752,6 +1389,8 @@ private:
                         auto res = _rtab.add_subroute(dest_id, _id, rinfo.route);
                         gw_chain_index = res.first;
                         new_route_added = res.second;
+                        _rtab.set_route_latency(dest_id, gw_chain_index
+                            , tail_latencies(rinfo, index + 2));
                     }
 
                     // Serialize response and send to previous gateway (if index > 0)
@@ -800,8 +1439,16 @@ private:
                     new_route_added = res.second;
                 }
 
+                // Links of the reversed route excluding the first hop
+                if (gw_chain_index > 0) {
+                    auto tail = rinfo.latencies;
+                    tail.resize(rinfo.route.size(), 0);
+                    std::reverse(tail.begin(), tail.end());
+                    _rtab.set_route_latency(dest_id, gw_chain_index, tail);
+                }
+
                 // Initiate response and transmit it by the reverse route
-                archive_type msg = _rtab.serialize_response(_id, rinfo);
+                archive_type msg = _rtab.serialize_response(_id, rinfo, _rtab.link_latency(id));
                 enqueue_packet(id, 0, std::move(msg));
 
                 // Forward request to nearest nodes if this gateway is not present in the received route
@@ -810,7 +1457,7 @@ private:
                     auto opt_index = rinfo.gateway_index(_id);
 
                     if (!opt_index) {
-                        archive_type msg1 = _rtab.serialize_request(_id, rinfo);
+                        archive_type msg1 = _rtab.serialize_request(_id, rinfo, _rtab.link_latency(id));
                         forward_packet(id, std::move(msg1));
                     }
                 }
@@ -829,6 +1476,358 @@ private:
         }
     }
 
+    void process_route_update_received (peer_index_t /*idx*/, node_id peer_id
+        , std::vector<route_update_info<node_id>> const & entries)
+    {
+        bool peer_is_gateway = _rtab.is_sibling_gateway(peer_id);
+
+        for (auto const & u: entries) {
+            // Stale or unreachable own entry is outdated by the next even sequence number
+            if (u.dest_id == _id) {
+                if (static_cast<std::int32_t>(u.seqno - _seqno) > 0) {
+                    _seqno = u.seqno + (u.seqno % 2 == 0 ? 2 : 1);
+                    _changed_routes.insert(_id);
+                }
+
+                continue;
+            }
+
+            auto res = _rtab.update_route(peer_id, peer_is_gateway, u);
+
+            if (res == route_update_result::ignored)
+                continue;
+
+            if (res == route_update_result::route_ready) {
+                if (_on_route_ready) {
+                    NETTY__TRACE(MESHNET_TAG, "route ready: {} (hops={}, next hop={})"
+                        , to_string(u.dest_id), _rtab.incremental_hops(u.dest_id), to_string(peer_id));
+
+                    _on_route_ready(u.dest_id, 1, gateway_chain_type{peer_id});
+                }
+            } else if (res == route_update_result::route_lost) {
+                if (_on_route_lost)
+                    _on_route_lost(u.dest_id, 1);
+
+                if (!_rtab.is_reachable(u.dest_id) && _on_node_unreachable)
+                    _on_node_unreachable(u.dest_id);
+            }
+
+            // Regular nodes advertise themselves only
+            if (_is_gateway)
+                _changed_routes.insert(u.dest_id);
+        }
+    }
+
+    /**
+     * Marks incremental routes through the lost sibling node @a peer_id as unreachable.
+     */
+    void invalidate_routes_via (node_id peer_id)
+    {
+        _rtab.invalidate_routes_via(peer_id, [this, peer_id] (node_id dest_id) {
+            if (_is_gateway)
+                _changed_routes.insert(dest_id);
+
+            // Sibling nodes are reported by routing_table::remove_routes()
+            if (dest_id == peer_id || _sibling_writers.find(dest_id) != _sibling_writers.end())
+                return;
+
+            if (_on_route_lost)
+                _on_route_lost(dest_id, 1);
+
+            if (!_rtab.is_reachable(dest_id) && _on_node_unreachable)
+                _on_node_unreachable(dest_id);
+        });
+    }
+
+    void process_segment_update_received (node_id peer_id
+        , std::vector<route_update_info<segment_id_t>> const & entries)
+    {
+        if (!_segment_resolver)
+            return;
+
+        bool peer_is_gateway = _rtab.is_sibling_gateway(peer_id);
+
+        for (auto const & u: entries) {
+            if (u.dest_id == 0)
+                continue;
+
+            // Own segment entry is originated by all border gateways of the segment, so they
+            // synchronize the sequence number to make the metric comparable.
+            if (u.dest_id == _segment) {
+                if (_is_gateway && static_cast<std::int32_t>(u.seqno - _segment_seqno) > 0) {
+                    _segment_seqno = u.seqno + (u.seqno % 2 == 0 ? 0 : 1);
+                    _changed_segments.insert(_segment);
+                }
+
+                continue;
+            }
+
+            auto res = _rtab.update_segment_route(peer_id, peer_is_gateway, u);
+
+            if (res != route_update_result::ignored && _is_gateway)
+                _changed_segments.insert(u.dest_id);
+        }
+    }
+
+    segment_id_t segment_of (node_id id) const
+    {
+        return _segment_resolver ? _segment_resolver(id) : segment_id_t{0};
+    }
+
+    /**
+     * Returns next hop toward the border gateway of the remote segment of the node @a id.
+     */
+    pfs::optional<node_id> segment_gateway_for (node_id id) const
+    {
+        if (!_segment_resolver)
+            return pfs::nullopt;
+
+        auto segment = _segment_resolver(id);
+
+        if (segment == 0 || segment == _segment)
+            return pfs::nullopt;
+
+        return _rtab.gateway_for_segment(segment);
+    }
+
+    /**
+     * Checks if route entry for the node @a dest_id should be advertised to the sibling node
+     * @a peer_id (hierarchical routing hides nodes of the other segments).
+     */
+    bool is_advertised_to (node_id dest_id, node_id peer_id) const
+    {
+        if (!_segment_resolver || dest_id == _id)
+            return true;
+
+        auto segment = segment_of(dest_id);
+        auto peer_segment = segment_of(peer_id);
+
+        return segment == 0 || peer_segment == 0 || segment == peer_segment;
+    }
+
+    /**
+     * Sends own route entry and (by gateway) all known routes to the sibling node @a peer_id.
+     */
+    void send_route_updates (node_id peer_id)
+    {
+        std::vector<route_update_info<node_id>> entries;
+        std::vector<route_update_info<segment_id_t>> segment_entries;
+
+        entries.push_back(route_update_info<node_id>{_id, 0, _seqno});
+
+        if (_is_gateway) {
+            _rtab.foreach_route_update([this, & entries, peer_id] (route_update_info<node_id> const & u) {
+                if (is_advertised_to(u.dest_id, peer_id))
+                    entries.push_back(u);
+            });
+
+            if (_segment != 0) {
+                segment_entries.push_back(route_update_info<segment_id_t>{_segment, 0, _segment_seqno});
+
+                _rtab.foreach_segment_route_update([& segment_entries] (route_update_info<segment_id_t> const & u) {
+                    segment_entries.push_back(u);
+                });
+            }
+        }
+
+        send_route_update_batches(peer_id, entries, segment_entries);
+    }
+
+    /**
+     * Enqueues route entries to the sibling node @a peer_id in batched route update packets.
+     *
+     * @return Number of enqueued packets.
+     */
+    unsigned int send_route_update_batches (node_id peer_id
+        , std::vector<route_update_info<node_id>> const & entries
+        , std::vector<route_update_info<segment_id_t>> const & segment_entries)
+    {
+        unsigned int n = 0;
+
+        split_batches(entries, [this, peer_id, & n] (std::vector<route_update_info<node_id>> batch) {
+            this->enqueue_packet(peer_id, 0, _rtab.serialize(std::move(batch)));
+            ++n;
+        });
+
+        split_batches(segment_entries, [this, peer_id, & n] (std::vector<route_update_info<segment_id_t>> batch) {
+            this->enqueue_packet(peer_id, 0, _rtab.serialize(std::vector<route_update_info<node_id>>{}
+                , std::move(batch)));
+            ++n;
+        });
+
+        return n;
+    }
+
+    /**
+     * Broadcasts changed routes in batched route update packets.
+     *
+     * @return Number of broadcasted packets.
+     */
+    unsigned int flush_route_updates ()
+    {
+        std::unique_lock<recursive_mutex_type> locker{_writer_mtx};
+
+        if ((_changed_routes.empty() && _changed_segments.empty())
+                || _propagation != route_propagation::incremental) {
+            return 0;
+        }
+
+        std::vector<route_update_info<node_id>> entries;
+        entries.reserve(_changed_routes.size());
+
+        for (auto const & id: _changed_routes) {
+            if (id == _id) {
+                entries.push_back(route_update_info<node_id>{_id, 0, _seqno});
+                continue;
+            }
+
+            auto u = _rtab.route_update_for(id);
+
+            if (u)
+                entries.push_back(*u);
+        }
+
+        _changed_routes.clear();
+
+        unsigned int n = 0;
+
+        if (!_segment_resolver) {
+            split_batches(entries, [this, & n] (std::vector<route_update_info<node_id>> batch) {
+                broadcast_packet(_rtab.serialize(std::move(batch)));
+                ++n;
+            });
+
+            return n;
+        }
+
+        std::vector<route_update_info<segment_id_t>> segment_entries;
+
+        for (auto const & segment: _changed_segments) {
+            if (segment == _segment) {
+                segment_entries.push_back(route_update_info<segment_id_t>{_segment, 0, _segment_seqno});
+                continue;
+            }
+
+            auto u = _rtab.segment_route_update_for(segment);
+
+            if (u)
+                segment_entries.push_back(*u);
+        }
+
+        _changed_segments.clear();
+
+        // Entries are filtered by the segment of the sibling node, so broadcast is not applicable
+        for (auto const & x: _sibling_writers) {
+            std::vector<route_update_info<node_id>> peer_entries;
+
+            for (auto const & u: entries) {
+                if (is_advertised_to(u.dest_id, x.first))
+                    peer_entries.push_back(u);
+            }
+
+            n += send_route_update_batches(x.first, peer_entries, segment_entries);
+        }
+
+        return n;
+    }
+
+    /**
+     * Splits @a items into batches to send by separate control packets.
+     */
+    template <typename T, typename F>
+    static void split_batches (std::vector<T> const & items, F && f)
+    {
+        // Limits the packet size to avoid long blocking of the channels by the control traffic
+        std::size_t const batch_size = 256;
+
+        for (std::size_t i = 0; i < items.size(); i += batch_size) {
+            auto last = (std::min)(i + batch_size, items.size());
+            f(std::vector<T>(items.begin() + i, items.begin() + last));
+        }
+    }
+
+    /**
+     * Groups @a receivers by the next hop and enqueues single packet for each group: unicast
+     * packet for the single receiver or multicast packet otherwise.
+     */
+    bool enqueue_multicast_helper (node_id sender_id, std::vector<node_id> const & receivers
+        , int priority, char const * data, std::size_t len)
+    {
+        bool originated = sender_id == _id;
+        bool success = true;
+
+        std::vector<std::pair<node_id, peer_interface_type *>> next_hops;
+        std::vector<std::vector<node_id>> groups;
+        std::unordered_map<node_id, std::size_t> group_index;
+
+        for (auto const & id: receivers) {
+            if (id == _id)
+                continue;
+
+            node_id gw_id;
+            auto wr = locate_writer(id, & gw_id);
+
+            if (wr == nullptr) {
+                if (originated)
+                    _on_error(tr::f_("peer not found to send data to: {}", to_string(id)));
+
+                success = false;
+                continue;
+            }
+
+            auto res = group_index.emplace(gw_id, groups.size());
+
+            if (res.second) {
+                next_hops.emplace_back(gw_id, wr);
+                groups.emplace_back();
+            }
+
+            auto & group = groups[res.first->second];
+
+            if (std::find(group.begin(), group.end(), id) == group.end())
+                group.push_back(id);
+        }
+
+        for (std::size_t i = 0; i < groups.size(); i++) {
+            auto gw_id = next_hops[i].first;
+            auto & group = groups[i];
+
+            archive_type ar;
+            serializer_type out {ar};
+
+            if (group.size() == 1) {
+                if (originated && group[0] == gw_id) {
+                    // Domestic exchange
+                    ddata_packet pkt;
+                    pkt.serialize(out, data, len);
+                } else {
+                    gdata_packet<node_id> pkt {sender_id, group[0]};
+                    pkt.serialize(out, data, len);
+                }
+            } else {
+                gdata_packet<node_id> pkt {sender_id, std::move(group)};
+                pkt.serialize(out, data, len);
+            }
+
+            if (!next_hops[i].second->enqueue_packet(gw_id, priority, std::move(ar)))
+                success = false;
+        }
+
+        return success;
+    }
+
+    /**
+     * Returns link latencies collected by route discovery starting from index @a first.
+     */
+    static std::vector<std::uint32_t> tail_latencies (route_info<node_id> const & rinfo
+        , std::size_t first)
+    {
+        if (first >= rinfo.latencies.size())
+            return std::vector<std::uint32_t>{};
+
+        return std::vector<std::uint32_t>(rinfo.latencies.begin() + first, rinfo.latencies.end());
+    }
+
     /**
      * Forward special packets (route and unreachable) to nearest nodes excluding node identified
      * by @a sender_id.
@@ -837,21 +1836,37 @@ private:
      */
     void forward_packet (node_id sender_id, archive_type const & ar)
     {
+        auto copies = _sibling_writers.size();
+
+        if (_sibling_writers.find(sender_id) != _sibling_writers.end())
+            --copies;
+
+        count_control(ar.size(), copies);
+
         for (peer_index_t i = 0; i < _endpoints.size(); i++)
             _endpoints[i]->enqueue_forward_packet(sender_id, 0, ar.data(), ar.size());
     }
 
     /**
-     * Broadcasts unreachable packet (used by gateways only).
+     * Broadcasts special packet to all sibling nodes.
      */
-    void broadcast_unreachable (node_id unreachable_id)
+    void broadcast_packet (archive_type const & ar)
     {
-        unreachable_info<node_id> uinfo { _id, unreachable_id };
-        archive_type ar = _rtab.serialize(std::move(uinfo));
+        count_control(ar.size(), _sibling_writers.size());
 
         for (peer_index_t i = 0; i < _endpoints.size(); i++)
             _endpoints[i]->enqueue_broadcast_packet(0, ar.data(), ar.size());
     }
+
+    /**
+     * Broadcasts unreachable packet (used by gateways only).
+     */
+    void broadcast_unreachable (std::vector<node_id> unreachable_ids)
+    {
+        unreachable_info<node_id> uinfo { _id, std::move(unreachable_ids)
+            , _unreachable.next_generation() };
+        broadcast_packet(_rtab.serialize(std::move(uinfo)));
+    }
 };
 
 } // namespace meshnet
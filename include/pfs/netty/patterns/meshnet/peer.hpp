@@ -7,6 +7,19 @@
 //      2025.01.16 Initial version (`node.hpp`).
 //      2025.12.18 Renamed to `peer.hpp`.
 //                 `node` renamed to `peer`.
+//      2026.05.12 Added queue limits and watermark callbacks.
+//      2026.05.30 Added method `queued_bytes()`.
+//      2026.06.01 Added RTT measurement callback.
+//      2026.06.03 Added multicast global data forwarding.
+//      2026.06.05 Added cut-through forwarding of global data.
+//      2026.06.07 Separated I/O lock from the writer (enqueue) lock.
+//      2026.06.09 Added method `set_heartbeat_suppression()`.
+//      2026.06.11 Added method `suspicion()`.
+//      2026.06.13 Added `on_route_update_received` callback.
+//      2026.06.15 Added segment entries to `on_route_update_received` callback.
+//      2026.06.21 Added method `set_max_connecting()`, reconnection to gateways is prioritized.
+//      2026.06.27 Heartbeat timestamps are enabled by the handshake.
+//                 Method `suspicion()` does not acquire I/O lock.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
@@ -21,11 +34,14 @@
 #include "../../socket_pool.hpp"
 #include "../../trace.hpp"
 #include "../../writer_pool.hpp"
+#include "../../writer_queue_limits.hpp"
 #include "channel_map.hpp"
 #include "peer_index.hpp"
 #include "peer_interface.hpp"
 #include "protocol.hpp"
 #include "route_info.hpp"
+#include "route_update_info.hpp"
+#include "segment_id.hpp"
 #include "tag.hpp"
 #include "unreachable_info.hpp"
 #include <pfs/i18n.hpp>
@@ -39,6 +55,7 @@
 #include <set>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #if NETTY__TELEMETRY_ENABLED
 #   include "telemetry.hpp"
@@ -108,6 +125,9 @@ private:
     {
         connection_options conn_opts;
         pfs::optional<reconnection_policy> reconn_policy;
+
+        // True if the remote node is a gateway (known after the first handshake)
+        bool is_gateway {false};
     };
 
     using host_cache_type = std::map<socket4_addr, host_info>;
@@ -139,8 +159,15 @@ private:
     // Make sense when peer is a part of meshnet node.
     peer_index_t _index {INVALID_PEER_INDEX};
 
-    // Writer mutex to protect sending
-    writer_mutex_type _writer_mtx;
+    // Writer mutex to protect channels and output queues (shared by producers and I/O)
+    mutable writer_mutex_type _writer_mtx;
+
+    // I/O mutex to serialize network I/O (step), producers never acquire it
+    writer_mutex_type _io_mtx;
+
+    // Heartbeat mutex to protect failure detectors state (modified by I/O, read by `suspicion()`).
+    // Heartbeat controller callbacks do not notify upper level under it.
+    writer_mutex_type _heartbeat_mtx;
 
     std::queue<std::function<void ()>> _deferred_actions;
 
@@ -170,9 +197,15 @@ private: // Callbacks
     callback_t<void (peer_index_t, node_id, std::string const &)> _on_duplicate_id;
     callback_t<void (peer_index_t, node_id, unreachable_info<node_id> const &)> _on_unreachable_received;
     callback_t<void (peer_index_t, node_id, bool, route_info<node_id> const &)> _on_route_received;
+    callback_t<void (peer_index_t, node_id, std::vector<route_update_info<node_id>> const &
+        , std::vector<route_update_info<segment_id_t>> const &)> _on_route_update_received;
     callback_t<void (node_id, int, archive_type)> _on_domestic_data_received;
     callback_t<void (node_id, int, node_id, node_id, archive_type)> _on_global_data_received;
     callback_t<void (int, node_id, node_id, archive_type)> _on_forward_global_packet;
+    callback_t<void (int, node_id, std::vector<node_id>, archive_type)> _on_forward_global_multicast;
+    callback_t<void (node_id, std::size_t)> _on_queue_high;
+    callback_t<void (node_id, std::size_t)> _on_queue_low;
+    callback_t<void (node_id, std::chrono::microseconds, std::chrono::microseconds)> _on_rtt_updated;
 
 public:
 #if NETTY__TELEMETRY_ENABLED
@@ -205,7 +238,11 @@ public:
             NETTY__TRACE(MESHNET_TAG, "socket accepted: #{}: {}", sock.id(), to_string(sock.saddr()));
             _input_controller.add(sock.id());
             _reader_pool.add(sock.id());
-            _writer_pool.add(sock.id());
+            {
+                std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+                _writer_pool.add(sock.id());
+            }
+
             _socket_pool.add_accepted(std::move(sock));
         };
 
@@ -259,6 +296,11 @@ public:
 
         _reader_pool.on_data_ready = [this] (socket_id sid, archive_type data)
         {
+            {
+                std::unique_lock<writer_mutex_type> heartbeat_locker{_heartbeat_mtx};
+                _heartbeat_controller.notify_received(sid);
+            }
+
             _input_controller.process_input(sid, std::move(data));
         };
 
@@ -270,13 +312,15 @@ public:
         _writer_pool.on_failure = [this] (socket_id sid, netty::error const & err)
         {
             _on_error(tr::f_("write to socket failure: #{}: {}", sid, err.what()));
-            schedule_reconnection(sid);
+
+            // Called under writer lock, reconnection notifies upper level so it is deferred
+            _deferred_actions.push([this, sid] () { schedule_reconnection(sid); });
         };
 
         _writer_pool.on_disconnected = [this] (socket_id sid)
         {
             NETTY__TRACE(MESHNET_TAG, "writer socket disconnected: #{}", sid);
-            schedule_reconnection(sid);
+            _deferred_actions.push([this, sid] () { schedule_reconnection(sid); });
         };
 
         _writer_pool.locate_socket = [this] (socket_id sid)
@@ -284,6 +328,34 @@ public:
             return _socket_pool.locate(sid);
         };
 
+        _writer_pool.on_frame_sent = [this] (socket_id sid, std::size_t)
+        {
+            _heartbeat_controller.notify_sent(sid);
+        };
+
+        _writer_pool.on_queue_high = [this] (socket_id sid, std::size_t bytes)
+        {
+            if (_on_queue_high) {
+                auto id_ptr = _channels.locate_writer(sid);
+
+                if (id_ptr != nullptr)
+                    _on_queue_high(*id_ptr, bytes);
+            }
+        };
+
+        _writer_pool.on_queue_low = [this] (socket_id sid, std::size_t bytes)
+        {
+            if (_on_queue_low) {
+                auto id_ptr = _channels.locate_writer(sid);
+
+                // Called under writer lock while sending, so notify outside of it
+                if (id_ptr != nullptr) {
+                    auto id = *id_ptr;
+                    _deferred_actions.push([this, id, bytes] () { _on_queue_low(id, bytes); });
+                }
+            }
+        };
+
         ////////////////////////////////////////////////////////////////////////////////////////////
         // Handshake controller settings
         ////////////////////////////////////////////////////////////////////////////////////////////
@@ -301,7 +373,9 @@ public:
         _handshake_controller.on_completed = [this] (node_id id, socket_id reader_sid
             , socket_id writer_sid, bool is_gateway)
         {
+            std::unique_lock<writer_mutex_type> locker{_writer_mtx};
             auto success = _channels.insert(id, reader_sid, writer_sid);
+            locker.unlock();
 
             if (!success) {
                 // Not need to throw exception, only error notification
@@ -317,7 +391,13 @@ public:
                 return;
             }
 
-            _heartbeat_controller.update(writer_sid);
+            {
+                std::unique_lock<writer_mutex_type> heartbeat_locker{_heartbeat_mtx};
+                _heartbeat_controller.update(writer_sid);
+            }
+
+            if (is_gateway)
+                mark_gateway_host(reader_sid, writer_sid);
 
             NETTY__TRACE(MESHNET_TAG, "channel established: {} (reader_sid={}, writer_sid={})"
                     , to_string(id), reader_sid, writer_sid);
@@ -357,7 +437,23 @@ public:
         _heartbeat_controller.on_expired = [this] (socket_id sid)
         {
             NETTY__TRACE(MESHNET_TAG, "socket heartbeat timeout exceeded: #{}", sid);
-            schedule_reconnection(sid);
+
+            // Called under heartbeat lock, reconnection notifies upper level so it is deferred
+            _deferred_actions.push([this, sid] () { schedule_reconnection(sid); });
+        };
+
+        _heartbeat_controller.on_rtt_updated = [this] (socket_id sid, std::chrono::microseconds srtt
+            , std::chrono::microseconds rttvar)
+        {
+            if (_on_rtt_updated) {
+                auto id_ptr = _channels.locate_writer(sid);
+
+                // Called under heartbeat lock, so notify outside of it
+                if (id_ptr != nullptr) {
+                    auto id = *id_ptr;
+                    _deferred_actions.push([this, id, srtt, rttvar] () { _on_rtt_updated(id, srtt, rttvar); });
+                }
+            }
         };
 
         ////////////////////////////////////////////////////////////////////////////////////////////
@@ -365,12 +461,26 @@ public:
         ////////////////////////////////////////////////////////////////////////////////////////////
         _input_controller.on_handshake = [this] (socket_id sid, handshake_packet<node_id> && pkt)
         {
+            // Single link channel: handshake socket is the writer socket too
+            if (pkt.supports_timestamps()) {
+                std::unique_lock<writer_mutex_type> heartbeat_locker{_heartbeat_mtx};
+                _heartbeat_controller.enable_timestamps(sid);
+            }
+
             _handshake_controller.process(sid, pkt);
         };
 
         _input_controller.on_heartbeat = [this] (socket_id sid, heartbeat_packet && pkt)
         {
-            _heartbeat_controller.process(sid, pkt);
+            auto id_ptr = _channels.locate_reader(sid);
+            auto writer_sid_ptr = id_ptr != nullptr ? _channels.locate_writer(*id_ptr) : nullptr;
+
+            std::unique_lock<writer_mutex_type> heartbeat_locker{_heartbeat_mtx};
+
+            if (writer_sid_ptr != nullptr)
+                _heartbeat_controller.process(sid, *writer_sid_ptr, pkt);
+            else
+                _heartbeat_controller.process(sid, pkt);
         };
 
         _input_controller.on_unreachable = [this] (socket_id sid, unreachable_packet<node_id> && pkt)
@@ -393,6 +503,16 @@ public:
             }
         };
 
+        _input_controller.on_route_update = [this] (socket_id sid, route_update_packet<node_id> && pkt)
+        {
+            if (_on_route_update_received) {
+                auto id_ptr = _channels.locate_reader(sid);
+
+                if (id_ptr != nullptr)
+                    _on_route_update_received(_index, *id_ptr, pkt.entries(), pkt.segment_entries());
+            }
+        };
+
         _input_controller.on_ddata = [this] (socket_id sid, int priority, archive_type && bytes)
         {
             if (_on_domestic_data_received) {
@@ -406,6 +526,11 @@ public:
         _input_controller.on_gdata = [this] (socket_id sid, int priority, gdata_packet<node_id> && pkt
             , archive_type && bytes)
         {
+            if (pkt.is_multicast()) {
+                process_multicast(sid, priority, pkt, std::move(bytes));
+                return;
+            }
+
             if (pkt.receiver_id() == _id) {
                 if (_on_global_data_received) {
                     auto id_ptr = _channels.locate_reader(sid);
@@ -429,6 +554,20 @@ public:
             }
         };
 
+        // Forward serialized global data packets as is
+        if (_is_gateway) {
+            _input_controller.enable_cut_through(_id);
+
+            _input_controller.on_gdata_forward = [this] (socket_id, int priority
+                , gdata_packet<node_id> const & pkt, char const * data, std::size_t len)
+            {
+                if (_on_forward_global_packet) {
+                    _on_forward_global_packet(priority, pkt.sender_id(), pkt.receiver_id()
+                        , archive_type{data, len});
+                }
+            };
+        }
+
         NETTY__TRACE(MESHNET_TAG, "peer constructed: id={}, gateway={}", to_string(_id), _is_gateway);
     }
 
@@ -548,6 +687,20 @@ public: // Set callbacks
         return *this;
     }
 
+    /**
+     * On incremental route update received.
+     *
+     * @details Callback @a f signature must match:
+     *          void (peer_index_t, node_id, std::vector<route_update_info<node_id>> const &
+     *              , std::vector<route_update_info<segment_id_t>> const &)
+     */
+    template <typename F>
+    peer & on_route_update_received (F && f)
+    {
+        _on_route_update_received = std::forward<F>(f);
+        return *this;
+    }
+
     /**
      * On domestic message received.
      *
@@ -588,6 +741,59 @@ public: // Set callbacks
         return *this;
     }
 
+    /**
+     * On global (intersubnet) multicast message received by gateway that must be forwarded to
+     * the rest of receivers.
+     *
+     * @details Callback @a f signature must match:
+     *          void (int priority, node_id sender, std::vector<node_id> receivers, archive_type data)
+     */
+    template <typename F>
+    peer & on_forward_global_multicast (F && f)
+    {
+        _on_forward_global_multicast = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Notify when output queue to the peer reaches the high watermark.
+     *
+     * @details Callback @a f signature must match:
+     *          void (node_id id, std::size_t queued_bytes)
+     */
+    template <typename F>
+    peer & on_queue_high (F && f)
+    {
+        _on_queue_high = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Notify when output queue to the congested peer falls to the low watermark.
+     *
+     * @details Callback @a f signature must match:
+     *          void (node_id id, std::size_t queued_bytes)
+     */
+    template <typename F>
+    peer & on_queue_low (F && f)
+    {
+        _on_queue_low = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Notify when round-trip time to the peer is measured by heartbeats.
+     *
+     * @details Callback @a f signature must match:
+     *          void (node_id id, std::chrono::microseconds srtt, std::chrono::microseconds rttvar)
+     */
+    template <typename F>
+    peer & on_rtt_updated (F && f)
+    {
+        _on_rtt_updated = std::forward<F>(f);
+        return *this;
+    }
+
 public:
     node_id id () const noexcept
     {
@@ -659,11 +865,13 @@ public:
      */
     void disconnect (node_id peer_id)
     {
+        std::unique_lock<writer_mutex_type> io_locker{_io_mtx};
         destroy_channel(peer_id);
     }
 
     void listen ()
     {
+        std::unique_lock<writer_mutex_type> io_locker{_io_mtx};
         NETTY__TRACE(MESHNET_TAG, "{}: listening", to_string(_id));
         _listener_pool.listen();
     }
@@ -679,8 +887,7 @@ public:
             serializer_type out {ar};
             ddata_packet pkt;
             pkt.serialize(out, data, len);
-            enqueue_private(*sid_ptr, priority, std::move(ar));
-            return true;
+            return enqueue_private(*sid_ptr, priority, std::move(ar));
         }
 
         _on_error(tr::f_("channel for send message not found: {}", to_string(id)));
@@ -694,6 +901,8 @@ public:
 
     /**
      * Enqueue serialized packet to send.
+     *
+     * @return @c true if channel found and packet accepted by the output queue.
      */
     bool enqueue_packet (node_id id, int priority, archive_type data)
     {
@@ -701,10 +910,8 @@ public:
 
         auto sid_ptr = _channels.locate_writer(id);
 
-        if (sid_ptr != nullptr) {
-            enqueue_private(*sid_ptr, priority, std::move(data));
-            return true;
-        }
+        if (sid_ptr != nullptr)
+            return enqueue_private(*sid_ptr, priority, std::move(data));
 
         _on_error(tr::f_("channel for send packet not found: {}", to_string(id)));
         return false;
@@ -712,6 +919,8 @@ public:
 
     /**
      * Enqueue serialized packet to send.
+     *
+     * @return @c true if channel found and packet accepted by the output queue.
      */
     bool enqueue_packet (node_id id, int priority, char const * data, std::size_t len)
     {
@@ -719,10 +928,8 @@ public:
 
         auto sid_ptr = _channels.locate_writer(id);
 
-        if (sid_ptr != nullptr) {
-            enqueue_private(*sid_ptr, priority, data, len);
-            return true;
-        }
+        if (sid_ptr != nullptr)
+            return enqueue_private(*sid_ptr, priority, data, len);
 
         _on_error(tr::f_("channel for send packet not found: {}", to_string(id)));
         return false;
@@ -758,16 +965,26 @@ public:
      */
     unsigned int step ()
     {
-        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        std::unique_lock<writer_mutex_type> io_locker{_io_mtx};
         unsigned int result = 0;
 
         result += _listener_pool.step();
         result += _connecting_pool.step();
-        result += _writer_pool.step();
+
+        // Only sending shares state with producers
+        {
+            std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+            result += _writer_pool.step();
+        }
+
         result += _reader_pool.step();
 
         result += _handshake_controller.step();
-        result += _heartbeat_controller.step();
+
+        {
+            std::unique_lock<writer_mutex_type> heartbeat_locker{_heartbeat_mtx};
+            result += _heartbeat_controller.step();
+        }
 
         // Remove trash
         _connecting_pool.apply_remove();
@@ -779,7 +996,12 @@ public:
         }
 
         _reader_pool.apply_remove();
-        _writer_pool.apply_remove();
+
+        {
+            std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+            _writer_pool.apply_remove();
+        }
+
         _socket_pool.apply_remove(); // Must be last in the removing sequence
 
         return result;
@@ -790,9 +1012,40 @@ public:
      */
     bool has_writer (node_id id) const
     {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
         return _channels.locate_writer(id) != nullptr;
     }
 
+    /**
+     * Returns number of bytes queued for sending to peer specified by identifier @a id.
+     */
+    std::size_t queued_bytes (node_id id)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        auto psid = _channels.locate_writer(id);
+        return psid != nullptr ? _writer_pool.occupancy(*psid).bytes : 0;
+    }
+
+    /**
+     * Returns suspicion level of the heartbeat failure detector for the channel with peer
+     * specified by identifier @a id (zero if no heartbeat received yet).
+     */
+    double suspicion (node_id id)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        auto psid = _channels.locate_reader(id);
+
+        if (psid == nullptr)
+            return 0;
+
+        auto sid = *psid;
+        locker.unlock();
+
+        // Heartbeat lock is never acquired under writer lock
+        std::unique_lock<writer_mutex_type> heartbeat_locker{_heartbeat_mtx};
+        return _heartbeat_controller.suspicion(sid);
+    }
+
     /**
      * Sets frame size for exchange with peer specified by identifier @a id.
      */
@@ -805,11 +1058,55 @@ public:
             _writer_pool.set_frame_size(*psid, frame_size);
     }
 
+    /**
+     * Sets output queue limits for all channels.
+     */
+    void set_queue_limits (writer_queue_limits const & limits)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        _writer_pool.set_queue_limits(limits);
+    }
+
+    /**
+     * Enables/disables checksum verification of the global data forwarded by gateway (disabled
+     * by default, checksum is verified by the receiver).
+     */
+    void set_forward_checksum_verification (bool enable)
+    {
+        std::unique_lock<writer_mutex_type> io_locker{_io_mtx};
+        _input_controller.verify_forwarded_checksum(enable);
+    }
+
+    /**
+     * Sets maximum number of the concurrent outstanding connects (zero means unlimited, default).
+     *
+     * @details Connections over the limit are postponed, reconnections to the gateways are
+     *          started first. Limits the connection storm after the restart of the remote node.
+     */
+    void set_max_connecting (std::size_t n)
+    {
+        std::unique_lock<writer_mutex_type> io_locker{_io_mtx};
+        _connecting_pool.set_max_connecting(n);
+    }
+
+    /**
+     * Enables/disables heartbeat suppression: any received frame refreshes channel liveness and
+     * heartbeats are not sent through the channels actively sending data. Must be enabled on both
+     * sides of the channels.
+     */
+    void set_heartbeat_suppression (bool enable)
+    {
+        std::unique_lock<writer_mutex_type> io_locker{_io_mtx};
+        std::unique_lock<writer_mutex_type> heartbeat_locker{_heartbeat_mtx};
+        _heartbeat_controller.set_suppression(enable);
+    }
+
     /**
      * Close all channels and clear channel collection.
      */
     void clear_channels ()
     {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
         _channels.clear();
     }
 
@@ -830,9 +1127,16 @@ private:
         if (_socket_pool.locate(sid) != nullptr) {
             _deferred_actions.push([this, sid]() {
                 _handshake_controller.cancel(sid);
-                _heartbeat_controller.remove(sid);
+
+                {
+                    std::unique_lock<writer_mutex_type> heartbeat_locker{_heartbeat_mtx};
+                    _heartbeat_controller.remove(sid);
+                }
+
                 _input_controller.remove(sid);
                 _reader_pool.remove_later(sid);
+
+                std::unique_lock<writer_mutex_type> locker{_writer_mtx};
                 _writer_pool.remove_later(sid);
                 _socket_pool.remove_later(sid);
             });
@@ -863,6 +1167,26 @@ private:
         }
     }
 
+    /**
+     * Marks host connected by the socket (@a reader_sid or @a writer_sid) as a gateway.
+     */
+    void mark_gateway_host (socket_id reader_sid, socket_id writer_sid)
+    {
+        socket_id sids[] = {reader_sid, writer_sid};
+
+        for (auto sid: sids) {
+            bool is_accepted = false;
+            auto psock = _socket_pool.locate(sid, & is_accepted);
+
+            if (psock != nullptr && !is_accepted) {
+                auto pos = _hosts_cache.find(psock->saddr());
+
+                if (pos != _hosts_cache.end())
+                    pos->second.is_gateway = true;
+            }
+        }
+    }
+
     void schedule_reconnection (socket4_addr saddr)
     {
         if (!reconnection_policy::supported())
@@ -888,7 +1212,8 @@ private:
             bool initial_reconnecting = h.reconn_policy->attempts() == 0;
             auto reconn_timeout = h.reconn_policy->fetch_timeout();
 
-            _connecting_pool.connect_timeout(h.conn_opts, reconn_timeout);
+            // Links to gateways are restored first
+            _connecting_pool.connect_timeout(h.conn_opts, reconn_timeout, h.is_gateway ? 1 : 0);
 
             if (initial_reconnecting)
                 _on_reconnection_started(_index, h.conn_opts);
@@ -914,7 +1239,9 @@ private:
 
     void destroy_channel (node_id peer_id)
     {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
         auto success = _channels.close_channel(peer_id);
+        locker.unlock();
 
         if (success) {
             NETTY__TRACE(MESHNET_TAG, "channel destroyed: {}", to_string(peer_id));
@@ -938,15 +1265,52 @@ private:
         }
     }
 
+    /**
+     * Delivers multicast global message to this node (if it is one of the receivers) and passes
+     * it to forward to the rest of receivers (gateway only).
+     */
+    void process_multicast (socket_id sid, int priority, gdata_packet<node_id> const & pkt
+        , archive_type && bytes)
+    {
+        std::vector<node_id> rest;
+        bool is_receiver = false;
+
+        for (auto const & id: pkt.receivers()) {
+            if (id == _id)
+                is_receiver = true;
+            else
+                rest.push_back(id);
+        }
+
+        if (!rest.empty() && _is_gateway && _on_forward_global_multicast) {
+            if (is_receiver) {
+                _on_forward_global_multicast(priority, pkt.sender_id(), std::move(rest)
+                    , archive_type{bytes});
+            } else {
+                _on_forward_global_multicast(priority, pkt.sender_id(), std::move(rest)
+                    , std::move(bytes));
+            }
+        }
+
+        if (is_receiver && _on_global_data_received) {
+            auto id_ptr = _channels.locate_reader(sid);
+
+            if (id_ptr != nullptr)
+                _on_global_data_received(*id_ptr, priority, pkt.sender_id(), _id, std::move(bytes));
+        }
+    }
+
 public: // Below methods are for internal use only
-    void enqueue_private (socket_id sid, int priority, char const * data, std::size_t len)
+    bool enqueue_private (socket_id sid, int priority, char const * data, std::size_t len)
     {
-        _writer_pool.enqueue(sid, priority, data, len);
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        return _writer_pool.enqueue(sid, priority, data, len).accepted;
     }
 
-    void enqueue_private (socket_id sid, int priority, archive_type && data)
+    bool enqueue_private (socket_id sid, int priority, archive_type && data)
     {
-        _writer_pool.enqueue(sid, priority, std::move(data));
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        return _writer_pool.enqueue(sid, priority, std::move(data)).accepted;
     }
 
 public: // peer_interface
@@ -1015,11 +1379,36 @@ public: // peer_interface
             return Peer::has_writer(id);
         }
 
+        std::size_t queued_bytes (node_id id) override
+        {
+            return Peer::queued_bytes(id);
+        }
+
+        double suspicion (node_id id) override
+        {
+            return Peer::suspicion(id);
+        }
+
         void set_frame_size (node_id id, std::uint16_t frame_size) override
         {
             Peer::set_frame_size(id, frame_size);
         }
 
+        void set_queue_limits (writer_queue_limits const & limits) override
+        {
+            Peer::set_queue_limits(limits);
+        }
+
+        void set_forward_checksum_verification (bool enable) override
+        {
+            Peer::set_forward_checksum_verification(enable);
+        }
+
+        void set_heartbeat_suppression (bool enable) override
+        {
+            Peer::set_heartbeat_suppression(enable);
+        }
+
         unsigned int step () override
         {
             return Peer::step();
@@ -1096,6 +1485,13 @@ public: // peer_interface
             Peer::on_route_received(std::move(cb));
         }
 
+        void on_route_update_received (callback_t<void (peer_index_t, node_id
+            , std::vector<route_update_info<node_id>> const &
+            , std::vector<route_update_info<segment_id_t>> const &)> cb) override
+        {
+            Peer::on_route_update_received(std::move(cb));
+        }
+
         void on_domestic_data_received (callback_t<void (node_id, int, archive_type)> cb) override
         {
             Peer::on_domestic_data_received(std::move(cb));
@@ -1113,6 +1509,28 @@ public: // peer_interface
         {
             Peer::on_forward_global_packet(std::move(cb));
         }
+
+        void on_forward_global_multicast (callback_t<void (int /*priority*/, node_id /*sender ID*/
+            , std::vector<node_id> /*receivers*/, archive_type)> cb) override
+        {
+            Peer::on_forward_global_multicast(std::move(cb));
+        }
+
+        void on_queue_high (callback_t<void (node_id, std::size_t)> cb) override
+        {
+            Peer::on_queue_high(std::move(cb));
+        }
+
+        void on_queue_low (callback_t<void (node_id, std::size_t)> cb) override
+        {
+            Peer::on_queue_low(std::move(cb));
+        }
+
+        void on_rtt_updated (callback_t<void (node_id, std::chrono::microseconds
+            , std::chrono::microseconds)> cb) override
+        {
+            Peer::on_rtt_updated(std::move(cb));
+        }
     };
 
     template <typename ...Args>
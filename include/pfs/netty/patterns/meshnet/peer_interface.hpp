@@ -8,6 +8,15 @@
 //      2025.06.30 Added method `set_frame_size()`.
 //      2025.12.18 Renamed to `peer_interface.hpp`.
 //                 `node_interface` renamed to `peer_interface`.
+//      2026.05.12 Added queue limits and watermark callbacks.
+//      2026.05.30 Added method `queued_bytes()`.
+//      2026.06.01 Added `on_rtt_updated` callback.
+//      2026.06.03 Added `on_forward_global_multicast` callback.
+//      2026.06.05 Added method `set_forward_checksum_verification()`.
+//      2026.06.09 Added method `set_heartbeat_suppression()`.
+//      2026.06.11 Added method `suspicion()`.
+//      2026.06.13 Added `on_route_update_received` callback.
+//      2026.06.15 Added segment entries to `on_route_update_received` callback.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
@@ -16,7 +25,9 @@
 #include "../../error.hpp"
 #include "../../listener_options.hpp"
 #include "../../socket4_addr.hpp"
+#include "../../writer_queue_limits.hpp"
 #include "peer_index.hpp"
+#include "segment_id.hpp"
 #include <chrono>
 #include <map>
 #include <string>
@@ -50,7 +61,12 @@ public:
     virtual void enqueue (node_id id, int priority, char const * data, std::size_t len) = 0;
     virtual void enqueue (node_id id, int priority, archive_type data) = 0;
     virtual bool has_writer (node_id id) const = 0;
+    virtual std::size_t queued_bytes (node_id id) = 0;
+    virtual double suspicion (node_id id) = 0;
     virtual void set_frame_size (node_id id, std::uint16_t frame_size) = 0  ;
+    virtual void set_queue_limits (writer_queue_limits const & limits) = 0;
+    virtual void set_forward_checksum_verification (bool enable) = 0;
+    virtual void set_heartbeat_suppression (bool enable) = 0;
     virtual unsigned int step () = 0;
     virtual void clear_channels () = 0;
 
@@ -65,11 +81,20 @@ public:
     virtual void on_duplicate_id (callback_t<void (peer_index_t, node_id, std::string const & host_addr)>) = 0;
     virtual void on_unreachable_received (callback_t<void (peer_index_t, node_id, unreachable_info<node_id> const &)>) = 0;
     virtual void on_route_received (callback_t<void (peer_index_t, node_id, bool, route_info<node_id> const &)>) = 0;
+    virtual void on_route_update_received (callback_t<void (peer_index_t, node_id
+        , std::vector<route_update_info<node_id>> const &
+        , std::vector<route_update_info<segment_id_t>> const &)>) = 0;
     virtual void on_domestic_data_received (callback_t<void (node_id, int, archive_type)>) = 0;
     virtual void on_global_data_received (callback_t<void (node_id /*last transmitter node*/
         , int /*priority*/, node_id /*sender ID*/, node_id /*receiver ID*/, archive_type)>) = 0;
     virtual void on_forward_global_packet (callback_t<void (int /*priority*/, node_id /*sender ID*/
         , node_id /*receiver ID*/, archive_type)>) = 0;
+    virtual void on_forward_global_multicast (callback_t<void (int /*priority*/, node_id /*sender ID*/
+        , std::vector<node_id> /*receivers*/, archive_type)>) = 0;
+    virtual void on_queue_high (callback_t<void (node_id, std::size_t /*bytes*/)>) = 0;
+    virtual void on_queue_low (callback_t<void (node_id, std::size_t /*bytes*/)>) = 0;
+    virtual void on_rtt_updated (callback_t<void (node_id, std::chrono::microseconds /*srtt*/
+        , std::chrono::microseconds /*rttvar*/)>) = 0;
 
     //
     // For internal use only
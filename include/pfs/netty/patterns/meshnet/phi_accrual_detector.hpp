@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.11 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace meshnet {
+
+/**
+ * Phi-accrual failure detector (N. Hayashibara et al.) with normal distribution of the heartbeat
+ * inter-arrival times.
+ *
+ * @details Suspicion level phi = -log10(1 - F(t - t_last)), where F is the cumulative distribution
+ *          function estimated over a sliding window of the inter-arrival times. The channel is
+ *          considered failed when phi reaches the threshold (8 by default, i.e. probability of
+ *          the mistake is 1e-8). Until enough samples collected and as the upper bound of the
+ *          detection time the fixed expiration timeout is used.
+ */
+class phi_accrual_detector
+{
+public:
+    using time_point_type = std::chrono::steady_clock::time_point;
+
+private:
+    static constexpr std::size_t WINDOW_SIZE = 100;
+    static constexpr std::size_t MIN_SAMPLES = 3;
+
+    std::chrono::steady_clock::duration _exp_timeout;
+    double _threshold {8};
+    time_point_type _last;
+
+    // Inter-arrival times (milliseconds)
+    std::deque<double> _samples;
+    double _sum {0};
+    double _sum_sq {0};
+
+public:
+    phi_accrual_detector (std::chrono::seconds exp_timeout, time_point_type now, double threshold = 8)
+        : _exp_timeout(exp_timeout)
+        , _threshold(threshold)
+        , _last(now)
+    {}
+
+public:
+    /**
+     * Registers heartbeat arrival and samples the inter-arrival time.
+     */
+    void heartbeat (time_point_type now)
+    {
+        auto sample = std::chrono::duration<double, std::milli>(now - _last).count();
+
+        _last = now;
+        _samples.push_back(sample);
+        _sum += sample;
+        _sum_sq += sample * sample;
+
+        if (_samples.size() > WINDOW_SIZE) {
+            auto x = _samples.front();
+            _samples.pop_front();
+            _sum -= x;
+            _sum_sq -= x * x;
+        }
+    }
+
+    /**
+     * Registers arrival of any other frame. Data frames are bursty, so they postpone the detection
+     * but are not sampled.
+     */
+    void refresh (time_point_type now) noexcept
+    {
+        _last = now;
+    }
+
+    /**
+     * Returns time point after which the channel is considered failed (phi exceeds threshold).
+     */
+    time_point_type deadline () const
+    {
+        auto upper_bound = _last + _exp_timeout;
+
+        if (_samples.size() < MIN_SAMPLES)
+            return upper_bound;
+
+        // Solve phi(t) = threshold, phi is monotonic
+        double lo = 0;
+        double hi = std::chrono::duration<double, std::milli>(_exp_timeout).count();
+
+        if (phi(hi) < _threshold)
+            return upper_bound;
+
+        for (int i = 0; i < 32; i++) {
+            auto mid = (lo + hi) / 2;
+
+            if (phi(mid) < _threshold)
+                lo = mid;
+            else
+                hi = mid;
+        }
+
+        return _last + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>{hi});
+    }
+
+    /**
+     * Returns suspicion level phi (channel is considered failed when it reaches the threshold).
+     */
+    double suspicion (time_point_type now) const
+    {
+        if (_samples.size() < MIN_SAMPLES) {
+            return now >= _last + _exp_timeout ? _threshold : 0;
+        }
+
+        return phi(std::chrono::duration<double, std::milli>(now - _last).count());
+    }
+
+    double threshold () const noexcept
+    {
+        return _threshold;
+    }
+
+private:
+    double mean () const noexcept
+    {
+        return _sum / _samples.size();
+    }
+
+    double stddev () const noexcept
+    {
+        auto m = mean();
+        auto variance = (std::max)(_sum_sq / _samples.size() - m * m, 0.0);
+
+        // Heartbeats on a stable link arrive almost periodically, so the deviation is bounded from
+        // below to tolerate short pauses.
+        return (std::max)(std::sqrt(variance), (std::max)(m * 0.1, 1.0));
+    }
+
+    /**
+     * Phi for @a elapsed milliseconds since the last arrival (logistic approximation of the normal
+     * distribution).
+     */
+    double phi (double elapsed) const
+    {
+        auto y = (elapsed - mean()) / stddev();
+        auto e = std::exp(-y * (1.5976 + 0.070566 * y * y));
+
+        if (elapsed > mean())
+            return -std::log10(e / (1 + e));
+
+        return -std::log10(1 - 1 / (1 + e));
+    }
+};
+
+} // namespace meshnet
+
+NETTY__NAMESPACE_END
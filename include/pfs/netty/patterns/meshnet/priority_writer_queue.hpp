@@ -8,14 +8,16 @@
 //      2025.02.04 It is a part of patterns::meshnet now.
 //      2025.09.08 Using chunk type.
 //      2025.11.17 `chunk` renamed to `buffer`.
+//      2026.05.12 Added limits and overflow policies.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "../../bounded_queue_pool.hpp"
+#include "../../writer_queue_limits.hpp"
 #include "priority_frame.hpp"
 #include <pfs/assert.hpp>
 #include <pfs/i18n.hpp>
 #include <array>
 #include <cstdint>
-#include <queue>
 #include <utility>
 #include <vector>
 
@@ -33,16 +35,16 @@ public:
 private:
     using priority_frame_type = priority_frame<PriorityTracker::SIZE, SerializerTraits>;
     using priority_tracker_type = PriorityTracker;
-    using chunk_queue_type = std::queue<archive_type>;
 
     static constexpr std::size_t PRIORITY_COUNT = PriorityTracker::SIZE;
 
     static_assert(PRIORITY_COUNT > 0, "Priority count must be at least 1");
 
+    using chunk_queue_pool_type = bounded_queue_pool<archive_type, PRIORITY_COUNT>;
+
 private:
-    std::array<chunk_queue_type, PRIORITY_COUNT> _qpool; // Chunks queue pool
+    chunk_queue_pool_type _qpool; // Chunks queue pool
     archive_type _frame; // Current sending frame
-    bool _empty {true};  // Used for optimization
     priority_tracker_type _priority_tracker;
 
 public:
@@ -59,30 +61,26 @@ private:
             return 0;
 
         auto priority = _priority_tracker.next();
-        auto pq = & _qpool.at(priority);
-        auto initial_pq = pq;
+        auto initial_priority = priority;
         int loops = 0;
 
-        while (pq->empty()) {
+        while (_qpool.empty(priority)) {
             priority = _priority_tracker.skip();
-            pq = & _qpool.at(priority);
 
             PFS__THROW_UNEXPECTED(loops <= PRIORITY_COUNT
                 , tr::f_("Fix meshnet::priority_writer_queue algorithm: loops({}) > PRIORITY_COUNT({})"
                     , loops, PRIORITY_COUNT));
 
             // The cycle is complete
-            if (pq == initial_pq)
+            if (priority == initial_priority)
                 break;
         }
 
-        if (pq->empty()) {
-            PFS__THROW_UNEXPECTED(pq == initial_pq
+        if (_qpool.empty(priority)) {
+            PFS__THROW_UNEXPECTED(priority == initial_priority
                 , tr::_("Fix meshnet::priority_writer_queue algorithm"));
 
-            for (auto const & q: _qpool) {
-                PFS__THROW_UNEXPECTED(q.empty(), tr::_("Fix meshnet::priority_writer_queue algorithm"));
-            }
+            PFS__THROW_UNEXPECTED(_qpool.empty(), tr::_("Fix meshnet::priority_writer_queue algorithm"));
 
             priority = -1;
         }
@@ -91,32 +89,56 @@ private:
     }
 
 public:
-    void enqueue (int priority, char const * data, std::size_t size)
+    writer_queue_limits const & limits () const noexcept
     {
-        if (size == 0)
-            return;
+        return _qpool.limits();
+    }
+
+    /**
+     * Sets queue limits.
+     */
+    void set_limits (writer_queue_limits const & limits)
+    {
+        _qpool.set_limits(limits);
+    }
 
+    /**
+     * Sets limits for the queue with specified @a priority overriding
+     * writer_queue_limits::max_priority_bytes and writer_queue_limits::max_priority_messages.
+     */
+    void set_priority_limits (int priority, std::size_t max_bytes, std::size_t max_messages)
+    {
         if (priority >= PRIORITY_COUNT)
             priority = PRIORITY_COUNT - 1;
 
-        auto & q = _qpool.at(priority);
+        _qpool.set_priority_limits(priority, max_bytes, max_messages);
+    }
 
-        q.push(archive_type{data, size});
-        _empty = false;
+    queue_occupancy occupancy () const noexcept
+    {
+        return _qpool.occupancy();
     }
 
-    void enqueue (int priority, archive_type data)
+    queue_occupancy enqueue (int priority, char const * data, std::size_t size)
     {
-        if (data.empty())
-            return;
+        if (size == 0)
+            return _qpool.occupancy();
 
         if (priority >= PRIORITY_COUNT)
             priority = PRIORITY_COUNT - 1;
 
-        auto & q = _qpool.at(priority);
+        return _qpool.push(priority, archive_type{data, size});
+    }
+
+    queue_occupancy enqueue (int priority, archive_type data)
+    {
+        if (data.empty())
+            return _qpool.occupancy();
+
+        if (priority >= PRIORITY_COUNT)
+            priority = PRIORITY_COUNT - 1;
 
-        q.push(std::move(data));
-        _empty = false;
+        return _qpool.push(priority, std::move(data));
     }
 
     archive_type acquire_frame (std::size_t frame_size)
@@ -126,7 +148,7 @@ public:
             return _frame;
         }
 
-        if (_empty) {
+        if (_qpool.empty()) {
             PFS__THROW_UNEXPECTED(_frame.empty(), "");
             return _frame; // _frame is empty here
         }
@@ -135,22 +157,15 @@ public:
 
         if (priority < 0) {
             PFS__THROW_UNEXPECTED(_frame.empty(), "");
-            _empty = true;
             return _frame; // _frame is empty here
         }
 
-        auto & q = _qpool.at(priority);
-        auto & front = q.front();
-
         PFS__THROW_UNEXPECTED(_frame.empty(), "");
-        PFS__THROW_UNEXPECTED(!front.empty(), "");
-
-        priority_frame_type::pack(priority, _frame, front, frame_size);
-
-        // Check topmost message is processed
-        if (front.empty())
-            q.pop();
 
+        _qpool.consume_front(priority, [this, priority, frame_size] (archive_type & front) {
+            PFS__THROW_UNEXPECTED(!front.empty(), "");
+            priority_frame_type::pack(priority, _frame, front, frame_size);
+        });
 
         return _frame;
     }
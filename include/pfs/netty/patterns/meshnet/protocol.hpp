@@ -3,16 +3,26 @@
 //
 // This file is part of `netty-lib`.
 //
-// Protocol Version 1
+// Protocol Version 2
 //
 // Changelog:
 //      2025.01.17 Initial version.
 //      2025.07.04 Changed protocol versioning.
 //      2025.12.14 Removed `alive_packet`.
 //      2026.07.16 Fixed `route_packet` (added `initiator_saddr` field to `route_info` struct).
+//      2026.06.01 Added timestamps to `heartbeat_packet` and link latencies to `route_packet`.
+//      2026.06.03 Added multicast variant of `gdata_packet`.
+//      2026.06.05 Added separate reading of `gdata_packet` routing fields and payload.
+//      2026.06.13 Added `route_update_packet`.
+//                 Added aggregated variant of `unreachable_packet`.
+//      2026.06.15 Added segment entries to `route_update_packet`.
+//      2026.06.27 Added heartbeat timestamps support flag to `handshake_packet`.
+//                 Protocol version 2 (aggregated `unreachable_packet`, `route_update_packet`).
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "route_info.hpp"
+#include "route_update_info.hpp"
+#include "segment_id.hpp"
 #include "unreachable_info.hpp"
 #include "../../error.hpp"
 #include "../../namespace.hpp"
@@ -36,6 +46,7 @@ enum class packet_enum
     , heartbeat =  2 /// Heartbeat loop packet (since version 1).
     , route     =  3 /// Route discovery packet (since version 1).
     , unreach   =  4 /// Route unreachable packet (since version 1).
+    , rupdate   =  5 /// Incremental route update packet (since version 2).
     , ddata     = 14 /// User data packet for exchange inside domestic subnet (domestic message) (since version 1).
     , gdata     = 15 /// User data packet for exchange bitween subnets using router nodes (global message) (since version 1).
 };
@@ -69,8 +80,8 @@ class header
 {
 public:
     // Using function avoids 'multiple definition' error prior to C++17.
-    // static constexpr int VERSION = 1;
-    static constexpr int VERSION () { return 1;}
+    // static constexpr int VERSION = 2;
+    static constexpr int VERSION () { return 2;}
 
 protected:
     struct {
@@ -219,6 +230,11 @@ protected:
 // handshake packet
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Bytes 2..9: Node ID
+//
+// F0 - response
+// F1 - sender is a gateway
+// F2 - sender is behind NAT
+// F3 - sender supports heartbeat timestamps (ignored by the nodes prior to this flag)
 
 template <typename NodeId>
 class handshake_packet: public header
@@ -241,6 +257,8 @@ public:
 
         if (behind_nat)
             enable_f2();
+
+        enable_f3();
     }
 
     /**
@@ -275,6 +293,14 @@ public:
         return is_f2();
     }
 
+    /**
+     * Checks if the sender accepts heartbeats with timestamps (see `heartbeat_packet`).
+     */
+    bool supports_timestamps () const noexcept
+    {
+        return is_f3();
+    }
+
     template <typename Serializer>
     void serialize (Serializer & out)
     {
@@ -287,9 +313,17 @@ public:
 // heartbeat packet
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Byte 3: Health data (unused yet)
+//
+// If F0 flag is set (has timestamps, sent only to the nodes supporting it, see `handshake_packet`):
+// Bytes 4..11 : Sender timestamp (microseconds, sender's monotonic clock)
+// Bytes 12..19: Echo timestamp (last timestamp received from the addressee, zero if none)
+// Bytes 20..23: Echo delay (microseconds elapsed since the echo timestamp receiving)
 class heartbeat_packet: public header
 {
     std::uint8_t _health_data {0};
+    std::uint64_t _timestamp {0};
+    std::uint64_t _echo_timestamp {0};
+    std::uint32_t _echo_delay {0};
 
 public:
     heartbeat_packet (std::uint8_t health_data) noexcept
@@ -297,6 +331,17 @@ public:
         , _health_data(health_data)
     {}
 
+    heartbeat_packet (std::uint8_t health_data, std::uint64_t timestamp
+        , std::uint64_t echo_timestamp, std::uint32_t echo_delay) noexcept
+        : header(packet_enum::heartbeat, false)
+        , _health_data(health_data)
+        , _timestamp(timestamp)
+        , _echo_timestamp(echo_timestamp)
+        , _echo_delay(echo_delay)
+    {
+        enable_f0();
+    }
+
     /**
      * Constructs heartbeat packet from deserializer with predefined header.
      * Header can be read before from the deserializer.
@@ -306,6 +351,9 @@ public:
         : header(h)
     {
         in >> _health_data;
+
+        if (has_timestamps())
+            in >> _timestamp >> _echo_timestamp >> _echo_delay;
     }
 
 public:
@@ -314,11 +362,34 @@ public:
         return _health_data;
     }
 
+    bool has_timestamps () const noexcept
+    {
+        return is_f0();
+    }
+
+    std::uint64_t timestamp () const noexcept
+    {
+        return _timestamp;
+    }
+
+    std::uint64_t echo_timestamp () const noexcept
+    {
+        return _echo_timestamp;
+    }
+
+    std::uint32_t echo_delay () const noexcept
+    {
+        return _echo_delay;
+    }
+
     template <typename Serializer>
     void serialize (Serializer & out)
     {
         header::serialize(out);
         out << _health_data;
+
+        if (has_timestamps())
+            out << _timestamp << _echo_timestamp << _echo_delay;
     }
 };
 
@@ -326,6 +397,12 @@ public:
 // unreachable packet
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Bytes 2..9  : Node ID of the gateway
+// Bytes 10..17: Node ID of the unreachable node
+// If F0 flag is set (aggregated packet) the gateway ID is followed by the generation (32-bit),
+// number of unreachable nodes (16-bit) and their IDs.
+//
+// NOTE. Only aggregated packets are sent (since version 2). Non-aggregated packets are still
+// accepted (as single ID with zero generation, not suppressed as duplicates).
 template <typename NodeId>
 class unreachable_packet: public header
 {
@@ -335,7 +412,9 @@ public:
     unreachable_packet (unreachable_info<NodeId> uinfo) noexcept
         : header(packet_enum::unreach, false)
         , _uinfo(std::move(uinfo))
-    {}
+    {
+        enable_f0();
+    }
 
     /**
      * Constructs packet from deserializer with predefined header.
@@ -345,7 +424,22 @@ public:
     unreachable_packet (header const & h, Deserializer & in)
         : header(h)
     {
-        in >> _uinfo.gw_id >> _uinfo.id;
+        in >> _uinfo.gw_id;
+
+        if (is_f0()) {
+            std::uint16_t count = 0;
+            in >> _uinfo.generation >> count;
+
+            for (int i = 0; i < static_cast<int>(count) && in.is_good(); i++) {
+                NodeId id {};
+                in >> id;
+                _uinfo.ids.push_back(id);
+            }
+        } else {
+            NodeId id {};
+            in >> id;
+            _uinfo.ids.push_back(id);
+        }
     }
 
 public:
@@ -358,7 +452,11 @@ public:
     void serialize (Serializer & out)
     {
         header::serialize(out);
-        out << _uinfo.gw_id << _uinfo.id;
+        out << _uinfo.gw_id << _uinfo.generation
+            << pfs::numeric_cast<std::uint16_t>(_uinfo.ids.size());
+
+        for (auto const & id: _uinfo.ids)
+            out << id;
     }
 };
 
@@ -367,6 +465,8 @@ public:
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Bytes 2..9  : Node ID of the initiator node
 // ...
+// If F1 flag is set (has latencies) the gateway chain is followed by the link latencies
+// (count and microseconds as 32-bit values).
 template <typename NodeId>
 class route_packet: public header
 {
@@ -379,6 +479,9 @@ public:
     {
         if (way == packet_way_enum::response)
             enable_f0();
+
+        if (!_rinfo.latencies.empty())
+            enable_f1();
     }
 
     template <typename Deserializer>
@@ -398,6 +501,16 @@ public:
             in >> id;
             _rinfo.route.push_back(id);
         }
+
+        if (is_f1()) {
+            in >> count;
+
+            for (int i = 0; i < static_cast<int>(count); i++) {
+                std::uint32_t latency = 0;
+                in >> latency;
+                _rinfo.latencies.push_back(latency);
+            }
+        }
     }
 
 public:
@@ -425,6 +538,93 @@ public:
 
         for (auto const & id: _rinfo.route)
             out << id;
+
+        if (is_f1()) {
+            out << pfs::numeric_cast<std::uint8_t>(_rinfo.latencies.size());
+
+            for (auto latency: _rinfo.latencies)
+                out << latency;
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// route update packet
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Bytes 2..3  : Number of entries
+// Entries     : destination node ID, hops (8-bit, 255 - unreachable) and sequence number (32-bit)
+//
+// If F1 flag is set (has segment entries) the entries are followed by the number of segment entries
+// (16-bit) and segment entries: segment ID (32-bit), hops and sequence number.
+template <typename NodeId>
+class route_update_packet: public header
+{
+    std::vector<route_update_info<NodeId>> _entries;
+    std::vector<route_update_info<segment_id_t>> _segment_entries;
+
+public:
+    route_update_packet (std::vector<route_update_info<NodeId>> entries
+        , std::vector<route_update_info<segment_id_t>> segment_entries = {}) noexcept
+        : header(packet_enum::rupdate, false)
+        , _entries(std::move(entries))
+        , _segment_entries(std::move(segment_entries))
+    {
+        if (!_segment_entries.empty())
+            enable_f1();
+    }
+
+    template <typename Deserializer>
+    route_update_packet (header const & h, Deserializer & in)
+        : header(h)
+    {
+        std::uint16_t count = 0;
+        in >> count;
+
+        for (int i = 0; i < static_cast<int>(count) && in.is_good(); i++) {
+            route_update_info<NodeId> entry;
+            in >> entry.dest_id >> entry.hops >> entry.seqno;
+            _entries.push_back(std::move(entry));
+        }
+
+        if (is_f1() && in.is_good()) {
+            count = 0;
+            in >> count;
+
+            for (int i = 0; i < static_cast<int>(count) && in.is_good(); i++) {
+                route_update_info<segment_id_t> entry;
+                in >> entry.dest_id >> entry.hops >> entry.seqno;
+                _segment_entries.push_back(std::move(entry));
+            }
+        }
+    }
+
+public:
+    std::vector<route_update_info<NodeId>> const & entries () const noexcept
+    {
+        return _entries;
+    }
+
+    std::vector<route_update_info<segment_id_t>> const & segment_entries () const noexcept
+    {
+        return _segment_entries;
+    }
+
+    template <typename Serializer>
+    void serialize (Serializer & out)
+    {
+        header::serialize(out);
+
+        out << pfs::numeric_cast<std::uint16_t>(_entries.size());
+
+        for (auto const & x: _entries)
+            out << x.dest_id << x.hops << x.seqno;
+
+        if (is_f1()) {
+            out << pfs::numeric_cast<std::uint16_t>(_segment_entries.size());
+
+            for (auto const & x: _segment_entries)
+                out << x.dest_id << x.hops << x.seqno;
+        }
     }
 };
 
@@ -478,11 +678,14 @@ public:
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // gdata packet
 ////////////////////////////////////////////////////////////////////////////////////////////////////
+// F0 - multicast packet: receiver set (16-bit counter followed by receiver IDs) instead of the single
+//      receiver ID.
 template <typename NodeId>
 class gdata_packet: public header
 {
     NodeId _sender_id;
     NodeId _receiver_id;
+    std::vector<NodeId> _receivers; // Multicast packet receivers
 
 public:
     gdata_packet (NodeId sender_id, NodeId receiver_id, bool has_checksum = true) noexcept
@@ -491,32 +694,81 @@ public:
         , _receiver_id(receiver_id)
     {}
 
+    /**
+     * Constructs multicast packet.
+     */
+    gdata_packet (NodeId sender_id, std::vector<NodeId> receivers, bool has_checksum = true)
+        : header(packet_enum::gdata, has_checksum)
+        , _sender_id(sender_id)
+        , _receiver_id()
+        , _receivers(std::move(receivers))
+    {
+        enable_f0();
+    }
+
+    /**
+     * Constructs packet from deserializer reading the routing fields (sender and receivers)
+     * only. Payload must be read by read_payload() or skipped by skip_payload() then.
+     */
+    template <typename Deserializer>
+    gdata_packet (header const & h, Deserializer & in)
+        : header(h)
+    {
+        in >> _sender_id;
+
+        if (is_multicast()) {
+            std::uint16_t count = 0;
+            in >> count;
+
+            if (!in.is_good())
+                return;
+
+            _receivers.reserve(count);
+
+            for (int i = 0; i < static_cast<int>(count); i++) {
+                NodeId id;
+                in >> id;
+                _receivers.push_back(id);
+            }
+        } else {
+            in >> _receiver_id;
+        }
+    }
+
     template <typename Deserializer, typename Archive>
     gdata_packet (header const & h, Deserializer & in, Archive & ar)
-        : header(h)
+        : gdata_packet(h, in)
     {
-        in >> _sender_id >> _receiver_id;
+        read_payload(in, ar);
+    }
 
+    /**
+     * Reads payload into @a ar and verifies its checksum.
+     */
+    template <typename Deserializer, typename Archive>
+    void read_payload (Deserializer & in, Archive & ar)
+    {
         if (!in.is_good())
             return;
 
         // _h.length already has been read before
         in.read(ar, _h.length);
 
-        if (in.is_good()) {
-            if (has_checksum()) {
-                auto crc32 = pfs::crc32_of_ptr(ar.data(), ar.size());
+        if (in.is_good())
+            verify_checksum(ar.data(), ar.size());
+    }
 
-                if (crc32 != _h.crc32) {
-                    throw error {
-                        make_error_code(netty::errc::checksum_error)
-                        , tr::f_("bad CRC32 checksum for gdata_packet: expected 0x{:0X}, got 0x{:0X}"
-                            ", data size: {} bytes"
-                            , _h.crc32, crc32, ar.size())
-                    };
-                }
-            }
-        }
+    /**
+     * Skips payload without copying. Checksum is verified if @a verify is @c true.
+     */
+    template <typename Deserializer>
+    void skip_payload (Deserializer & in, bool verify)
+    {
+        // Payload is complete
+        if (verify && in.is_good() && in.available() >= _h.length)
+            verify_checksum(in.peek(), _h.length);
+
+        in.skip(_h.length);
     }
 
 public:
@@ -530,6 +782,19 @@ public:
         return _receiver_id;
     }
 
+    bool is_multicast () const noexcept
+    {
+        return is_f0();
+    }
+
+    /**
+     * Returns receivers of the multicast packet.
+     */
+    std::vector<NodeId> const & receivers () const noexcept
+    {
+        return _receivers;
+    }
+
     template <typename Serializer>
     void serialize (Serializer & out, char const * data, std::size_t len)
     {
@@ -539,9 +804,37 @@ public:
         _h.length = pfs::numeric_cast<decltype(_h.length)>(len);
 
         header::serialize(out);
-        out << _sender_id << _receiver_id;
+        out << _sender_id;
+
+        if (is_multicast()) {
+            out << pfs::numeric_cast<std::uint16_t>(_receivers.size());
+
+            for (auto const & id: _receivers)
+                out << id;
+        } else {
+            out << _receiver_id;
+        }
+
         out.write(data, len);
     }
+
+private:
+    void verify_checksum (char const * data, std::size_t len) const
+    {
+        if (!has_checksum())
+            return;
+
+        auto crc32 = pfs::crc32_of_ptr(data, len);
+
+        if (crc32 != _h.crc32) {
+            throw error {
+                make_error_code(netty::errc::checksum_error)
+                , tr::f_("bad CRC32 checksum for gdata_packet: expected 0x{:0X}, got 0x{:0X}"
+                    ", data size: {} bytes"
+                    , _h.crc32, crc32, len)
+            };
+        }
+    }
 };
 
 } // namespace meshnet
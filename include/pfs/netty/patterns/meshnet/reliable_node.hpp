@@ -7,6 +7,7 @@
 //      2025.05.06 Initial version (`reliable_node.cpp`).
 //      2025.12.18 Renamed to `reliable_node.hpp`.
 //                 `reliable_node` renamed to `reliable_node`.
+//      2026.06.25 Added method `congestion()`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
@@ -373,6 +374,15 @@ public:
         return _dm.enqueue_report(id, priority, std::move(data));
     }
 
+    /**
+     * Returns current congestion window and round-trip time estimation of the exchange with the
+     * node @a id.
+     */
+    auto congestion (node_id id) -> decltype(_dm.congestion(id))
+    {
+        return _dm.congestion(id);
+    }
+
     void interrupt ()
     {
         _t.interrupt();
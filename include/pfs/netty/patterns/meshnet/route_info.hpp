@@ -6,6 +6,7 @@
 // Changelog:
 //      2025.03.04 Initial version.
 //      2026.07.16 Added session_id `sid` field to `route_info` struct.
+//      2026.06.01 Added `latencies` field.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
@@ -29,6 +30,11 @@ struct route_info
     NodeId responder_id; // Used by response only
     std::vector<NodeId> route; // Gateways chain
 
+    // Link latencies (microseconds, zero if unknown) along the chain: element `i` is the latency
+    // of the link between the gateway `i` and the previous one (or initiator for the first
+    // gateway). Last element of the response is the latency of the link to the responder.
+    std::vector<std::uint32_t> latencies;
+
 public:
     /**
      * Find gateway index in the route.
@@ -42,6 +48,19 @@ public:
 
         return pfs::nullopt;
     }
+
+    /**
+     * Returns sum of link latencies starting from index @a first.
+     */
+    std::uint64_t latency (std::size_t first = 0) const
+    {
+        std::uint64_t result = 0;
+
+        for (std::size_t i = first; i < latencies.size(); i++)
+            result += latencies[i];
+
+        return result;
+    }
 };
 
 } // namespace meshnet
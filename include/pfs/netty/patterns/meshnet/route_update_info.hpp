@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.13 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include <cstdint>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace meshnet {
+
+/**
+ * Entry of the incremental (distance-vector) route update.
+ */
+template <typename NodeId>
+struct route_update_info
+{
+    // Using function avoids 'multiple definition' error prior to C++17.
+    static constexpr std::uint8_t UNREACHABLE () { return 0xFF; }
+
+    NodeId dest_id;           // destination node ID
+    std::uint8_t hops {0};    // number of gateways to the destination or UNREACHABLE()
+    std::uint32_t seqno {0};  // sequence number originated by the destination node (odd for
+                              // the unreachable destination)
+};
+
+} // namespace meshnet
+
+NETTY__NAMESPACE_END
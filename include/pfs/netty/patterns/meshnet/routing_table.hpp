@@ -5,19 +5,36 @@
 //
 // Changelog:
 //      2025.02.24 Initial version.
+//      2026.05.26 Added next hop cache.
+//      2026.05.28 Added reverse index from node to routes and gateway chain index.
+//      2026.05.30 Added multipath routing.
+//      2026.06.01 Added latency-aware route metric.
+//      2026.06.13 Added routes learned by incremental (distance-vector) updates.
+//      2026.06.15 Added segment routes (hierarchical routing).
+//      2026.06.17 Node IDs are interned into dense local indices.
+//      2026.06.19 Added routing snapshot (warm start) with provisional routes.
+//      2026.06.27 Multipath candidates respect latency route metric.
+//                 Link latencies are added to route packets with latency route metric only.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../error.hpp"
 #include "../../namespace.hpp"
+#include "compact_chain.hpp"
+#include "distance_vector.hpp"
+#include "local_id.hpp"
 #include "protocol.hpp"
 #include "route_info.hpp"
+#include "route_update_info.hpp"
+#include "segment_id.hpp"
 #include <pfs/i18n.hpp>
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <set>
 #include <stdexcept>
 #include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -34,7 +51,16 @@ namespace meshnet {
 //      |   c---|           +---D2
 // A3---+       +---C1
 //
-// Sibling nodes (std::unordered_set) for node A0
+// Node IDs are interned into dense local indices (node_interner) when passed to the routing
+// table. All structures below store local indices, so lookups use flat vectors indexed by local ID
+// and hashing/comparison of the 32-bit values instead of the full node IDs.
+//
+// Node states (std::vector) - indexed by local ID: sibling flag, link latency, indices of gateway
+// chains of the routes to the node (route map), indices of gateway chains containing the node
+// (used to find routes affected by the node unreachability without full scan), next hop cache and
+// selected route (latency metric only).
+//
+// Sibling nodes (std::vector) for node A0
 // +----+----+----+
 // | A1 | A2 | A3 |
 // +----+----+----+
@@ -45,7 +71,7 @@ namespace meshnet {
 // | a |
 // +---+
 //
-// Gateway chains (std::vector) for node A0
+// Gateway chains (std::vector of compact_chain, stored inline for short chains) for node A0
 //   +---+
 // 0 | a |
 //   +---+---+
@@ -56,7 +82,7 @@ namespace meshnet {
 // 3 | a | d |
 //   +---+---+
 //
-// Route map (std::unordered_multimap) - mapping destination node to index of gateway chains.
+// Route map (node states) - mapping destination node to indices of gateway chains.
 // +----+---+
 // | b  | 0 |
 // +----+---+
@@ -74,12 +100,100 @@ namespace meshnet {
 // +----+---+
 // | D2 | 3 |
 // +----+---+
+//
+// Chain destinations (std::vector) - destination nodes (with route counters) of the routes using
+// gateway chain (by index).
+//
+// Chain index (std::unordered_multimap) - mapping gateway chain hash to its index.
+//
+// Next hop cache (node states) - first gateway of the optimal route (or the node itself for
+// sibling node). Filled by gateway_for() and invalidated incrementally by the destination node
+// when its routes are changed.
+//
+// Incremental routes (distance_vector) - mapping destination node to the next hop, metric
+// (number of gateways) and sequence number learned by incremental (distance-vector) updates. Used
+// when no sibling or gateway chain route found.
+//
+// Segment routes (distance_vector) - mapping remote segment to the next hop toward the border
+// gateway of the segment. Used by hierarchical routing when no route to the node itself found.
+//
+// Provisional routes - routes imported from the snapshot (warm start). Provisional route is used
+// only while its first gateway is a sibling node and preference is given to confirmed routes. The
+// route is confirmed when it is discovered again and removed by remove_provisional_routes()
+// otherwise.
+
+/**
+ * Multipath mode for the intersegment (global) data.
+ */
+enum class multipath_mode
+{
+      disabled    // Always use the route with minimum hops
+    , per_flow    // Route is selected by the flow (sender, receiver, priority) hash, preserves ordering
+    , per_message // Route with the least loaded first gateway is selected for each message
+};
+
+/**
+ * Route usage counters.
+ */
+struct route_counters
+{
+    std::uint64_t messages {0};
+    std::uint64_t bytes {0};
+};
+
+/**
+ * Route metric used to select the optimal route.
+ */
+enum class route_metric
+{
+      hops    // Route with minimum hops
+    , latency // Route with minimum expected latency (sum of the link latencies)
+};
+
+/**
+ * Route propagation mode.
+ */
+enum class route_propagation
+{
+      discovery   // Route discovery by flooding route requests with full gateway chains
+    , incremental // Distance-vector updates with changed reachability only (must be set on all nodes)
+};
 
 template <typename NodeId, typename SerializerTraits>
 class routing_table
 {
     using node_id = NodeId;
-    using route_map_type = std::unordered_multimap<node_id, std::size_t>;
+
+    struct route_state
+    {
+        route_counters counters;
+
+        // Latency of the route excluding the first hop (microseconds)
+        std::uint64_t tail_latency {0};
+
+        // Route imported from the snapshot and not confirmed yet
+        bool provisional {false};
+    };
+
+    struct node_state
+    {
+        bool is_sibling {false};
+
+        // Measured link latency (microseconds)
+        std::uint32_t link_latency {0};
+
+        // Indices of gateway chains of the routes to the node
+        std::vector<std::size_t> routes;
+
+        // Indices of gateway chains containing the node
+        std::vector<std::size_t> chains;
+
+        // Next hop (gateway) cache
+        mutable local_id_t next_hop {INVALID_LOCAL_ID};
+
+        // Currently selected gateway chain index (latency metric only)
+        mutable pfs::optional<std::size_t> selected;
+    };
 
 public:
     using serializer_traits_type = SerializerTraits;
@@ -88,12 +202,49 @@ public:
     using gateway_chain_type = std::vector<node_id>;
 
 private:
-    std::unordered_set<node_id> _sibling_nodes;
-    std::vector<node_id> _sibling_gateways;
-    std::vector<gateway_chain_type> _gateway_chains;
+    // Using function avoids 'multiple definition' error prior to C++17.
+    static constexpr std::uint8_t SNAPSHOT_VERSION () { return 1; }
+
+private:
+    node_interner<node_id> _interner;
+
+    // Local ID -> node state
+    std::vector<node_state> _nodes;
+
+    std::vector<local_id_t> _sibling_nodes;
+    std::vector<local_id_t> _sibling_gateways;
+    std::vector<compact_chain> _gateway_chains;
+
+    // Gateway chain index -> destination nodes routed through the chain.
+    std::vector<std::unordered_map<local_id_t, route_state>> _chain_dests;
+
+    // Gateway chain hash -> gateway chain index.
+    std::unordered_multimap<std::size_t, std::size_t> _chain_index;
+
+    multipath_mode _multipath {multipath_mode::disabled};
+
+    // Maximum difference in hops with the optimal route for the alternative route
+    std::size_t _multipath_extra_hops {0};
+
+    // Candidate routes buffer for select_gateway()
+    std::vector<std::size_t> _candidates;
+
+    route_metric _metric {route_metric::hops};
+
+    // Current route should be worse than the best one by this percentage to be replaced
+    unsigned int _hysteresis_percent {20};
+
+    // Latency used for links with unknown latency (microseconds)
+    std::uint32_t _default_link_latency {1000};
+
+    // Destination node -> route learned by incremental updates
+    distance_vector<local_id_t, local_id_t> _incremental_routes;
 
-    // Used to determine the route to send message.
-    route_map_type _route_map;
+    // Remote segment -> route to the segment border gateway
+    distance_vector<segment_id_t, local_id_t> _segment_routes;
+
+    // True if provisional routes (not confirmed yet) exist
+    bool _has_provisional {false};
 
 public:
     routing_table () = default;
@@ -117,13 +268,15 @@ public:
      */
     bool add_sibling_gateway (node_id gwid)
     {
+        auto lid = intern(gwid);
+
         // Check if already exists
-        for (auto const & x: _sibling_gateways) {
-            if (x == gwid)
+        for (auto x: _sibling_gateways) {
+            if (x == lid)
                 return false;
         }
 
-        _sibling_gateways.push_back(gwid);
+        _sibling_gateways.push_back(lid);
         return true;
     }
 
@@ -134,16 +287,46 @@ public:
      */
     bool add_sibling (node_id id)
     {
+        auto lid = intern(id);
+
         // Remove all non-direct routes between sibling nodes
-        _route_map.erase(id);
+        erase_routes_to(lid);
+        _nodes[lid].next_hop = INVALID_LOCAL_ID;
+
+        // Provisional routes through the node become usable
+        if (_has_provisional) {
+            for (auto index: _nodes[lid].chains) {
+                if (_gateway_chains[index][0] == lid) {
+                    for (auto const & x: _chain_dests[index])
+                        _nodes[x.first].next_hop = INVALID_LOCAL_ID;
+                }
+            }
+        }
+
+        if (_nodes[lid].is_sibling)
+            return false;
 
-        auto res = _sibling_nodes.insert(id);
-        return res.second;
+        _nodes[lid].is_sibling = true;
+        _sibling_nodes.push_back(lid);
+        return true;
     }
 
     void remove_sibling (node_id id)
     {
-        _sibling_nodes.erase(id);
+        auto lid = local_id_of(id);
+
+        if (lid == INVALID_LOCAL_ID)
+            return;
+
+        auto & n = _nodes[lid];
+
+        if (n.is_sibling) {
+            n.is_sibling = false;
+            _sibling_nodes.erase(std::find(_sibling_nodes.begin(), _sibling_nodes.end(), lid));
+        }
+
+        n.next_hop = INVALID_LOCAL_ID;
+        n.link_latency = 0;
     }
 
     /**
@@ -159,12 +342,12 @@ public:
         if (is_sibling(dest))
             return std::make_pair(std::size_t{0}, false);
 
-        if (reverse_order) {
-            auto reversed_gw_chain = reverse_gateway_chain(gw_chain);
-            return add_route_helper(dest, std::move(reversed_gw_chain));
-        }
+        auto lid = intern(dest);
 
-        return add_route_helper(dest, gw_chain);
+        if (reverse_order)
+            return add_route_helper(lid, make_chain(gw_chain.crbegin(), gw_chain.crend()));
+
+        return add_route_helper(lid, make_chain(gw_chain.cbegin(), gw_chain.cend()));
     }
 
     /**
@@ -178,26 +361,36 @@ public:
         if (is_sibling(dest))
             return std::make_pair(std::size_t{0}, false);
 
+        auto lid = intern(dest);
+
         if (reverse_order) {
-            auto reversed_gw_chain = reverse_gateway_chain(gw_chain);
-            auto pos = std::find(reversed_gw_chain.cbegin(), reversed_gw_chain.cend(), gw);
+            auto pos = std::find(gw_chain.crbegin(), gw_chain.crend(), gw);
 
-            PFS__THROW_UNEXPECTED(pos != reversed_gw_chain.cend(), "Fix meshnet::routing_table algorithm");
+            PFS__THROW_UNEXPECTED(pos != gw_chain.crend(), "Fix meshnet::routing_table algorithm");
 
-            return add_route_helper(dest, gateway_chain_type(++pos, reversed_gw_chain.cend()));
+            return add_route_helper(lid, make_chain(++pos, gw_chain.crend()));
         }
 
         auto pos = std::find(gw_chain.cbegin(), gw_chain.cend(), gw);
 
         PFS__THROW_UNEXPECTED(pos != gw_chain.cend(), "Fix meshnet::routing_table algorithm");
 
-        return add_route_helper(dest, gateway_chain_type(++pos, gw_chain.cend()));
+        return add_route_helper(lid, make_chain(++pos, gw_chain.cend()));
     }
 
     bool is_reachable (node_id dest_id) const
     {
-        return !(_sibling_nodes.find(dest_id) == _sibling_nodes.end()
-            && _route_map.find(dest_id) == _route_map.end());
+        auto lid = local_id_of(dest_id);
+        return lid != INVALID_LOCAL_ID && is_reachable(lid);
+    }
+
+    bool is_sibling_gateway (node_id id) const
+    {
+        auto lid = local_id_of(id);
+
+        return lid != INVALID_LOCAL_ID
+            && std::find(_sibling_gateways.begin(), _sibling_gateways.end(), lid)
+                != _sibling_gateways.end();
     }
 
     /**
@@ -215,7 +408,7 @@ public:
         , OnNodeUnreachableCb && on_node_unreachable_cb)
     {
         std::size_t n = 0;
-        std::set<node_id> candidate_unreachable_nodes;
+        std::set<local_id_t> candidate_unreachable_nodes;
 
         // Called from channel destroyed callback (see node::_on_channel_destroyed)
         if (gw_id == node_id{}) {
@@ -223,33 +416,60 @@ public:
 
             remove_sibling(dest_id);
             on_route_lost_cb(dest_id, 0);
-            candidate_unreachable_nodes.insert(dest_id);
+            candidate_unreachable_nodes.insert(local_id_of(dest_id));
 
             ++n;
         }
 
-        for (auto pos = _route_map.cbegin(); pos != _route_map.cend();) {
-            auto const & route = _gateway_chains[pos->second];
-            auto found = dest_id == pos->first
-                ? true // `dest_id` is a terminal node of the route.
-                // Check if `dest_id` is a gateway in the chain.
-                : std::find(route.cbegin(), route.cend(), dest_id) != route.cend();
-
-            if (found) {
-                auto id = pos->first;
-                auto index = pos->second;
-                pos = _route_map.erase(pos);
-                on_route_lost_cb(id, index + 1);
-                candidate_unreachable_nodes.insert(id);
-                ++n;
-            } else {
-                ++pos;
+        auto lid = local_id_of(dest_id);
+
+        if (lid == INVALID_LOCAL_ID)
+            return n;
+
+        auto route_lost = [&] (local_id_t id, std::size_t index) {
+            _nodes[id].next_hop = INVALID_LOCAL_ID;
+            _nodes[id].selected = pfs::nullopt;
+            on_route_lost_cb(node_id_of(id), index + 1);
+            candidate_unreachable_nodes.insert(id);
+            ++n;
+        };
+
+        // `dest_id` is a terminal node of the route.
+        if (!_nodes[lid].routes.empty()) {
+            std::vector<std::size_t> indices;
+            indices.swap(_nodes[lid].routes);
+
+            for (auto index: indices)
+                _chain_dests[index].erase(lid);
+
+            for (auto index: indices)
+                route_lost(lid, index);
+        }
+
+        // `dest_id` is a gateway in the chain.
+        for (auto index: _nodes[lid].chains) {
+            auto & dests = _chain_dests[index];
+
+            if (dests.empty())
+                continue;
+
+            std::vector<local_id_t> ids;
+            ids.reserve(dests.size());
+
+            for (auto const & x: dests)
+                ids.push_back(x.first);
+
+            dests.clear();
+
+            for (auto id: ids) {
+                erase_route(id, index);
+                route_lost(id, index);
             }
         }
 
-        for (auto const & x: candidate_unreachable_nodes) {
+        for (auto x: candidate_unreachable_nodes) {
             if (!is_reachable(x))
-                on_node_unreachable_cb(x);
+                on_node_unreachable_cb(node_id_of(x));
         }
 
         return n;
@@ -263,8 +483,8 @@ public:
     template <typename F>
     void foreach_sibling_gateway (F && f) const
     {
-        for (auto const & gw_id: _sibling_gateways)
-            f(gw_id);
+        for (auto lid: _sibling_gateways)
+            f(node_id_of(lid));
     }
 
     /**
@@ -275,8 +495,8 @@ public:
     template <typename F>
     void foreach_sibling_node (F && f) const
     {
-        for (auto const & x: _sibling_nodes)
-            f(x);
+        for (auto lid: _sibling_nodes)
+            f(node_id_of(lid));
     }
 
     /**
@@ -287,34 +507,281 @@ public:
     template <typename F>
     void foreach_route (F && f) const
     {
-        for (auto const & x: _sibling_nodes)
-            f(x, gateway_chain_type{x});
+        for (auto lid: _sibling_nodes)
+            f(node_id_of(lid), gateway_chain_type{node_id_of(lid)});
 
-        for (auto const & x: _route_map) {
-            auto index = x.second;
-            f(x.first, _gateway_chains.at(index));
+        for (std::size_t lid = 0; lid < _nodes.size(); lid++) {
+            for (auto index: _nodes[lid].routes)
+                f(node_id_of(static_cast<local_id_t>(lid)), to_gateway_chain(_gateway_chains[index]));
         }
+
+        _incremental_routes.foreach_route([this, & f] (local_id_t dest, local_id_t next_hop) {
+            if (!_nodes[dest].is_sibling)
+                f(node_id_of(dest), gateway_chain_type{node_id_of(next_hop)});
+        });
     }
 
     /**
      * Searches gateway for destination node @a id.
      *
      * @details Preference is given to a route with a low value of hops and its reachability.
+     *          Result is cached until the routes to the node @a id are changed.
      */
     pfs::optional<node_id> gateway_for (node_id id) const
     {
-        if (is_sibling(id))
+        auto lid = local_id_of(id);
+
+        if (lid == INVALID_LOCAL_ID)
+            return pfs::nullopt;
+
+        auto & n = _nodes[lid];
+
+        if (n.next_hop != INVALID_LOCAL_ID)
+            return node_id_of(n.next_hop);
+
+        if (n.is_sibling) {
+            n.next_hop = lid;
             return id;
+        }
 
-        auto res = find_optimal_route_for(id);
+        auto res = _metric == route_metric::latency
+            ? find_fastest_route_for(lid)
+            : find_optimal_route_for(lid);
 
-        if (!res.first)
-            return pfs::nullopt;
+        if (!res.first) {
+            auto next_hop = _incremental_routes.next_hop(lid);
 
-        auto & gw_chain = _gateway_chains.at(res.second);
+            if (!next_hop)
+                return pfs::nullopt;
 
-        // Return first gateway in the chain
-        return gw_chain[0];
+            n.next_hop = *next_hop;
+            return node_id_of(*next_hop);
+        }
+
+        // First gateway in the chain
+        n.next_hop = _gateway_chains[res.second][0];
+        return node_id_of(n.next_hop);
+    }
+
+    multipath_mode multipath () const noexcept
+    {
+        return _multipath;
+    }
+
+    /**
+     * Sets multipath @a mode. Alternative routes differ from the optimal one by no more than
+     * @a max_extra_hops hops (zero means equal-cost routes only).
+     *
+     * @note With route_metric::latency alternative routes are the routes which expected latency
+     *       exceeds the latency of the selected route by no more than hysteresis percent
+     *       (see set_route_metric()), @a max_extra_hops is not used.
+     */
+    void set_multipath (multipath_mode mode, std::size_t max_extra_hops = 0)
+    {
+        _multipath = mode;
+        _multipath_extra_hops = max_extra_hops;
+    }
+
+    /**
+     * Selects gateway for destination node @a id according to multipath mode and updates
+     * counters of the selected route.
+     *
+     * @param flow_hash Flow hash (used in multipath_mode::per_flow mode).
+     * @param size Message size.
+     * @param load Invokable object with signature std::size_t (node_id gw_id) returning current
+     *        load (e.g. number of queued bytes) of the sibling gateway.
+     * @param extra_hops_allowed Alternative routes with more hops than optimal route are
+     *        allowed (for originated messages only to prevent forwarding loops). With
+     *        route_metric::latency forwarded messages use routes no longer than the selected one.
+     */
+    template <typename LoadFn>
+    pfs::optional<node_id> select_gateway (node_id id, std::size_t flow_hash, std::size_t size
+        , LoadFn && load, bool extra_hops_allowed = true)
+    {
+        if (_multipath == multipath_mode::disabled || is_sibling(id))
+            return gateway_for(id);
+
+        auto lid = local_id_of(id);
+
+        // Incremental route only (if any)
+        if (lid == INVALID_LOCAL_ID || _nodes[lid].routes.empty())
+            return gateway_for(id);
+
+        // Routes are ordered by the time of adding
+        auto const & routes = _nodes[lid].routes;
+        auto & candidates = _candidates;
+
+        candidates.clear();
+
+        if (_metric == route_metric::latency) {
+            auto res = find_fastest_route_for(lid);
+
+            // Unusable provisional routes only
+            if (!res.first)
+                return gateway_for(id);
+
+            auto max_latency = route_latency(lid, res.second) * (100 + _hysteresis_percent) / 100;
+            auto max_hops = extra_hops_allowed
+                ? std::numeric_limits<std::size_t>::max()
+                : _gateway_chains[res.second].size();
+
+            for (auto index: routes) {
+                if (_gateway_chains[index].size() <= max_hops && is_usable(lid, index)
+                        && route_latency(lid, index) <= max_latency) {
+                    candidates.push_back(index);
+                }
+            }
+        } else {
+            auto min_hops = std::numeric_limits<std::size_t>::max();
+
+            for (auto index: routes) {
+                if (is_usable(lid, index))
+                    min_hops = (std::min)(min_hops, _gateway_chains[index].size());
+            }
+
+            // Unusable provisional routes only
+            if (min_hops == std::numeric_limits<std::size_t>::max())
+                return gateway_for(id);
+
+            auto max_hops = min_hops + (extra_hops_allowed ? _multipath_extra_hops : 0);
+
+            for (auto index: routes) {
+                if (_gateway_chains[index].size() <= max_hops && is_usable(lid, index))
+                    candidates.push_back(index);
+            }
+        }
+
+        auto index = candidates[0];
+
+        if (candidates.size() > 1) {
+            if (_multipath == multipath_mode::per_flow) {
+                index = candidates[flow_hash % candidates.size()];
+            } else {
+                // Least loaded first gateway, the least used route on tie.
+                auto min_load = std::numeric_limits<std::size_t>::max();
+                auto min_messages = std::numeric_limits<std::uint64_t>::max();
+
+                for (auto i: candidates) {
+                    auto l = load(node_id_of(_gateway_chains[i][0]));
+                    auto m = _chain_dests[i][lid].counters.messages;
+
+                    if (l < min_load || (l == min_load && m < min_messages)) {
+                        min_load = l;
+                        min_messages = m;
+                        index = i;
+                    }
+                }
+            }
+        }
+
+        auto & counters = _chain_dests[index][lid].counters;
+        counters.messages++;
+        counters.bytes += size;
+
+        return node_id_of(_gateway_chains[index][0]);
+    }
+
+    /**
+     * Iterates over all routes (excluding sibling nodes) with their usage counters (updated by
+     * select_gateway() only).
+     *
+     * @param f Invokable object with signature
+     *        void (node_id dest, std::size_t route_index, route_counters const &).
+     */
+    template <typename F>
+    void foreach_route_counters (F && f) const
+    {
+        for (std::size_t i = 0; i < _chain_dests.size(); i++) {
+            for (auto const & x: _chain_dests[i])
+                f(node_id_of(x.first), i + 1, x.second.counters);
+        }
+    }
+
+    route_metric metric () const noexcept
+    {
+        return _metric;
+    }
+
+    /**
+     * Sets route @a metric. With route_metric::latency the selected route is replaced only if
+     * the expected latency of the best route is less by more than @a hysteresis_percent percent
+     * (prevents route flapping due to the latency jitter).
+     */
+    void set_route_metric (route_metric metric, unsigned int hysteresis_percent = 20)
+    {
+        _metric = metric;
+        _hysteresis_percent = hysteresis_percent;
+
+        for (auto & n: _nodes) {
+            n.next_hop = INVALID_LOCAL_ID;
+            n.selected = pfs::nullopt;
+        }
+    }
+
+    /**
+     * Sets latency used for links with unknown latency.
+     */
+    void set_default_link_latency (std::chrono::microseconds latency)
+    {
+        _default_link_latency = clamp_latency(latency.count());
+
+        if (_metric == route_metric::latency)
+            clear_next_hops();
+    }
+
+    /**
+     * Sets measured latency of the link to the sibling node @a id (e.g. half of the smoothed
+     * round-trip time).
+     */
+    void set_link_latency (node_id id, std::chrono::microseconds latency)
+    {
+        _nodes[intern(id)].link_latency = clamp_latency(latency.count());
+
+        if (_metric == route_metric::latency)
+            clear_next_hops();
+    }
+
+    /**
+     * Returns measured latency (microseconds) of the link to the sibling node @a id or zero if
+     * latency is unknown.
+     */
+    std::uint32_t link_latency (node_id id) const
+    {
+        auto lid = local_id_of(id);
+        return lid == INVALID_LOCAL_ID ? 0 : _nodes[lid].link_latency;
+    }
+
+    /**
+     * Sets latencies of the links of the route to @a dest_id by gateway chain @a index (as
+     * returned by add_route/add_subroute) excluding the first hop. Missing or zero values are
+     * replaced by the default link latency.
+     */
+    void set_route_latency (node_id dest_id, std::size_t index
+        , std::vector<std::uint32_t> const & tail)
+    {
+        auto lid = local_id_of(dest_id);
+
+        if (lid == INVALID_LOCAL_ID || index == 0 || index > _chain_dests.size())
+            return;
+
+        auto pos = _chain_dests[index - 1].find(lid);
+
+        if (pos == _chain_dests[index - 1].end())
+            return;
+
+        // Number of links excluding the first hop is equal to the number of gateways
+        auto count = _gateway_chains[index - 1].size();
+        std::uint64_t latency = 0;
+
+        for (std::size_t i = 0; i < count; i++) {
+            auto l = i < tail.size() ? tail[i] : 0;
+            latency += l > 0 ? l : _default_link_latency;
+        }
+
+        pos->second.tail_latency = latency;
+
+        if (_metric == route_metric::latency)
+            _nodes[lid].next_hop = INVALID_LOCAL_ID;
     }
 
     /**
@@ -352,7 +819,341 @@ public:
             };
         }
 
-        return _gateway_chains[index - 1];
+        return to_gateway_chain(_gateway_chains[index - 1]);
+    }
+
+    /**
+     * Processes incremental route update @a u received from the sibling node @a neighbor_id.
+     *
+     * @details Regular nodes advertise themselves only, so other entries received from them are
+     *          ignored.
+     */
+    route_update_result update_route (node_id neighbor_id, bool neighbor_is_gateway
+        , route_update_info<node_id> const & u)
+    {
+        if (!neighbor_is_gateway && u.dest_id != neighbor_id)
+            return route_update_result::ignored;
+
+        std::uint8_t hops = u.dest_id == neighbor_id
+            ? std::uint8_t{0}
+            : distance_vector<local_id_t, local_id_t>::next_hops(u.hops);
+
+        auto dest = intern(u.dest_id);
+        auto res = _incremental_routes.update(dest, intern(neighbor_id), hops, u.seqno);
+
+        if (res == route_update_result::ignored)
+            return res;
+
+        _nodes[dest].next_hop = INVALID_LOCAL_ID;
+
+        return _nodes[dest].is_sibling ? route_update_result::updated : res;
+    }
+
+    /**
+     * Marks incremental routes through the sibling node @a neighbor_id as unreachable (with odd
+     * sequence number) and calls @a f for each affected destination.
+     *
+     * @param f Invokable object with signature void (node_id dest_id).
+     */
+    template <typename F>
+    void invalidate_routes_via (node_id neighbor_id, F && f)
+    {
+        auto lid = local_id_of(neighbor_id);
+
+        if (lid == INVALID_LOCAL_ID)
+            return;
+
+        _incremental_routes.invalidate_via(lid, [this, & f] (local_id_t dest) {
+            _nodes[dest].next_hop = INVALID_LOCAL_ID;
+            f(node_id_of(dest));
+        });
+    }
+
+    /**
+     * Returns incremental route entry to advertise for destination @a dest_id.
+     */
+    pfs::optional<route_update_info<node_id>> route_update_for (node_id dest_id) const
+    {
+        auto lid = local_id_of(dest_id);
+
+        if (lid == INVALID_LOCAL_ID)
+            return pfs::nullopt;
+
+        auto u = _incremental_routes.entry_for(lid);
+
+        if (!u)
+            return pfs::nullopt;
+
+        return route_update_info<node_id>{dest_id, u->hops, u->seqno};
+    }
+
+    /**
+     * Iterates over all incremental routes (including unreachable ones).
+     *
+     * @param f Invokable object with signature void (route_update_info<node_id> const &).
+     */
+    template <typename F>
+    void foreach_route_update (F && f) const
+    {
+        _incremental_routes.foreach_entry([this, & f] (route_update_info<local_id_t> const & u) {
+            f(route_update_info<node_id>{node_id_of(u.dest_id), u.hops, u.seqno});
+        });
+    }
+
+    /**
+     * Returns number of gateways of the incremental route to @a dest_id.
+     */
+    std::size_t incremental_hops (node_id dest_id) const
+    {
+        auto lid = local_id_of(dest_id);
+        return lid == INVALID_LOCAL_ID ? 0 : _incremental_routes.hops(lid);
+    }
+
+    /**
+     * Processes segment route update @a u received from the sibling gateway @a neighbor_id.
+     * Segment routes are advertised by gateways only.
+     */
+    route_update_result update_segment_route (node_id neighbor_id, bool neighbor_is_gateway
+        , route_update_info<segment_id_t> const & u)
+    {
+        if (!neighbor_is_gateway || u.dest_id == 0)
+            return route_update_result::ignored;
+
+        return _segment_routes.update(u.dest_id, intern(neighbor_id)
+            , distance_vector<segment_id_t, local_id_t>::next_hops(u.hops), u.seqno);
+    }
+
+    /**
+     * Marks segment routes through the sibling node @a neighbor_id as unreachable and calls @a f
+     * for each affected segment.
+     *
+     * @param f Invokable object with signature void (segment_id_t).
+     */
+    template <typename F>
+    void invalidate_segment_routes_via (node_id neighbor_id, F && f)
+    {
+        auto lid = local_id_of(neighbor_id);
+
+        if (lid != INVALID_LOCAL_ID)
+            _segment_routes.invalidate_via(lid, std::forward<F>(f));
+    }
+
+    /**
+     * Returns next hop toward the border gateway of the segment @a segment.
+     */
+    pfs::optional<node_id> gateway_for_segment (segment_id_t segment) const
+    {
+        auto next_hop = _segment_routes.next_hop(segment);
+
+        if (!next_hop)
+            return pfs::nullopt;
+
+        return node_id_of(*next_hop);
+    }
+
+    /**
+     * Returns segment route entry to advertise for segment @a segment.
+     */
+    pfs::optional<route_update_info<segment_id_t>> segment_route_update_for (segment_id_t segment) const
+    {
+        return _segment_routes.entry_for(segment);
+    }
+
+    /**
+     * Iterates over all segment routes (including unreachable ones).
+     *
+     * @param f Invokable object with signature void (route_update_info<segment_id_t> const &).
+     */
+    template <typename F>
+    void foreach_segment_route_update (F && f) const
+    {
+        _segment_routes.foreach_entry(std::forward<F>(f));
+    }
+
+    /**
+     * Iterates over reachable segments.
+     *
+     * @param f Invokable object with signature void (segment_id_t, node_id next_hop).
+     */
+    template <typename F>
+    void foreach_segment_route (F && f) const
+    {
+        _segment_routes.foreach_route([this, & f] (segment_id_t segment, local_id_t next_hop) {
+            f(segment, node_id_of(next_hop));
+        });
+    }
+
+    /**
+     * Serializes routes learned by route discovery (gateway chains with destinations and route
+     * latencies) into the snapshot used for warm start of the node.
+     *
+     * @details Sibling nodes and incremental routes are not exported: siblings are reestablished
+     *          by handshakes and incremental routes are resynchronized with the neighbors.
+     */
+    void export_snapshot (serializer_type & out) const
+    {
+        std::uint32_t count = 0;
+
+        for (auto const & dests: _chain_dests) {
+            if (!dests.empty())
+                count++;
+        }
+
+        out << SNAPSHOT_VERSION() << count;
+
+        for (std::size_t i = 0; i < _gateway_chains.size(); i++) {
+            if (_chain_dests[i].empty())
+                continue;
+
+            out << static_cast<std::uint16_t>(_gateway_chains[i].size());
+
+            for (auto lid: _gateway_chains[i])
+                out << node_id_of(lid);
+
+            out << static_cast<std::uint32_t>(_chain_dests[i].size());
+
+            for (auto const & x: _chain_dests[i])
+                out << node_id_of(x.first) << x.second.tail_latency;
+        }
+    }
+
+    /**
+     * Imports routes from the snapshot (see export_snapshot()) as provisional ones. Routes to
+     * the sibling nodes and already known routes are skipped.
+     *
+     * @return @c false if the snapshot is malformed or has unsupported version (nothing imported).
+     */
+    template <typename Deserializer>
+    bool import_snapshot (Deserializer & in)
+    {
+        struct snapshot_route
+        {
+            node_id dest_id;
+            std::uint64_t tail_latency;
+        };
+
+        std::uint8_t version = 0;
+        std::uint32_t count = 0;
+
+        in >> version >> count;
+
+        if (!in.is_good() || version != SNAPSHOT_VERSION())
+            return false;
+
+        std::vector<std::pair<gateway_chain_type, std::vector<snapshot_route>>> chains;
+
+        for (std::uint32_t i = 0; i < count && in.is_good(); i++) {
+            std::uint16_t chain_size = 0;
+            in >> chain_size;
+
+            gateway_chain_type gw_chain;
+
+            for (std::uint16_t j = 0; j < chain_size && in.is_good(); j++) {
+                node_id id;
+                in >> id;
+                gw_chain.push_back(id);
+            }
+
+            std::uint32_t dest_count = 0;
+            in >> dest_count;
+
+            std::vector<snapshot_route> dests;
+
+            for (std::uint32_t j = 0; j < dest_count && in.is_good(); j++) {
+                snapshot_route r;
+                in >> r.dest_id >> r.tail_latency;
+                dests.push_back(r);
+            }
+
+            if (gw_chain.empty())
+                return false;
+
+            chains.emplace_back(std::move(gw_chain), std::move(dests));
+        }
+
+        if (!in.is_good())
+            return false;
+
+        for (auto const & x: chains) {
+            auto gw_chain = make_chain(x.first.cbegin(), x.first.cend());
+
+            for (auto const & r: x.second) {
+                if (is_sibling(r.dest_id))
+                    continue;
+
+                auto dest = intern(r.dest_id);
+                auto res = add_route_helper(dest, gw_chain);
+
+                if (res.second) {
+                    auto & state = _chain_dests[res.first - 1][dest];
+                    state.tail_latency = r.tail_latency;
+                    state.provisional = true;
+                    _has_provisional = true;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Returns @c true if the route to @a dest_id by gateway chain @a index (as returned by
+     * add_route/add_subroute) is provisional.
+     */
+    bool is_provisional (node_id dest_id, std::size_t index) const
+    {
+        auto lid = local_id_of(dest_id);
+
+        if (lid == INVALID_LOCAL_ID || index == 0 || index > _chain_dests.size())
+            return false;
+
+        auto pos = _chain_dests[index - 1].find(lid);
+        return pos != _chain_dests[index - 1].end() && pos->second.provisional;
+    }
+
+    /**
+     * Removes provisional routes not confirmed yet.
+     *
+     * @param f Invokable object with signature void (node_id dest_id) called for each
+     *        destination became unreachable.
+     *
+     * @return Number of routes removed.
+     */
+    template <typename F>
+    std::size_t remove_provisional_routes (F && f)
+    {
+        if (!_has_provisional)
+            return 0;
+
+        std::size_t n = 0;
+        std::set<local_id_t> affected_nodes;
+
+        for (std::size_t index = 0; index < _chain_dests.size(); index++) {
+            auto & dests = _chain_dests[index];
+
+            for (auto pos = dests.begin(); pos != dests.end();) {
+                if (pos->second.provisional) {
+                    erase_route(pos->first, index);
+                    affected_nodes.insert(pos->first);
+                    pos = dests.erase(pos);
+                    ++n;
+                } else {
+                    ++pos;
+                }
+            }
+        }
+
+        _has_provisional = false;
+
+        for (auto x: affected_nodes) {
+            _nodes[x].next_hop = INVALID_LOCAL_ID;
+            _nodes[x].selected = pfs::nullopt;
+
+            if (!is_reachable(x))
+                f(node_id_of(x));
+        }
+
+        return n;
     }
 
 public: // static
@@ -377,12 +1178,24 @@ public: // static
 
     /**
      * Serializes request to forward.
+     *
+     * @param link_latency Latency of the link between gateway @a gw_id and the request sender.
+     *
+     * @note Link latencies are serialized with route_metric::latency only.
      */
-    static archive_type serialize_request (node_id gw_id, route_info<node_id> const & initial_info)
+    archive_type serialize_request (node_id gw_id, route_info<node_id> const & initial_info
+        , std::uint32_t link_latency = 0) const
     {
         route_info<node_id> info = initial_info;
         info.route.push_back(gw_id);
 
+        if (_metric == route_metric::latency) {
+            info.latencies.resize(info.route.size() - 1, 0);
+            info.latencies.push_back(link_latency);
+        } else {
+            info.latencies.clear();
+        }
+
         archive_type ar;
         serializer_type out {ar};
         route_packet<node_id> pkt {packet_way_enum::request, std::move(info)};
@@ -392,12 +1205,24 @@ public: // static
 
     /**
      * Serializes initial response
+     *
+     * @param link_latency Latency of the link between responder and the last gateway.
+     *
+     * @note Link latencies are serialized with route_metric::latency only.
      */
-    static archive_type serialize_response (node_id responder_id, route_info<node_id> const & initial_info)
+    archive_type serialize_response (node_id responder_id, route_info<node_id> const & initial_info
+        , std::uint32_t link_latency = 0) const
     {
         route_info<node_id> info = initial_info;
         info.responder_id = responder_id;
 
+        if (_metric == route_metric::latency) {
+            info.latencies.resize(info.route.size(), 0);
+            info.latencies.push_back(link_latency);
+        } else {
+            info.latencies.clear();
+        }
+
         archive_type ar;
         serializer_type out {ar};
         route_packet<node_id> pkt {packet_way_enum::response, std::move(info)};
@@ -408,10 +1233,13 @@ public: // static
     /**
      * Serializes response to forward.
      */
-    static archive_type serialize_response (route_info<node_id> const & initial_info)
+    archive_type serialize_response (route_info<node_id> const & initial_info) const
     {
         route_info<node_id> info = initial_info;
 
+        if (_metric != route_metric::latency)
+            info.latencies.clear();
+
         archive_type ar;
         serializer_type out {ar};
         route_packet<node_id> pkt {packet_way_enum::response, std::move(info)};
@@ -419,6 +1247,19 @@ public: // static
         return ar;
     }
 
+    /**
+     * Serializes incremental route update packet
+     */
+    static archive_type serialize (std::vector<route_update_info<node_id>> entries
+        , std::vector<route_update_info<segment_id_t>> segment_entries = {})
+    {
+        archive_type ar;
+        serializer_type out {ar};
+        route_update_packet<node_id> pkt {std::move(entries), std::move(segment_entries)};
+        pkt.serialize(out);
+        return ar;
+    }
+
     /**
      * Serializes unreachable packet
      */
@@ -432,95 +1273,310 @@ public: // static
     }
 
 private:
-    std::pair<bool, std::size_t> find_route (gateway_chain_type const & r) const
+    /**
+     * Returns local index of the node @a id, assigns new one (with empty state) if the node is
+     * not known yet.
+     */
+    local_id_t intern (node_id const & id)
     {
-        for (std::size_t i = 0; i < _gateway_chains.size(); i++) {
-            if (r == _gateway_chains[i])
-                return std::make_pair(true, i);
+        auto lid = _interner.intern(id);
+
+        if (lid >= _nodes.size())
+            _nodes.resize(lid + 1);
+
+        return lid;
+    }
+
+    local_id_t local_id_of (node_id const & id) const
+    {
+        return _interner.find(id);
+    }
+
+    node_id const & node_id_of (local_id_t lid) const
+    {
+        return _interner.node_id_of(lid);
+    }
+
+    template <typename InputIt>
+    compact_chain make_chain (InputIt first, InputIt last)
+    {
+        compact_chain result;
+
+        for (; first != last; ++first)
+            result.push_back(intern(*first));
+
+        return result;
+    }
+
+    gateway_chain_type to_gateway_chain (compact_chain const & chain) const
+    {
+        gateway_chain_type result;
+        result.reserve(chain.size());
+
+        for (auto lid: chain)
+            result.push_back(node_id_of(lid));
+
+        return result;
+    }
+
+    void clear_next_hops ()
+    {
+        for (auto & n: _nodes)
+            n.next_hop = INVALID_LOCAL_ID;
+    }
+
+    static std::size_t hash_of (compact_chain const & r)
+    {
+        std::hash<local_id_t> hasher;
+        std::size_t result = r.size();
+
+        for (auto x: r)
+            result ^= hasher(x) + 0x9e3779b9 + (result << 6) + (result >> 2);
+
+        return result;
+    }
+
+    std::pair<bool, std::size_t> find_route (compact_chain const & r, std::size_t hash) const
+    {
+        auto range = _chain_index.equal_range(hash);
+
+        for (auto pos = range.first; pos != range.second; ++pos) {
+            if (r == _gateway_chains[pos->second])
+                return std::make_pair(true, pos->second);
         }
 
         return std::make_pair(false, std::size_t{0});
     }
 
     /**
-     * Find route for node @a id with minimim hops (number of gateways).
+     * Removes route to @a dest through gateway chain @a index from the route map.
+     */
+    void erase_route (local_id_t dest, std::size_t index)
+    {
+        auto & routes = _nodes[dest].routes;
+        auto pos = std::find(routes.begin(), routes.end(), index);
+
+        if (pos != routes.end())
+            routes.erase(pos);
+    }
+
+    /**
+     * Removes all routes to @a dest.
      */
-    std::pair<bool, std::size_t> find_optimal_route_for (node_id id) const
+    void erase_routes_to (local_id_t dest)
+    {
+        auto & routes = _nodes[dest].routes;
+
+        for (auto index: routes)
+            _chain_dests[index].erase(dest);
+
+        routes.clear();
+    }
+
+    bool is_reachable (local_id_t lid) const
+    {
+        auto const & n = _nodes[lid];
+
+        if (n.is_sibling || _incremental_routes.has_route(lid))
+            return true;
+
+        for (auto index: n.routes) {
+            if (is_usable(lid, index))
+                return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Checks if the route to @a dest by gateway chain @a index can be used: route is confirmed or
+     * its first gateway is a sibling node.
+     */
+    bool is_usable (local_id_t dest, std::size_t index) const
+    {
+        if (!_has_provisional || _nodes[_gateway_chains[index][0]].is_sibling)
+            return true;
+
+        return !_chain_dests[index].at(dest).provisional;
+    }
+
+    /**
+     * Find route for node @a lid with minimim hops (number of gateways).
+     */
+    std::pair<bool, std::size_t> find_optimal_route_for (local_id_t lid) const
     {
         auto min_hops = std::numeric_limits<std::size_t>::max();
-        auto res = _route_map.equal_range(id);
+        auto const & routes = _nodes[lid].routes;
 
         // Not found
-        if (res.first == res.second)
+        if (routes.empty())
             return std::make_pair(false, std::size_t{0});
 
         std::size_t index = 0;
+        bool found = false;
+        bool provisional = true;
 
-        for (auto pos = res.first; pos != res.second; ++pos) {
-            auto & r = _gateway_chains[pos->second];
-            auto hops = r.size();
+        for (auto i: routes) {
+            auto hops = _gateway_chains[i].size();
 
             PFS__THROW_UNEXPECTED(hops > 0, "Fix meshnet::routing_table algorithm");
 
-            if (min_hops > hops /*&& r.good()*/) {
+            if (!is_usable(lid, i))
+                continue;
+
+            // Preference is given to confirmed routes
+            auto p = _has_provisional && _chain_dests[i].at(lid).provisional;
+
+            if ((provisional && !p) || (provisional == p && min_hops > hops)) {
                 min_hops = hops;
-                index = pos->second;
+                index = i;
+                provisional = p;
+                found = true;
             }
         }
 
+        return std::make_pair(found, index);
+    }
+
+    /**
+     * Returns expected latency of the route to @a lid by gateway chain @a index.
+     */
+    std::uint64_t route_latency (local_id_t lid, std::size_t index) const
+    {
+        auto & r = _gateway_chains[index];
+        auto first_hop = _nodes[r[0]].link_latency;
+
+        return (first_hop > 0 ? first_hop : _default_link_latency)
+            + _chain_dests[index].at(lid).tail_latency;
+    }
+
+    /**
+     * Find route for node @a lid with minimum expected latency.
+     */
+    std::pair<bool, std::size_t> find_fastest_route_for (local_id_t lid) const
+    {
+        auto const & n = _nodes[lid];
+
         // Not found
-        if (min_hops == std::numeric_limits<std::size_t>::max())
-            return std::make_pair(false, std::size_t{0});;
+        if (n.routes.empty())
+            return std::make_pair(false, std::size_t{0});
 
-        // Found
+        std::size_t index = 0;
+        auto min_latency = std::numeric_limits<std::uint64_t>::max();
+        auto min_hops = std::numeric_limits<std::size_t>::max();
+        bool found = false;
+        bool provisional = true;
+        bool has_selected = false;
+        std::uint64_t selected_latency = 0;
+        bool selected_provisional = false;
+
+        for (auto i: n.routes) {
+            if (!is_usable(lid, i))
+                continue;
+
+            auto latency = route_latency(lid, i);
+            auto hops = _gateway_chains[i].size();
+
+            // Preference is given to confirmed routes
+            auto p = _has_provisional && _chain_dests[i].at(lid).provisional;
+
+            // On tie preference is given to a route with a low value of hops
+            if ((provisional && !p) || (provisional == p && (latency < min_latency
+                    || (latency == min_latency && hops < min_hops)
+                    || (latency == min_latency && hops == min_hops && i < index)))) {
+                min_latency = latency;
+                min_hops = hops;
+                index = i;
+                provisional = p;
+                found = true;
+            }
+
+            if (n.selected && *n.selected == i) {
+                has_selected = true;
+                selected_latency = latency;
+                selected_provisional = p;
+            }
+        }
+
+        if (!found)
+            return std::make_pair(false, std::size_t{0});
+
+        // Keep the selected route if the best one is not significantly better
+        if (has_selected && index != *n.selected && selected_provisional == provisional) {
+            if (min_latency * (100 + _hysteresis_percent) >= selected_latency * 100)
+                index = *n.selected;
+        }
+
+        n.selected = index;
         return std::make_pair(true, index);
     }
 
+    static std::uint32_t clamp_latency (std::chrono::microseconds::rep value)
+    {
+        if (value <= 0)
+            return 0;
+
+        if (value > (std::numeric_limits<std::uint32_t>::max)())
+            return (std::numeric_limits<std::uint32_t>::max)();
+
+        return static_cast<std::uint32_t>(value);
+    }
+
     std::pair<std::size_t, bool>
-    add_route_helper (node_id dest_id, gateway_chain_type gw_chain)
+    add_route_helper (local_id_t dest, compact_chain gw_chain)
     {
         PFS__THROW_UNEXPECTED(!gw_chain.empty(), "Fix meshnet::routing_table algorithm");
 
-        auto res = find_route(gw_chain);
+        auto hash = hash_of(gw_chain);
+        auto res = find_route(gw_chain, hash);
 
         // Not found
         if (!res.first) {
+            auto index = _gateway_chains.size();
+
+            for (auto x: gw_chain) {
+                auto & indices = _nodes[x].chains;
+
+                // Node can be repeated in the chain
+                if (indices.empty() || indices.back() != index)
+                    indices.push_back(index);
+            }
+
             _gateway_chains.push_back(std::move(gw_chain));
-            auto index = _gateway_chains.size() - 1;
+            _chain_dests.emplace_back();
+            _chain_dests.back().emplace(dest, route_state{});
+            _chain_index.insert({hash, index});
 
-            _route_map.insert({dest_id, index});
+            _nodes[dest].routes.push_back(index);
+            _nodes[dest].next_hop = INVALID_LOCAL_ID;
             return std::make_pair(std::size_t{index + 1}, true);
         }
 
-        // Check if record for destination node already exists
-        auto range = _route_map.equal_range(dest_id);
+        auto index = res.second;
 
-        if (range.first != range.second) {
-            // Check if route to destination already exists
-            for (auto pos = range.first; pos != range.second; ++pos) {
-                auto & tmp = _gateway_chains[pos->second];
+        auto state = _chain_dests[index].emplace(dest, route_state{});
 
-                // Already exists
-                if (tmp == gw_chain)
-                    return std::make_pair(std::size_t{pos->second + 1}, false);
+        // Route to destination already exists
+        if (!state.second) {
+            // Provisional route confirmed
+            if (state.first->second.provisional) {
+                state.first->second.provisional = false;
+                _nodes[dest].next_hop = INVALID_LOCAL_ID;
+                return std::make_pair(std::size_t{index + 1}, true);
             }
+
+            return std::make_pair(std::size_t{index + 1}, false);
         }
 
-        auto index = res.second;
-        _route_map.insert({dest_id, index});
+        _nodes[dest].routes.push_back(index);
+        _nodes[dest].next_hop = INVALID_LOCAL_ID;
         return std::make_pair(std::size_t{index + 1}, true);
     }
 
-    bool is_sibling (node_id id) const
-    {
-        return _sibling_nodes.find(id) != _sibling_nodes.end();
-    }
-
-    static gateway_chain_type reverse_gateway_chain (gateway_chain_type const & gw_chain)
+    bool is_sibling (node_id const & id) const
     {
-        gateway_chain_type reversed_gw_chain(gw_chain.size());
-        std::reverse_copy(gw_chain.begin(), gw_chain.end(), reversed_gw_chain.begin());
-        return reversed_gw_chain;
+        auto lid = local_id_of(id);
+        return lid != INVALID_LOCAL_ID && _nodes[lid].is_sibling;
     }
 };
 
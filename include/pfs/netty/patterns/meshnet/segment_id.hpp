@@ -0,0 +1,23 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include <cstdint>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace meshnet {
+
+// Segment identifier used by hierarchical routing. Zero value means that the node does not belong
+// to any segment.
+using segment_id_t = std::uint32_t;
+
+} // namespace meshnet
+
+NETTY__NAMESPACE_END
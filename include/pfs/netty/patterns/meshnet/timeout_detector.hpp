@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.11 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include <chrono>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace meshnet {
+
+/**
+ * Failure detector with fixed expiration timeout (default heartbeat policy).
+ */
+class timeout_detector
+{
+public:
+    using time_point_type = std::chrono::steady_clock::time_point;
+
+private:
+    std::chrono::steady_clock::duration _exp_timeout;
+    time_point_type _last;
+
+public:
+    timeout_detector (std::chrono::seconds exp_timeout, time_point_type now)
+        : _exp_timeout(exp_timeout)
+        , _last(now)
+    {}
+
+public:
+    /**
+     * Registers heartbeat arrival.
+     */
+    void heartbeat (time_point_type now) noexcept
+    {
+        _last = now;
+    }
+
+    /**
+     * Registers arrival of any other frame.
+     */
+    void refresh (time_point_type now) noexcept
+    {
+        _last = now;
+    }
+
+    /**
+     * Returns time point after which the channel is considered failed.
+     */
+    time_point_type deadline () const noexcept
+    {
+        return _last + _exp_timeout;
+    }
+
+    /**
+     * Returns elapsed part of the expiration timeout (channel is considered failed at 1.0).
+     */
+    double suspicion (time_point_type now) const noexcept
+    {
+        return static_cast<double>((now - _last).count()) / _exp_timeout.count();
+    }
+};
+
+} // namespace meshnet
+
+NETTY__NAMESPACE_END
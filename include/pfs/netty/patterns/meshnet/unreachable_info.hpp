@@ -7,10 +7,12 @@
 //      2025.03.13 Initial version.
 //      2025.05.12 `node_id_rep` replaced by `std::string`.
 //      2025.12.14 Removed `alive_info` and header file renamed to `unreachable_info`.
+//      2026.06.13 Replaced single unreachable node ID by the list, added generation.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
-#include <string>
+#include <cstdint>
+#include <vector>
 
 NETTY__NAMESPACE_BEGIN
 
@@ -19,8 +21,11 @@ namespace meshnet {
 template <typename NodeId>
 struct unreachable_info
 {
-    NodeId gw_id; // gateway ID that fixed channel disconnection
-    NodeId id;    // unreachable node ID
+    NodeId gw_id;                 // gateway ID that fixed channel disconnection
+    std::vector<NodeId> ids;      // unreachable node IDs
+    std::uint32_t generation {0}; // notification generation assigned by the gateway (used to
+                                  // suppress duplicates received by different paths), zero for
+                                  // the notification in the previous format
 };
 
 } // namespace meshnet
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.27 Initial version (extracted from `node.hpp`).
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace meshnet {
+
+/**
+ * Unreachable notifications state of the node.
+ *
+ * @details Origin (gateway) side: notifications about the lost sibling nodes are held down during
+ *          the hold-down interval, aggregated and cancelled if the channel is reestablished during
+ *          this interval (link flapping).
+ *          Receiver side: the last processed generation is remembered for each (gateway,
+ *          unreachable node) pair to drop duplicates received by the different paths and outdated
+ *          notifications.
+ */
+template <typename NodeId>
+class unreachable_tracker
+{
+public:
+    using node_id = NodeId;
+    using time_point_type = std::chrono::steady_clock::time_point;
+
+private:
+    // Last processed unreachable notification about the node by the gateway
+    struct seen_item
+    {
+        std::uint32_t generation {0};
+        time_point_type expiration;
+    };
+
+private:
+    // Lost sibling node -> hold-down deadline of the notification
+    std::unordered_map<node_id, time_point_type> _pending;
+    std::chrono::milliseconds _hold_down {50};
+
+    // Generation of the notifications originated by this node
+    std::uint32_t _generation {0};
+
+    // Gateway -> unreachable node -> last processed notification
+    std::unordered_map<node_id, std::unordered_map<node_id, seen_item>> _seen;
+    time_point_type _purge;
+
+public:
+    // Using function avoids 'multiple definition' error prior to C++17.
+    static constexpr std::chrono::seconds SEEN_TIMEOUT () { return std::chrono::seconds{30}; }
+
+public:
+    unreachable_tracker ()
+    {
+        // Wall clock outdates the generations of the previous node instance
+        _generation = static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+public:
+    void set_hold_down (std::chrono::milliseconds interval) noexcept
+    {
+        _hold_down = interval;
+    }
+
+    std::size_t pending_count () const noexcept
+    {
+        return _pending.size();
+    }
+
+    /**
+     * Schedules notification about the lost sibling node @a id.
+     */
+    void lost (node_id id, time_point_type now)
+    {
+        _pending.emplace(id, now + _hold_down);
+    }
+
+    /**
+     * Cancels notification about the sibling node @a id which channel is reestablished.
+     *
+     * @return @c true if the notification was pending.
+     */
+    bool restored (node_id id)
+    {
+        return _pending.erase(id) > 0;
+    }
+
+    /**
+     * Extracts nodes which hold-down interval elapsed by the @a now.
+     */
+    std::vector<node_id> fetch_expired (time_point_type now)
+    {
+        std::vector<node_id> ids;
+
+        for (auto pos = _pending.begin(); pos != _pending.end();) {
+            if (pos->second <= now) {
+                ids.push_back(pos->first);
+                pos = _pending.erase(pos);
+            } else {
+                ++pos;
+            }
+        }
+
+        return ids;
+    }
+
+    /**
+     * Returns generation for the new notification originated by this node (never zero).
+     */
+    std::uint32_t next_generation () noexcept
+    {
+        if (++_generation == 0)
+            ++_generation;
+
+        return _generation;
+    }
+
+    /**
+     * Checks if notification from the gateway @a gw_id about the node @a id with @a generation
+     * must be processed and remembers it.
+     *
+     * @return @c false if the notification is a duplicate received by the other path or
+     *         outdated. Zero generation (notification in the previous format) is always processed.
+     */
+    bool accept (node_id gw_id, node_id id, std::uint32_t generation, time_point_type now)
+    {
+        if (generation == 0)
+            return true;
+
+        auto expiration = now + SEEN_TIMEOUT();
+        auto res = _seen[gw_id].emplace(id, seen_item{generation, expiration});
+
+        if (!res.second) {
+            auto & x = res.first->second;
+
+            if (static_cast<std::int32_t>(generation - x.generation) <= 0)
+                return false;
+
+            x.generation = generation;
+            x.expiration = expiration;
+        }
+
+        return true;
+    }
+
+    /**
+     * Purges expired records of the processed notifications (at most once a second).
+     */
+    void purge (time_point_type now)
+    {
+        if (now < _purge)
+            return;
+
+        for (auto pos = _seen.begin(); pos != _seen.end();) {
+            auto & seen = pos->second;
+
+            for (auto spos = seen.begin(); spos != seen.end();) {
+                if (spos->second.expiration <= now)
+                    spos = seen.erase(spos);
+                else
+                    ++spos;
+            }
+
+            if (seen.empty())
+                pos = _seen.erase(pos);
+            else
+                ++pos;
+        }
+
+        _purge = now + std::chrono::seconds{1};
+    }
+};
+
+} // namespace meshnet
+
+NETTY__NAMESPACE_END
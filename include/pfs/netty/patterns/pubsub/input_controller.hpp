@@ -6,6 +6,7 @@
 // Changelog:
 //      2025.08.09 Initial version.
 //      2025.11.27 Include account type instead of external type.
+//      2026.05.16 Added topic and subscription callbacks.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../callback.hpp"
@@ -13,6 +14,7 @@
 #include "protocol.hpp"
 #include <pfs/assert.hpp>
 #include <pfs/utility.hpp>
+#include <string>
 #include <unordered_map>
 
 NETTY__NAMESPACE_BEGIN
@@ -57,6 +59,12 @@ public:
 public: // Callbacks
     mutable callback_t<void (archive_type)> on_data_ready = [] (archive_type) {};
 
+    // Called for packets with topic, if not set `on_data_ready` is called instead
+    mutable callback_t<void (std::string const & /*topic*/, archive_type)> on_topic_data_ready;
+
+    mutable callback_t<void (std::string const & /*pattern*/)> on_subscribe = [] (std::string const &) {};
+    mutable callback_t<void (std::string const & /*pattern*/)> on_unsubscribe = [] (std::string const &) {};
+
 public:
     void process_input (archive_type && chunk)
     {
@@ -85,10 +93,30 @@ public:
                     archive_type bytes_in;
                     data_packet pkt {h, in, bytes_in};
 
-                    if (in.commit_transaction())
-                        on_data_ready(std::move(bytes_in));
-                    else
+                    if (in.commit_transaction()) {
+                        if (!pkt.topic().empty() && on_topic_data_ready)
+                            on_topic_data_ready(pkt.topic(), std::move(bytes_in));
+                        else
+                            on_data_ready(std::move(bytes_in));
+                    } else {
+                        has_more_packets = false;
+                    }
+
+                    break;
+                }
+
+                case packet_enum::subscribe:
+                case packet_enum::unsubscribe: {
+                    subscription_packet pkt {h, in};
+
+                    if (in.commit_transaction()) {
+                        if (h.type() == packet_enum::subscribe)
+                            on_subscribe(pkt.pattern());
+                        else
+                            on_unsubscribe(pkt.pattern());
+                    } else {
                         has_more_packets = false;
+                    }
 
                     break;
                 }
@@ -7,6 +7,8 @@
 //
 // Changelog:
 //      2025.11.27 Initial version.
+//      2026.05.16 Added topic to `data_packet` and subscription packets.
+//      2026.06.27 Checksum of the `data_packet` covers the topic.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
@@ -14,6 +16,7 @@
 #include <pfs/i18n.hpp>
 #include <pfs/numeric_cast.hpp>
 #include <cstdint>
+#include <string>
 
 NETTY__NAMESPACE_BEGIN
 
@@ -22,7 +25,9 @@ namespace pubsub {
 /// Packet type
 enum class packet_enum
 {
-      data = 1 /// Basic packet (since version 1)
+      data = 1        /// Basic packet (since version 1)
+    , subscribe = 2   /// Subscribe to the topic (since version 1)
+    , unsubscribe = 3 /// Unsubscribe from the topic (since version 1)
 };
 
 // Byte 0:
@@ -42,6 +47,14 @@ enum class packet_enum
 // +-------------------------------+
 // (C) - Checksum bit (0 - no checksum, 1 - has checksum).
 // (F0)-(F6) - free/reserved bits (can be used by some packets)
+//
+// `data` packet:
+//      (F0) - packet has topic (uint16 topic size + topic bytes follows the header).
+//             Checksum covers the topic bytes followed by the payload.
+//
+// `subscribe`/`unsubscribe` packets:
+//      uint16 topic pattern size + topic pattern bytes follows the header.
+//      Topic pattern ending with '*' matches all topics with the same prefix.
 
 class header
 {
@@ -196,6 +209,8 @@ constexpr int header::VERSION;
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 class data_packet: public header
 {
+    std::string _topic;
+
 public:
     data_packet (bool has_checksum = true) noexcept
         : header(packet_enum::data, has_checksum)
@@ -205,12 +220,18 @@ public:
     data_packet (header const & h, Deserializer & in, Archive & ar)
         : header(h)
     {
+        if (is_f0()) {
+            std::uint16_t topic_size = 0;
+            in >> topic_size;
+            in.read(_topic, topic_size);
+        }
+
         // _h.length already has been read before
         in.read(ar, _h.length);
 
         if (in.is_good()) {
             if (has_checksum()) {
-                auto crc16 = pfs::crc16_of_ptr(ar.data(), ar.size());
+                auto crc16 = checksum(ar.data(), ar.size());
 
                 if (crc16 != _h.crc16) {
                     throw error {
@@ -224,20 +245,91 @@ public:
         }
     }
 
+private:
+    std::int16_t checksum (char const * data, std::size_t len) const
+    {
+        if (_topic.empty())
+            return pfs::crc16_of_ptr(data, len);
+
+        auto crc16 = pfs::crc16_of_ptr(_topic.data(), _topic.size());
+        return pfs::crc16_of_ptr(data, len, crc16);
+    }
+
 public:
+    std::string const & topic () const noexcept
+    {
+        return _topic;
+    }
+
+    /**
+     * Sets topic for the packet (empty topic means no topic).
+     */
+    void set_topic (std::string topic)
+    {
+        _topic = std::move(topic);
+
+        if (_topic.empty())
+            _h.b1 &= static_cast<std::uint8_t>(~0x02);
+        else
+            enable_f0();
+    }
+
     template <typename Serializer>
     void serialize (Serializer & out, char const * data, std::size_t len)
     {
         if (has_checksum())
-            _h.crc16 = pfs::crc16_of_ptr(data, len);
+            _h.crc16 = checksum(data, len);
 
         _h.length = pfs::numeric_cast<decltype(_h.length)>(len);
 
         header::serialize(out);
+
+        if (is_f0()) {
+            out << pfs::numeric_cast<std::uint16_t>(_topic.size());
+            out.write(_topic.data(), _topic.size());
+        }
+
         out.write(data, len);
     }
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// subscribe/unsubscribe packet
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class subscription_packet: public header
+{
+    std::string _pattern;
+
+public:
+    subscription_packet (packet_enum type, std::string pattern) noexcept
+        : header(type, false)
+        , _pattern(std::move(pattern))
+    {}
+
+    template <typename Deserializer>
+    subscription_packet (header const & h, Deserializer & in)
+        : header(h)
+    {
+        std::uint16_t pattern_size = 0;
+        in >> pattern_size;
+        in.read(_pattern, pattern_size);
+    }
+
+public:
+    std::string const & pattern () const noexcept
+    {
+        return _pattern;
+    }
+
+    template <typename Serializer>
+    void serialize (Serializer & out)
+    {
+        header::serialize(out);
+        out << pfs::numeric_cast<std::uint16_t>(_pattern.size());
+        out.write(_pattern.data(), _pattern.size());
+    }
+};
+
 } // namespace pubsub
 
 NETTY__NAMESPACE_END
@@ -6,23 +6,34 @@
 // Changelog:
 //      2025.08.04 Initial version.
 //      2025.08.08 `interruptable` inheritance.
+//      2026.05.12 Added queue limits and watermark callbacks.
+//      2026.05.14 Added slow subscriber policy and lag metric.
+//      2026.05.16 Added topic-based subscriptions.
+//      2026.05.18 Added snapshot for the newly accepted subscriber.
+//      2026.06.27 Slow subscriber messages are conflated per topic.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../callback.hpp"
 #include "../../interruptable.hpp"
 #include "../../listener_pool.hpp"
+#include "../../reader_pool.hpp"
 #include "../../socket_pool.hpp"
 #include "../../socket4_addr.hpp"
 #include "../../trace.hpp"
 #include "../../writer_pool.hpp"
+#include "../../writer_queue_limits.hpp"
+#include "input_controller.hpp"
 #include "protocol.hpp"
 #include "tag.hpp"
+#include "topic_index.hpp"
 #include <pfs/countdown_timer.hpp>
 #include <pfs/i18n.hpp>
 #include <pfs/log.hpp>
 #include <chrono>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
 
 NETTY__NAMESPACE_BEGIN
 
@@ -37,10 +48,42 @@ namespace pubsub {
 //     |                           |
 //     +---------- data -----------+
 //
+// Subscriber can subscribe to the topics (see `subscriber::subscribe`), so the messages
+// published with topic (see `publisher::publish`) are sent to the interested subscribers only.
+// Messages broadcasted without topic are sent to all subscribers.
+//
+
+/**
+ * Policy applied to the subscriber which output backlog exceeds the limit.
+ */
+enum class slow_subscriber_policy
+{
+    // Drop pending messages with the same topic and keep the latest one (market-data style feed).
+    // Messages broadcasted without topic are conflated together.
+      conflate
+
+    // Drop the oldest pending messages to accept the new one.
+    , drop_oldest
+
+    // Disconnect the subscriber.
+    , disconnect
+};
+
+/**
+ * Subscriber lag metric.
+ */
+struct subscriber_lag
+{
+    socket4_addr saddr;
+    std::size_t backlog_bytes {0};    // Bytes queued for the subscriber
+    std::size_t backlog_messages {0}; // Messages queued for the subscriber
+    std::size_t dropped_messages {0}; // Messages dropped (conflated) since the subscriber accepted
+};
 
 template <typename Socket
     , typename Listener
     , typename ListenerPoller
+    , typename ReaderPoller
     , typename WriterPoller
     , typename WriterQueue
     , typename RecursiveWriterMutex>
@@ -57,6 +100,8 @@ private:
     using archive_type = typename serializer_traits_type::archive_type;
     using serializer_type = typename serializer_traits_type::serializer_type;
     using writer_pool_type = netty::writer_pool<socket_type, WriterPoller, WriterQueue>;
+    using reader_pool_type = netty::reader_pool<socket_type, ReaderPoller, archive_type>;
+    using input_controller_type = input_controller<serializer_traits_type>;
     using writer_mutex_type = RecursiveWriterMutex;
 
     using listener_id = typename listener_type::listener_id;
@@ -64,17 +109,34 @@ private:
 
 private:
     listener_pool_type _listener_pool;
+    reader_pool_type   _reader_pool;
     writer_pool_type   _writer_pool;
     socket_pool_type   _socket_pool;
 
+    // Input controllers to process subscription requests
+    std::unordered_map<socket_id, input_controller_type> _input_controllers;
+
+    topic_index<socket_id> _topic_index;
+
     // Writer mutex to protect broadcasting
     writer_mutex_type _writer_mtx;
 
+    // Disconnect subscriber when its output queue rejects message
+    bool _disconnect_on_overflow {false};
+
+    // Dropped messages counters for the accepted subscribers
+    std::unordered_map<socket_id, std::size_t> _dropped_counters;
+
 private: // Callbacks
     callback_t<void (std::string const &)> _on_error
         = [] (std::string const & errstr) { LOGE(PUBSUB_TAG, "{}", errstr); };
 
     callback_t<void (socket4_addr)> _on_accepted;
+    callback_t<void (socket4_addr, std::size_t)> _on_queue_high;
+    callback_t<void (socket4_addr, std::size_t)> _on_queue_low;
+    callback_t<void (socket4_addr)> _on_slow_subscriber;
+    callback_t<void (archive_type &)> _on_snapshot;
+    callback_t<void (socket4_addr, std::string const &)> _on_subscribed;
 
 public:
     publisher (listener_options const & opts): interruptable()
@@ -91,13 +153,77 @@ public:
         {
             NETTY__TRACE(PUBSUB_TAG, "subscriber socket accepted: #{}: {}", sock.id(), to_string(sock.saddr()));
             auto saddr = sock.saddr();
-            _writer_pool.add(sock.id());
+            auto sid = sock.id();
+            auto & ic = _input_controllers[sid];
+
+            ic.on_subscribe = [this, sid] (std::string const & pattern)
+            {
+                NETTY__TRACE(PUBSUB_TAG, "subscriber #{} subscribed to: {}", sid, pattern);
+                _topic_index.subscribe(sid, pattern);
+
+                if (_on_subscribed) {
+                    auto psock = _socket_pool.locate(sid);
+
+                    if (psock != nullptr)
+                        _on_subscribed(psock->saddr(), pattern);
+                }
+            };
+
+            ic.on_unsubscribe = [this, sid] (std::string const & pattern)
+            {
+                NETTY__TRACE(PUBSUB_TAG, "subscriber #{} unsubscribed from: {}", sid, pattern);
+                _topic_index.unsubscribe(sid, pattern);
+            };
+
+            _reader_pool.add(sid);
+            _writer_pool.add(sid);
+            _dropped_counters[sid] = 0;
             _socket_pool.add_accepted(std::move(sock));
 
+            if (_on_snapshot) {
+                archive_type snapshot;
+                _on_snapshot(snapshot);
+
+                if (!snapshot.empty())
+                    enqueue_unsafe(sid, snapshot.data(), snapshot.size());
+            }
+
             if (_on_accepted)
                 _on_accepted(saddr);
         };
 
+        _reader_pool.on_failure = [this] (socket_id sid, netty::error const & err)
+        {
+            _on_error(tr::f_("read from socket failure: #{}: {}", sid, err.what()));
+            close_socket(sid);
+        };
+
+        _reader_pool.on_disconnected = [this] (socket_id sid)
+        {
+            NETTY__TRACE(PUBSUB_TAG, "subscriber socket disconnected: #{}", sid);
+            close_socket(sid);
+        };
+
+        _reader_pool.on_data_ready = [this] (socket_id sid, archive_type data)
+        {
+            auto pos = _input_controllers.find(sid);
+
+            if (pos == _input_controllers.end())
+                return;
+
+            try {
+                pos->second.process_input(std::move(data));
+            } catch (netty::error const & err) {
+                _on_error(tr::f_("bad input from subscriber: #{}: {}", sid, err.what()));
+                close_socket(sid);
+            }
+        };
+
+        _reader_pool.locate_socket = [this] (socket_id sid)
+        {
+            return _socket_pool.locate(sid);
+        };
+
         _writer_pool.on_failure = [this] (socket_id sid, netty::error const & err)
         {
             _on_error(tr::f_("write to socket failure: #{}: {}", sid, err.what()));
@@ -115,6 +241,48 @@ public:
             return _socket_pool.locate(sid);
         };
 
+        _writer_pool.on_queue_high = [this] (socket_id sid, std::size_t bytes)
+        {
+            if (_on_queue_high) {
+                auto psock = _socket_pool.locate(sid);
+
+                if (psock != nullptr)
+                    _on_queue_high(psock->saddr(), bytes);
+            }
+        };
+
+        _writer_pool.on_queue_low = [this] (socket_id sid, std::size_t bytes)
+        {
+            if (_on_queue_low) {
+                auto psock = _socket_pool.locate(sid);
+
+                if (psock != nullptr)
+                    _on_queue_low(psock->saddr(), bytes);
+            }
+        };
+
+        _writer_pool.on_queue_overflow = [this] (socket_id sid, queue_occupancy const & occupancy)
+        {
+            auto pos = _dropped_counters.find(sid);
+
+            if (pos == _dropped_counters.end())
+                return;
+
+            pos->second += occupancy.dropped;
+
+            if (!occupancy.accepted && _disconnect_on_overflow) {
+                auto psock = _socket_pool.locate(sid);
+
+                NETTY__TRACE(PUBSUB_TAG, "slow subscriber disconnected: #{}: backlog {} bytes"
+                    , sid, occupancy.bytes);
+
+                if (psock != nullptr && _on_slow_subscriber)
+                    _on_slow_subscriber(psock->saddr());
+
+                close_socket(sid);
+            }
+        };
+
         NETTY__TRACE(PUBSUB_TAG, "publisher constructed");
     }
 
@@ -149,12 +317,147 @@ public: // Set callbacks
         return *this;
     }
 
+    /**
+     * Notify when output queue of the subscriber reaches the high watermark.
+     *
+     * @details Callback @a f signature must match:
+     *          void (socket4_addr subscriber_addr, std::size_t queued_bytes)
+     */
+    template <typename F>
+    publisher & on_queue_high (F && f)
+    {
+        _on_queue_high = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Notify when output queue of the congested subscriber falls to the low watermark.
+     *
+     * @details Callback @a f signature must match:
+     *          void (socket4_addr subscriber_addr, std::size_t queued_bytes)
+     */
+    template <typename F>
+    publisher & on_queue_low (F && f)
+    {
+        _on_queue_low = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Notify when the subscriber is disconnected according to slow subscriber policy.
+     *
+     * @details Callback @a f signature must match:
+     *          void (socket4_addr subscriber_addr)
+     */
+    template <typename F>
+    publisher & on_slow_subscriber (F && f)
+    {
+        _on_slow_subscriber = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Notify when the subscriber subscribed to the topic pattern.
+     *
+     * @details Callback @a f signature must match:
+     *          void (socket4_addr subscriber_addr, std::string const & pattern)
+     */
+    template <typename F>
+    publisher & on_subscribed (F && f)
+    {
+        _on_subscribed = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Sets callback to fill the snapshot (e.g. last values) sent to the newly accepted subscriber
+     * before any other message. Empty snapshot is not sent.
+     *
+     * @details Callback is called from the publisher's thread with publisher's writer mutex
+     *          locked.
+     *          Callback @a f signature must match:
+     *          void (archive_type & snapshot)
+     */
+    template <typename F>
+    publisher & on_snapshot (F && f)
+    {
+        _on_snapshot = std::forward<F>(f);
+        return *this;
+    }
+
 public:
     void listen ()
     {
         _listener_pool.listen();
     }
 
+    /**
+     * Sets output queue limits for all subscribers.
+     */
+    void set_queue_limits (writer_queue_limits const & limits)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        _writer_pool.set_queue_limits(limits);
+    }
+
+    /**
+     * Sets the policy applied to all subscribers which output backlog exceeds
+     * @a max_backlog_bytes (zero value means unlimited).
+     *
+     * @details Other queue limits (watermarks etc) are preserved.
+     */
+    void set_slow_subscriber_policy (std::size_t max_backlog_bytes, slow_subscriber_policy policy)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+
+        auto limits = _writer_pool.queue_limits();
+        limits.max_bytes = max_backlog_bytes;
+
+        switch (policy) {
+            case slow_subscriber_policy::conflate:
+                limits.overflow_policy = queue_overflow_policy::conflate;
+                break;
+            case slow_subscriber_policy::drop_oldest:
+                limits.overflow_policy = queue_overflow_policy::drop_oldest;
+                break;
+            case slow_subscriber_policy::disconnect:
+            default:
+                limits.overflow_policy = queue_overflow_policy::reject;
+                break;
+        }
+
+        _disconnect_on_overflow = (policy == slow_subscriber_policy::disconnect);
+        _writer_pool.set_queue_limits(limits);
+    }
+
+    /**
+     * Iterates over subscribers lag metrics.
+     *
+     * @details Callback @a f signature must match:
+     *          void (subscriber_lag const &)
+     */
+    template <typename F>
+    void foreach_subscriber_lag (F && f)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+
+        _writer_pool.for_each_occupancy([this, & f] (socket_id sid, queue_occupancy const & occupancy) {
+            auto pos = _dropped_counters.find(sid);
+            auto psock = _socket_pool.locate(sid);
+
+            // Subscriber is closing
+            if (pos == _dropped_counters.end() || psock == nullptr)
+                return;
+
+            subscriber_lag lag;
+            lag.saddr = psock->saddr();
+            lag.backlog_bytes = occupancy.bytes;
+            lag.backlog_messages = occupancy.messages;
+            lag.dropped_messages = pos->second;
+            f(lag);
+        });
+    }
+
     void broadcast (char const * data, std::size_t size)
     {
         std::unique_lock<writer_mutex_type> locker{_writer_mtx};
@@ -172,6 +475,29 @@ public:
         _writer_pool.enqueue_broadcast(ar.data(), ar.size());
     }
 
+    /**
+     * Sends message to the subscribers subscribed to the @a topic.
+     */
+    void publish (std::string const & topic, char const * data, std::size_t size)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        publish_unsafe(topic, data, size);
+    }
+
+    void publish_unsafe (std::string const & topic, char const * data, std::size_t size)
+    {
+        archive_type ar;
+        serializer_type out {ar};
+        bool force_checksum = true;
+        data_packet pkt {force_checksum};
+        pkt.set_topic(topic);
+        pkt.serialize(out, data, size);
+
+        _topic_index.match(topic, [this, & ar, & topic] (socket_id sid) {
+            _writer_pool.enqueue(sid, 0, ar.data(), ar.size(), topic);
+        });
+    }
+
     /**
      * @return Number of events occurred.
      */
@@ -186,10 +512,12 @@ public:
         unsigned int result = 0;
 
         result += _listener_pool.step();
+        result += _reader_pool.step();
         result += _writer_pool.step();
 
         // Remove trash
         _listener_pool.apply_remove();
+        _reader_pool.apply_remove();
         _writer_pool.apply_remove();
         _socket_pool.apply_remove(); // Must be last in the removing sequence
 
@@ -210,9 +538,25 @@ public:
     }
 
 private:
+    void enqueue_unsafe (socket_id sid, char const * data, std::size_t size)
+    {
+        archive_type ar;
+        serializer_type out {ar};
+        bool force_checksum = true;
+        data_packet pkt {force_checksum};
+        pkt.serialize(out, data, size);
+
+        _writer_pool.enqueue(sid, ar.data(), ar.size());
+    }
+
     void close_socket (socket_id sid)
     {
+        _dropped_counters.erase(sid);
+        _input_controllers.erase(sid);
+        _topic_index.remove(sid);
+
         if (_socket_pool.locate(sid) != nullptr) {
+            _reader_pool.remove_later(sid);
             _writer_pool.remove_later(sid);
             _socket_pool.remove_later(sid);
         }
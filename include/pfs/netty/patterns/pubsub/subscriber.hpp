@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2025.08.04 Initial version.
+//      2026.05.16 Added topic-based subscriptions.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
@@ -17,10 +18,15 @@
 #include "../../socket_pool.hpp"
 #include "../../socket4_addr.hpp"
 #include "../../trace.hpp"
+#include "../../writer_pool.hpp"
+#include "protocol.hpp"
 #include "tag.hpp"
+#include "writer_queue.hpp"
 #include <pfs/countdown_timer.hpp>
 #include <pfs/i18n.hpp>
 #include <pfs/log.hpp>
+#include <set>
+#include <string>
 
 NETTY__NAMESPACE_BEGIN
 
@@ -35,10 +41,14 @@ namespace pubsub {
 //     |                           |
 //     +---------- data -----------+
 //
+// Subscription requests (see `subscribe`/`unsubscribe`) are sent to the publisher through
+// the same connection.
+//
 
 template <typename Socket
     , typename ConnectingPoller
     , typename ReaderPoller
+    , typename WriterPoller
     , typename InputController>
 class subscriber: public interruptable
 {
@@ -53,12 +63,21 @@ public:
     using serializer_traits_type = typename input_controller_type::serializer_traits_type;
     using socket_id = typename socket_type::socket_id;
 
+private:
+    using serializer_type = typename serializer_traits_type::serializer_type;
+    using writer_queue_type = writer_queue<serializer_traits_type>;
+    using writer_pool_type = netty::writer_pool<socket_type, WriterPoller, writer_queue_type>;
+
 private:
     connecting_pool_type  _connecting_pool;
     reader_pool_type      _reader_pool;
+    writer_pool_type      _writer_pool;
     socket_pool_type      _socket_pool;
     input_controller_type _input_controller;
 
+    // Topic patterns the subscriber subscribed to
+    std::set<std::string> _subscriptions;
+
 private:
     callback_t<void (std::string const &)> _on_error
         = [] (std::string const & errstr) { LOGE(PUBSUB_TAG, "{}", errstr); };
@@ -86,8 +105,13 @@ public:
             auto saddr = sock.saddr();
 
             _reader_pool.add(sock.id());
+            _writer_pool.add(sock.id());
             _socket_pool.add_connected(std::move(sock));
 
+            // Restore subscriptions
+            for (auto const & pattern: _subscriptions)
+                enqueue_subscription(packet_enum::subscribe, pattern);
+
             if (_on_connected)
                 _on_connected(saddr);
         };
@@ -132,6 +156,23 @@ public:
             return _socket_pool.locate(sid);
         };
 
+        _writer_pool.on_failure = [this] (socket_id sid, netty::error const & err)
+        {
+            _on_error(tr::f_("write to socket failure: #{}: {}", sid, err.what()));
+            close_socket(sid);
+        };
+
+        _writer_pool.on_disconnected = [this] (socket_id sid)
+        {
+            NETTY__TRACE(PUBSUB_TAG, "writer socket disconnected: #{}", sid);
+            close_socket(sid);
+        };
+
+        _writer_pool.locate_socket = [this] (socket_id sid)
+        {
+            return _socket_pool.locate(sid);
+        };
+
         NETTY__TRACE(PUBSUB_TAG, "subscriber constructed");
     }
 
@@ -180,6 +221,20 @@ public: // Set callbacks
         return *this;
     }
 
+    /**
+     * Notify when message with topic received. If not set, `on_data_ready` callback is used for
+     * such messages.
+     *
+     * @details Callback @a f signature must match:
+     *          void (std::string const & topic, archive_type data)
+     */
+    template <typename F>
+    subscriber & on_topic_data_ready (F && f)
+    {
+        _input_controller.on_topic_data_ready = std::forward<F>(f);
+        return *this;
+    }
+
 public:
     /**
      * Connects to publisher.
@@ -197,6 +252,33 @@ public:
         return true;
     }
 
+    /**
+     * Subscribes to the topics matching @a pattern. Pattern ending with '*' matches all topics
+     * with the same prefix.
+     *
+     * @details Subscriptions are restored on reconnection. Not thread-safe: must be called before
+     *          `run()` or from the subscriber's thread (e.g. from callbacks).
+     */
+    void subscribe (std::string const & pattern)
+    {
+        if (pattern.empty())
+            return;
+
+        if (_subscriptions.insert(pattern).second)
+            enqueue_subscription(packet_enum::subscribe, pattern);
+    }
+
+    /**
+     * Unsubscribes from the topics matching @a pattern.
+     *
+     * @details Not thread-safe (see `subscribe`).
+     */
+    void unsubscribe (std::string const & pattern)
+    {
+        if (_subscriptions.erase(pattern) > 0)
+            enqueue_subscription(packet_enum::unsubscribe, pattern);
+    }
+
     /**
      * @return Number of events occurred.
      */
@@ -206,10 +288,12 @@ public:
 
         result += _connecting_pool.step();
         result += _reader_pool.step();
+        result += _writer_pool.step();
 
         // Remove trash
         _connecting_pool.apply_remove();
         _reader_pool.apply_remove();
+        _writer_pool.apply_remove();
         _socket_pool.apply_remove(); // Must be last in the removing sequence
 
         return result;
@@ -229,10 +313,22 @@ public:
     }
 
 private:
+    void enqueue_subscription (packet_enum type, std::string const & pattern)
+    {
+        archive_type ar;
+        serializer_type out {ar};
+        subscription_packet pkt {type, pattern};
+        pkt.serialize(out);
+
+        // At most one publisher connected
+        _writer_pool.enqueue_broadcast(ar.data(), ar.size());
+    }
+
     void close_socket (socket_id sid)
     {
         if (_socket_pool.locate(sid) != nullptr) {
             _reader_pool.remove_later(sid);
+            _writer_pool.remove_later(sid);
             _socket_pool.remove_later(sid);
         }
     }
@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2025.08.10 Initial version.
+//      2026.05.16 Added reader poller for publisher and writer poller for subscriber.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../serializer_traits.hpp"
@@ -32,12 +33,15 @@ using suitable_publisher = netty::pubsub::publisher<
     , Listener
 #if NETTY__EPOLL_ENABLED
     , netty::listener_epoll_poller_t
+    , netty::reader_epoll_poller_t
     , netty::writer_epoll_poller_t
 #elif NETTY__POLL_ENABLED
     , netty::listener_poll_poller_t
+    , netty::reader_poll_poller_t
     , netty::writer_poll_poller_t
 #elif NETTY__SELECT_ENABLED
     , netty::listener_select_poller_t
+    , netty::reader_select_poller_t
     , netty::writer_select_poller_t
 #endif
     , netty::pubsub::writer_queue<SerializerTraits>
@@ -53,12 +57,15 @@ using suitable_subscriber = subscriber<
 #if NETTY__EPOLL_ENABLED
     , netty::connecting_epoll_poller_t
     , netty::reader_epoll_poller_t
+    , netty::writer_epoll_poller_t
 #elif NETTY__POLL_ENABLED
     , netty::connecting_poll_poller_t
     , netty::reader_poll_poller_t
+    , netty::writer_poll_poller_t
 #elif NETTY__SELECT_ENABLED
     , netty::connecting_select_poller_t
     , netty::reader_select_poller_t
+    , netty::writer_select_poller_t
 #endif
     , input_controller<SerializerTraits>>;
 
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.05.16 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "../../namespace.hpp"
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace pubsub {
+
+/**
+ * Topic to subscribers index.
+ *
+ * @details Topic pattern is either an exact topic or a prefix followed by '*' (single '*' matches
+ *          all topics).
+ */
+template <typename SocketId>
+class topic_index
+{
+public:
+    using socket_id = SocketId;
+
+private:
+    using subscribers_type = std::unordered_set<socket_id>;
+
+private:
+    // Exact topic -> subscribers
+    std::unordered_map<std::string, subscribers_type> _exact;
+
+    // Topic prefix (pattern without trailing '*') -> subscribers
+    std::unordered_map<std::string, subscribers_type> _prefixes;
+
+    // Subscriber -> patterns
+    std::unordered_map<socket_id, std::unordered_set<std::string>> _subscriptions;
+
+public:
+    static bool is_prefix_pattern (std::string const & pattern) noexcept
+    {
+        return !pattern.empty() && pattern.back() == '*';
+    }
+
+public:
+    bool empty () const noexcept
+    {
+        return _subscriptions.empty();
+    }
+
+    /**
+     * Checks if subscriber @a sid has at least one subscription.
+     */
+    bool has_subscriptions (socket_id sid) const
+    {
+        return _subscriptions.find(sid) != _subscriptions.end();
+    }
+
+    void subscribe (socket_id sid, std::string const & pattern)
+    {
+        if (pattern.empty())
+            return;
+
+        if (!_subscriptions[sid].insert(pattern).second)
+            return;
+
+        if (is_prefix_pattern(pattern))
+            _prefixes[pattern.substr(0, pattern.size() - 1)].insert(sid);
+        else
+            _exact[pattern].insert(sid);
+    }
+
+    void unsubscribe (socket_id sid, std::string const & pattern)
+    {
+        auto pos = _subscriptions.find(sid);
+
+        if (pos == _subscriptions.end())
+            return;
+
+        if (pos->second.erase(pattern) == 0)
+            return;
+
+        if (pos->second.empty())
+            _subscriptions.erase(pos);
+
+        if (is_prefix_pattern(pattern))
+            erase_subscriber(_prefixes, pattern.substr(0, pattern.size() - 1), sid);
+        else
+            erase_subscriber(_exact, pattern, sid);
+    }
+
+    /**
+     * Removes all subscriptions of subscriber @a sid.
+     */
+    void remove (socket_id sid)
+    {
+        auto pos = _subscriptions.find(sid);
+
+        if (pos == _subscriptions.end())
+            return;
+
+        for (auto const & pattern: pos->second) {
+            if (is_prefix_pattern(pattern))
+                erase_subscriber(_prefixes, pattern.substr(0, pattern.size() - 1), sid);
+            else
+                erase_subscriber(_exact, pattern, sid);
+        }
+
+        _subscriptions.erase(pos);
+    }
+
+    /**
+     * Calls @a f once for each subscriber interested in @a topic.
+     *
+     * @details Callback @a f signature must match:
+     *          void (socket_id)
+     */
+    template <typename F>
+    void match (std::string const & topic, F && f) const
+    {
+        std::vector<socket_id> result;
+
+        auto pos = _exact.find(topic);
+
+        if (pos != _exact.end())
+            result.insert(result.end(), pos->second.begin(), pos->second.end());
+
+        if (!_prefixes.empty()) {
+            std::string prefix;
+            prefix.reserve(topic.size());
+
+            // Check all prefixes of the topic including empty one and the topic itself
+            for (std::size_t i = 0; i <= topic.size(); i++) {
+                auto ppos = _prefixes.find(prefix);
+
+                if (ppos != _prefixes.end())
+                    result.insert(result.end(), ppos->second.begin(), ppos->second.end());
+
+                if (i < topic.size())
+                    prefix.push_back(topic[i]);
+            }
+        }
+
+        std::sort(result.begin(), result.end());
+        auto last = std::unique(result.begin(), result.end());
+
+        for (auto it = result.begin(); it != last; ++it)
+            f(*it);
+    }
+
+private:
+    static void erase_subscriber (std::unordered_map<std::string, subscribers_type> & m
+        , std::string const & key, socket_id sid)
+    {
+        auto pos = m.find(key);
+
+        if (pos != m.end()) {
+            pos->second.erase(sid);
+
+            if (pos->second.empty())
+                m.erase(pos);
+        }
+    }
+};
+
+} // namespace pubsub
+
+NETTY__NAMESPACE_END
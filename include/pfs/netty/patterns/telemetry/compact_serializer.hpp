@@ -0,0 +1,798 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.05.20 Initial version.
+//      2026.05.24 Added `compact_key_value_view_deserializer`.
+//      2026.06.27 Bad key index is reported as error.
+//                 Previous values of the view deserializer are stored in the reusable tables.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "visitor.hpp"
+#include <pfs/assert.hpp>
+#include <pfs/i18n.hpp>
+#include <pfs/numeric_cast.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace telemetry {
+
+//
+// Compact (version 2) encoding of the telemetry batch (one broadcast message).
+//
+// +--------+-----------+--------+-----+--------+
+// | marker | base time | record | ... | record |
+// +--------+-----------+--------+-----+--------+
+//
+// marker    - 1 byte, COMPACT_MARKER (never matches type tag of the plain encoding).
+// base time - varint, milliseconds since epoch of the first sample in the batch.
+//
+// Record:
+// +------+-----+------------+-------+
+// | type | key | time delta | value |
+// +------+-----+------------+-------+
+//
+// type       - 1 byte, type tag (see type_of()).
+// key        - zigzag varint for integer keys; for string keys - varint index in the batch key
+//              table, index equal to the table size introduces a new key followed by varint
+//              length and key bytes.
+// time delta - varint, milliseconds since base time.
+// value      - bool: 1 byte;
+//              integers: zigzag varint of the difference with the previous value of the key;
+//              float32/float64: varint of XOR with the previous value bits of the key;
+//              string: varint length and bytes.
+//
+// Previous value of the key is zero for the first sample of the key in the batch. All state
+// (key table, previous values, base time) is reset at the batch start, so batches are
+// self-contained and can be dropped/conflated by the transport independently.
+//
+
+constexpr std::uint8_t COMPACT_MARKER = 0xC2;
+
+namespace details {
+
+template <typename Serializer>
+void write_varint (Serializer & out, std::uint64_t value)
+{
+    while (value >= 0x80) {
+        out << static_cast<std::uint8_t>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+
+    out << static_cast<std::uint8_t>(value);
+}
+
+template <typename Deserializer>
+std::uint64_t read_varint (Deserializer & in)
+{
+    std::uint64_t result = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        std::uint8_t byte = 0;
+        in >> byte;
+
+        if (!in.is_good())
+            return 0;
+
+        result |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+            break;
+    }
+
+    return result;
+}
+
+inline std::uint64_t zigzag_encode (std::int64_t value) noexcept
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t zigzag_decode (std::uint64_t value) noexcept
+{
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+inline std::uint64_t bits_of (float32_t value) noexcept
+{
+    std::uint32_t bits = 0;
+    std::memcpy(& bits, & value, sizeof(bits));
+    return bits;
+}
+
+inline std::uint64_t bits_of (float64_t value) noexcept
+{
+    std::uint64_t bits = 0;
+    std::memcpy(& bits, & value, sizeof(bits));
+    return bits;
+}
+
+inline void from_bits (std::uint64_t bits, float32_t & value) noexcept
+{
+    auto b = static_cast<std::uint32_t>(bits);
+    std::memcpy(& value, & b, sizeof(value));
+}
+
+inline void from_bits (std::uint64_t bits, float64_t & value) noexcept
+{
+    std::memcpy(& value, & bits, sizeof(value));
+}
+
+template <typename KeyT>
+class compact_key_encoder
+{
+    static_assert(std::is_integral<KeyT>::value, "Integral key type expected");
+
+public:
+    void reset () {}
+
+    template <typename Serializer>
+    void encode (Serializer & out, KeyT const & key)
+    {
+        write_varint(out, zigzag_encode(static_cast<std::int64_t>(key)));
+    }
+};
+
+template <>
+class compact_key_encoder<string_t>
+{
+    std::unordered_map<string_t, std::uint64_t> _keys;
+
+public:
+    void reset ()
+    {
+        _keys.clear();
+    }
+
+    template <typename Serializer>
+    void encode (Serializer & out, string_t const & key)
+    {
+        auto pos = _keys.find(key);
+
+        if (pos != _keys.end()) {
+            write_varint(out, pos->second);
+            return;
+        }
+
+        auto index = static_cast<std::uint64_t>(_keys.size());
+        _keys.emplace(key, index);
+
+        write_varint(out, index);
+        write_varint(out, key.size());
+        out.write(key.data(), key.size());
+    }
+};
+
+template <typename KeyT>
+class compact_key_decoder
+{
+public:
+    void reset () {}
+
+    template <typename Deserializer>
+    bool decode (Deserializer & in, KeyT & key)
+    {
+        key = static_cast<KeyT>(zigzag_decode(read_varint(in)));
+        return in.is_good();
+    }
+};
+
+template <>
+class compact_key_decoder<string_t>
+{
+    std::vector<string_t> _keys;
+
+public:
+    void reset ()
+    {
+        _keys.clear();
+    }
+
+    template <typename Deserializer>
+    bool decode (Deserializer & in, string_t & key)
+    {
+        auto index = read_varint(in);
+
+        if (!in.is_good())
+            return false;
+
+        if (index < _keys.size()) {
+            key = _keys[index];
+            return true;
+        }
+
+        // Bad key index
+        if (index != _keys.size())
+            return false;
+
+        auto size = read_varint(in);
+        key.clear();
+        in.read(key, pfs::numeric_cast<std::size_t>(size));
+
+        if (!in.is_good())
+            return false;
+
+        _keys.push_back(key);
+        return true;
+    }
+};
+
+/**
+ * Raw byte cursor used by the allocation-free decoder.
+ */
+class byte_cursor
+{
+    char const * _p {nullptr};
+    char const * _end {nullptr};
+    bool _good {true};
+
+public:
+    void reset (char const * data, std::size_t size) noexcept
+    {
+        _p = data;
+        _end = data + size;
+        _good = true;
+    }
+
+    bool is_good () const noexcept
+    {
+        return _good;
+    }
+
+    std::size_t available () const noexcept
+    {
+        return static_cast<std::size_t>(_end - _p);
+    }
+
+    std::uint8_t read_byte () noexcept
+    {
+        if (_p == _end) {
+            _good = false;
+            return 0;
+        }
+
+        return static_cast<std::uint8_t>(*_p++);
+    }
+
+    std::uint64_t read_varint () noexcept
+    {
+        std::uint64_t result = 0;
+
+        for (int shift = 0; shift < 64; shift += 7) {
+            auto byte = read_byte();
+
+            if (!_good)
+                return 0;
+
+            result |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0)
+                break;
+        }
+
+        return result;
+    }
+
+    string_view_t read_view (std::uint64_t size) noexcept
+    {
+        if (size > available()) {
+            _good = false;
+            return string_view_t{};
+        }
+
+        string_view_t result {_p, static_cast<std::size_t>(size)};
+        _p += size;
+        return result;
+    }
+};
+
+template <typename KeyT>
+class compact_key_view_decoder
+{
+public:
+    void reset () {}
+
+    bool decode (byte_cursor & in, KeyT & key, std::uint64_t & key_id)
+    {
+        auto value = zigzag_decode(in.read_varint());
+        key = static_cast<KeyT>(value);
+        key_id = static_cast<std::uint64_t>(value);
+        return in.is_good();
+    }
+};
+
+template <>
+class compact_key_view_decoder<string_t>
+{
+    std::vector<string_view_t> _keys;
+
+public:
+    void reset ()
+    {
+        _keys.clear();
+    }
+
+    bool decode (byte_cursor & in, string_view_t & key, std::uint64_t & key_id)
+    {
+        auto index = in.read_varint();
+
+        if (!in.is_good())
+            return false;
+
+        key_id = index;
+
+        if (index < _keys.size()) {
+            key = _keys[index];
+            return true;
+        }
+
+        // Bad key index
+        if (index != _keys.size())
+            return false;
+
+        key = in.read_view(in.read_varint());
+
+        if (!in.is_good())
+            return false;
+
+        _keys.push_back(key);
+        return true;
+    }
+};
+
+/**
+ * Previous value bits by integer key for the allocation-free decoder.
+ *
+ * @details Open addressing table (linear probing) reused by the subsequent batches: values are
+ *          invalidated by the generation increment, slots are never freed.
+ */
+template <typename KeyT>
+class compact_prev_values
+{
+    struct slot
+    {
+        std::uint64_t key_id;
+        std::uint64_t value;
+        std::uint32_t generation;
+    };
+
+private:
+    std::vector<slot> _slots;
+    std::size_t _count {0};
+    std::uint32_t _generation {1};
+
+public:
+    void reset ()
+    {
+        _count = 0;
+
+        if (++_generation == 0) {
+            for (auto & x: _slots)
+                x.generation = 0;
+
+            _generation = 1;
+        }
+    }
+
+    std::uint64_t & at (std::uint64_t key_id)
+    {
+        if (_slots.empty())
+            grow();
+
+        for (;;) {
+            auto mask = _slots.size() - 1;
+
+            for (auto i = hash(key_id) & mask; ; i = (i + 1) & mask) {
+                auto & x = _slots[i];
+
+                if (x.generation == _generation) {
+                    if (x.key_id == key_id)
+                        return x.value;
+
+                    continue;
+                }
+
+                // Load factor is kept below 1/2
+                if ((_count + 1) * 2 > _slots.size())
+                    break;
+
+                x = slot{key_id, 0, _generation};
+                _count++;
+                return x.value;
+            }
+
+            grow();
+        }
+    }
+
+private:
+    static std::size_t hash (std::uint64_t x) noexcept
+    {
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33;
+        return static_cast<std::size_t>(x);
+    }
+
+    void grow ()
+    {
+        std::vector<slot> slots ((std::max)(_slots.size() * 2, std::size_t{16}), slot{0, 0, 0});
+        auto mask = slots.size() - 1;
+
+        for (auto const & x: _slots) {
+            if (x.generation != _generation)
+                continue;
+
+            auto i = hash(x.key_id) & mask;
+
+            while (slots[i].generation == _generation)
+                i = (i + 1) & mask;
+
+            slots[i] = x;
+        }
+
+        _slots.swap(slots);
+    }
+};
+
+/**
+ * Previous value bits by string key index: indices are introduced sequentially by the batch key
+ * table, so values are stored in the flat array which capacity is reused by the subsequent
+ * batches.
+ */
+template <>
+class compact_prev_values<string_t>
+{
+    std::vector<std::uint64_t> _values;
+
+public:
+    void reset ()
+    {
+        _values.clear();
+    }
+
+    std::uint64_t & at (std::uint64_t key_id)
+    {
+        if (key_id >= _values.size())
+            _values.resize(pfs::numeric_cast<std::size_t>(key_id) + 1, 0);
+
+        return _values[key_id];
+    }
+};
+
+// Calls visitor.on_timestamp() if visitor provides it
+template <typename Visitor, typename Key>
+auto visit_timestamp (Visitor & visitor, Key const & key, std::int64_t timestamp, int)
+    -> decltype(visitor.on_timestamp(key, timestamp), void())
+{
+    visitor.on_timestamp(key, timestamp);
+}
+
+template <typename Visitor, typename Key>
+void visit_timestamp (Visitor &, Key const &, std::int64_t, long)
+{}
+
+} // namespace details
+
+/**
+ * Compact telemetry batch encoder.
+ */
+template <typename KeyT, typename Serializer>
+class compact_encoder
+{
+    using key_type = KeyT;
+
+private:
+    bool _started {false};
+    std::int64_t _base_time {0};
+    details::compact_key_encoder<key_type> _key_encoder;
+
+    // Previous value bits by key
+    std::unordered_map<key_type, std::uint64_t> _prev;
+
+public:
+    /**
+     * Starts new batch.
+     */
+    void reset ()
+    {
+        _started = false;
+        _base_time = 0;
+        _key_encoder.reset();
+        _prev.clear();
+    }
+
+    /**
+     * Encodes sample with @a timestamp (milliseconds since epoch).
+     */
+    template <typename T>
+    void encode (Serializer & out, key_type const & key, T const & value, std::int64_t timestamp)
+    {
+        if (!_started) {
+            _started = true;
+            _base_time = timestamp;
+            out << COMPACT_MARKER;
+            details::write_varint(out, static_cast<std::uint64_t>(timestamp));
+        }
+
+        out << type_of<T>();
+        _key_encoder.encode(out, key);
+        details::write_varint(out, timestamp > _base_time
+            ? static_cast<std::uint64_t>(timestamp - _base_time) : 0);
+        encode_value(out, key, value);
+    }
+
+private:
+    void encode_value (Serializer & out, key_type const &, bool value)
+    {
+        out << static_cast<std::uint8_t>(value ? 1 : 0);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, void>::type
+    encode_value (Serializer & out, key_type const & key, T value)
+    {
+        auto & prev = _prev[key];
+        auto bits = static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+        auto delta = static_cast<std::int64_t>(bits - prev);
+        prev = bits;
+        details::write_varint(out, details::zigzag_encode(delta));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, void>::type
+    encode_value (Serializer & out, key_type const & key, T value)
+    {
+        auto & prev = _prev[key];
+        auto bits = details::bits_of(value);
+        details::write_varint(out, bits ^ prev);
+        prev = bits;
+    }
+
+    void encode_value (Serializer & out, key_type const &, string_t const & value)
+    {
+        details::write_varint(out, value.size());
+        out.write(value.data(), value.size());
+    }
+};
+
+/**
+ * Compact telemetry batch decoder.
+ */
+template <typename KeyT, typename Deserializer>
+class compact_key_value_deserializer
+{
+    using key_type = KeyT;
+    using visitor_type = visitor_interface<KeyT>;
+
+private:
+    details::compact_key_decoder<key_type> _key_decoder;
+    std::unordered_map<key_type, std::uint64_t> _prev;
+
+public:
+    compact_key_value_deserializer (char const * data, std::size_t size
+        , std::shared_ptr<visitor_type> visitor)
+    {
+        Deserializer in {data, size};
+        std::uint8_t marker = 0;
+
+        in >> marker;
+
+        if (marker != COMPACT_MARKER) {
+            visitor->on_error(tr::f_("bad compact telemetry marker: 0x{:0X}", marker));
+            return;
+        }
+
+        auto base_time = static_cast<std::int64_t>(details::read_varint(in));
+
+        while (in.is_good() && in.available() > 0) {
+            std::int8_t type = 0;
+            key_type key;
+
+            in >> type;
+
+            if (!_key_decoder.decode(in, key)) {
+                if (in.is_good()) {
+                    visitor->on_error(tr::_("bad compact telemetry key index"));
+                    return;
+                }
+
+                break;
+            }
+
+            auto timestamp = base_time + static_cast<std::int64_t>(details::read_varint(in));
+
+            switch (type) {
+                case type_of<string_t>():  read_and_visit<string_t>(in, key, timestamp, visitor); break;
+                case type_of<bool>():      read_and_visit<bool>(in, key, timestamp, visitor); break;
+                case type_of<int8_t>():    read_and_visit<int8_t>(in, key, timestamp, visitor); break;
+                case type_of<int16_t>():   read_and_visit<int16_t>(in, key, timestamp, visitor); break;
+                case type_of<int32_t>():   read_and_visit<int32_t>(in, key, timestamp, visitor); break;
+                case type_of<int64_t>():   read_and_visit<int64_t>(in, key, timestamp, visitor); break;
+                case type_of<float32_t>(): read_and_visit<float32_t>(in, key, timestamp, visitor); break;
+                case type_of<float64_t>(): read_and_visit<float64_t>(in, key, timestamp, visitor); break;
+                default:
+                    visitor->on_error(tr::f_("unsupported telemetry type={}", type));
+                    return;
+            }
+        }
+
+        PFS__THROW_UNEXPECTED(in.is_good(), "bad or corrupted telemetry data received");
+    }
+
+private:
+    template <typename T>
+    void read_and_visit (Deserializer & in, key_type const & key, std::int64_t timestamp
+        , std::shared_ptr<visitor_type> & visitor)
+    {
+        T value;
+        decode_value(in, key, value);
+
+        if (in.is_good()) {
+            visitor->on_timestamp(key, timestamp);
+            visitor->on(key, value);
+        }
+    }
+
+    void decode_value (Deserializer & in, key_type const &, bool & value)
+    {
+        std::uint8_t byte = 0;
+        in >> byte;
+        value = (byte != 0);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, void>::type
+    decode_value (Deserializer & in, key_type const & key, T & value)
+    {
+        auto delta = details::zigzag_decode(details::read_varint(in));
+        auto & prev = _prev[key];
+        prev += static_cast<std::uint64_t>(delta);
+        value = static_cast<T>(static_cast<std::int64_t>(prev));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, void>::type
+    decode_value (Deserializer & in, key_type const & key, T & value)
+    {
+        auto & prev = _prev[key];
+        prev ^= details::read_varint(in);
+        details::from_bits(prev, value);
+    }
+
+    void decode_value (Deserializer & in, key_type const &, string_t & value)
+    {
+        auto size = details::read_varint(in);
+        value.clear();
+        in.read(value, pfs::numeric_cast<std::size_t>(size));
+    }
+};
+
+/**
+ * Devirtualized and allocation-free variant of compact_key_value_deserializer.
+ *
+ * @details Visitor requirements are the same as for key_value_view_deserializer,
+ *          `on_timestamp(key, timestamp)` method is optional. String keys and values are
+ *          passed as string_view_t pointing into the input buffer. Decoder state is reused by
+ *          subsequent calls, so the instance is intended to live as long as the consumer.
+ */
+template <typename KeyT>
+class compact_key_value_view_deserializer
+{
+    using key_type = typename view_key<KeyT>::type;
+
+private:
+    details::byte_cursor _in;
+    details::compact_key_view_decoder<KeyT> _key_decoder;
+
+    // Previous value bits by key identifier (integer key or string key index)
+    details::compact_prev_values<KeyT> _prev;
+
+public:
+    template <typename Visitor>
+    void decode (char const * data, std::size_t size, Visitor & visitor)
+    {
+        _in.reset(data, size);
+        _key_decoder.reset();
+        _prev.reset();
+
+        auto marker = _in.read_byte();
+
+        if (marker != COMPACT_MARKER) {
+            visitor.on_error(tr::f_("bad compact telemetry marker: 0x{:0X}", marker));
+            return;
+        }
+
+        auto base_time = static_cast<std::int64_t>(_in.read_varint());
+
+        while (_in.is_good() && _in.available() > 0) {
+            auto type = static_cast<std::int8_t>(_in.read_byte());
+            key_type key;
+            std::uint64_t key_id = 0;
+
+            if (!_key_decoder.decode(_in, key, key_id)) {
+                if (_in.is_good()) {
+                    visitor.on_error(tr::_("bad compact telemetry key index"));
+                    return;
+                }
+
+                break;
+            }
+
+            auto timestamp = base_time + static_cast<std::int64_t>(_in.read_varint());
+
+            switch (type) {
+                case type_of<string_t>():  read_and_visit<string_view_t>(key, key_id, timestamp, visitor); break;
+                case type_of<bool>():      read_and_visit<bool>(key, key_id, timestamp, visitor); break;
+                case type_of<int8_t>():    read_and_visit<int8_t>(key, key_id, timestamp, visitor); break;
+                case type_of<int16_t>():   read_and_visit<int16_t>(key, key_id, timestamp, visitor); break;
+                case type_of<int32_t>():   read_and_visit<int32_t>(key, key_id, timestamp, visitor); break;
+                case type_of<int64_t>():   read_and_visit<int64_t>(key, key_id, timestamp, visitor); break;
+                case type_of<float32_t>(): read_and_visit<float32_t>(key, key_id, timestamp, visitor); break;
+                case type_of<float64_t>(): read_and_visit<float64_t>(key, key_id, timestamp, visitor); break;
+                default:
+                    visitor.on_error(tr::f_("unsupported telemetry type={}", type));
+                    return;
+            }
+        }
+
+        PFS__THROW_UNEXPECTED(_in.is_good(), "bad or corrupted telemetry data received");
+    }
+
+private:
+    template <typename T, typename Visitor>
+    void read_and_visit (key_type const & key, std::uint64_t key_id, std::int64_t timestamp
+        , Visitor & visitor)
+    {
+        T value;
+        decode_value(key_id, value);
+
+        if (_in.is_good()) {
+            details::visit_timestamp(visitor, key, timestamp, 0);
+            visitor.on(key, value);
+        }
+    }
+
+    void decode_value (std::uint64_t, bool & value)
+    {
+        value = (_in.read_byte() != 0);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, void>::type
+    decode_value (std::uint64_t key_id, T & value)
+    {
+        auto delta = details::zigzag_decode(_in.read_varint());
+        auto & prev = _prev.at(key_id);
+        prev += static_cast<std::uint64_t>(delta);
+        value = static_cast<T>(static_cast<std::int64_t>(prev));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, void>::type
+    decode_value (std::uint64_t key_id, T & value)
+    {
+        auto & prev = _prev.at(key_id);
+        prev ^= _in.read_varint();
+        details::from_bits(prev, value);
+    }
+
+    void decode_value (std::uint64_t, string_view_t & value)
+    {
+        value = _in.read_view(_in.read_varint());
+    }
+};
+
+} // namespace telemetry
+
+NETTY__NAMESPACE_END
@@ -5,10 +5,13 @@
 //
 // Changelog:
 //      2025.07.29 Initial version.
+//      2026.05.20 Added compact encoding support.
+//      2026.05.24 Added static (devirtualized) visitor support.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../callback.hpp"
 #include "../../socket4_addr.hpp"
+#include "compact_serializer.hpp"
 #include "serializer.hpp"
 #include "visitor.hpp"
 #include "tag.hpp"
@@ -29,12 +32,20 @@ class consumer
     using archive_type = typename serializer_traits_type::archive_type;
     using deserializer_type = typename serializer_traits_type::deserializer_type;
     using key_value_deserializer_type = key_value_deserializer<KeyT, deserializer_type>;
+    using compact_key_value_deserializer_type = compact_key_value_deserializer<KeyT, deserializer_type>;
+    using key_value_view_deserializer_type = key_value_view_deserializer<KeyT, deserializer_type>;
+    using compact_key_value_view_deserializer_type = compact_key_value_view_deserializer<KeyT>;
     using key_type = KeyT;
     using visitor_type = visitor_interface<KeyT>;
 
 private:
     subscriber_type _sub;
     std::shared_ptr<visitor_type> _visitor;
+    key_value_view_deserializer_type _view_deserializer;
+    compact_key_value_view_deserializer_type _compact_view_deserializer;
+
+    // Decodes data with the static visitor (if set)
+    callback_t<void (char const *, std::size_t)> _static_decode;
 
 private: // Callbacks
     callback_t<void (std::string const &)> _on_error
@@ -44,7 +55,18 @@ public:
     consumer ()
     {
         _sub.on_data_ready([this] (archive_type data) {
-            key_value_deserializer_type{data.data(), data.size(), _visitor};
+            if (data.empty())
+                return;
+
+            if (_static_decode) {
+                _static_decode(data.data(), data.size());
+                return;
+            }
+
+            if (static_cast<std::uint8_t>(data.data()[0]) == COMPACT_MARKER)
+                compact_key_value_deserializer_type{data.data(), data.size(), _visitor};
+            else
+                key_value_deserializer_type{data.data(), data.size(), _visitor};
         });
     }
 
@@ -89,6 +111,29 @@ public:
         _visitor = v;
     }
 
+    /**
+     * Sets visitor called directly (without virtual dispatch) by the allocation-free decoders.
+     * Takes precedence over the visitor set by set_visitor().
+     *
+     * @details Visitor requirements see key_value_view_deserializer. String keys and values
+     *          passed to the visitor are valid during the call only.
+     */
+    template <typename Visitor>
+    void set_static_visitor (std::shared_ptr<Visitor> v)
+    {
+        if (!v) {
+            _static_decode = nullptr;
+            return;
+        }
+
+        _static_decode = [this, v] (char const * data, std::size_t size) {
+            if (static_cast<std::uint8_t>(data[0]) == COMPACT_MARKER)
+                _compact_view_deserializer.decode(data, size, *v);
+            else
+                _view_deserializer.decode(data, size, *v);
+        };
+    }
+
     /**
      * Connects to publisher.
      *
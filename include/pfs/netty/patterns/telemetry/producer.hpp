@@ -5,16 +5,25 @@
 //
 // Changelog:
 //      2025.07.29 Initial version.
+//      2026.05.18 Added conflating mode and last-value cache.
+//      2026.05.20 Added compact encoding.
+//      2026.05.22 Added staging mode (lock-free push from multiple threads).
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../listener_options.hpp"
+#include "../../mpsc_queue.hpp"
 #include "../../socket4_addr.hpp"
+#include "compact_serializer.hpp"
 #include "serializer.hpp"
 #include "tag.hpp"
 #include "types.hpp"
 #include <pfs/log.hpp>
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 NETTY__NAMESPACE_BEGIN
 
@@ -36,15 +45,52 @@ private:
     using archive_type = typename serializer_traits_type::archive_type;
     using serializer_type = typename serializer_traits_type::serializer_type;
     using key_value_serializer_type = key_value_serializer<KeyT, serializer_type>;
+    using compact_encoder_type = compact_encoder<KeyT, serializer_type>;
     using writer_mutex_type = RecursiveWriterMutex;
 
+    // Latest value of the key
+    struct slot
+    {
+        std::int8_t type {0};
+        std::int64_t ivalue {0};    // bool and integer values
+        float64_t fvalue {0};       // float32 and float64 values
+        string_t svalue;
+        std::int64_t timestamp {0}; // Milliseconds since epoch (compact encoding only)
+        bool dirty {false};         // Value is not broadcasted yet (conflating mode)
+    };
+
+    using slot_map_type = std::unordered_map<key_type, slot>;
+
+    // Value pushed in staging mode
+    struct staged_record
+    {
+        key_type key;
+        slot value;
+    };
+
 private:
     publisher_type _pub;
     archive_type _ar;
+    encoding_enum _encoding {encoding_enum::plain};
+    compact_encoder_type _encoder;
 
     // Writer mutex to protect sending
     writer_mutex_type _writer_mtx;
 
+    // Latest values by key (used in conflating mode and as last-value cache)
+    slot_map_type _slots;
+    std::vector<typename slot_map_type::value_type *> _dirty_slots;
+    // Values pushed in staging mode, drained by `broadcast()`/`step()`
+    mpsc_queue<staged_record> _staged;
+    std::atomic_bool _staging {false};
+
+    bool _conflating {false};
+    bool _cache_enabled {false};
+
+    // Protects slots, modes and encoding. Never locked while calling the publisher, so can be locked from
+    // the publisher's thread (snapshot callback) without deadlock.
+    std::mutex _slots_mtx;
+
 private: // Callbacks
     callback_t<void (std::string const &)> _on_error
         = [] (std::string const & errstr) { LOGE(TELEMETRY_TAG, "{}", errstr); };
@@ -52,7 +98,19 @@ private: // Callbacks
 public:
     producer (listener_options const & opts)
         : _pub(opts)
-    {}
+    {
+        _pub.on_snapshot([this] (archive_type & snapshot) {
+            std::unique_lock<std::mutex> locker{_slots_mtx};
+
+            if (!_cache_enabled)
+                return;
+
+            compact_encoder_type encoder;
+
+            for (auto const & x: _slots)
+                encode_slot(snapshot, encoder, x.first, x.second);
+        });
+    }
 
 public: // Set callbacks
     /**
@@ -82,30 +140,109 @@ public:
         _pub.listen();
     }
 
+    /**
+     * Sets wire encoding. Consumer detects encoding automatically.
+     */
+    void set_encoding (encoding_enum encoding)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+
+        // Send the data already encoded
+        if (!_ar.empty())
+            broadcast_unsafe();
+
+        std::unique_lock<std::mutex> slots_locker{_slots_mtx};
+        _encoding = encoding;
+    }
+
+    /**
+     * Enables/disables conflating mode. In conflating mode only the latest value per key pushed
+     * between broadcasts is sent.
+     */
+    void set_conflating (bool enable)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        std::unique_lock<std::mutex> slots_locker{_slots_mtx};
+
+        if (_conflating && !enable)
+            flush_dirty_slots();
+
+        _conflating = enable;
+        shrink_slots();
+    }
+
+    /**
+     * Enables/disables last-value cache. If enabled, the newly accepted consumer immediately
+     * receives the latest values of all keys.
+     */
+    void set_last_value_cache (bool enable)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        std::unique_lock<std::mutex> slots_locker{_slots_mtx};
+        _cache_enabled = enable;
+        shrink_slots();
+    }
+
+    /**
+     * Enables/disables staging mode. In staging mode `push()` does not lock the writer mutex:
+     * values are queued (wait-free apart from memory allocation) and merged by `broadcast()` or
+     * `step()`.
+     */
+    void set_staging (bool enable)
+    {
+        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
+        _staging.store(enable, std::memory_order_release);
+
+        if (!enable)
+            drain_staged_unsafe();
+    }
+
     template <typename T>
     void push (key_type const & key, T const & value)
     {
+        if (_staging.load(std::memory_order_acquire)) {
+            stage(key, value);
+            return;
+        }
+
         std::unique_lock<writer_mutex_type> locker{_writer_mtx};
         push_unsafe(key, value);
     }
 
     void push (key_type const & key, char const * value)
     {
-        std::unique_lock<writer_mutex_type> locker{_writer_mtx};
-        push_unsafe(key, value);
+        push(key, std::string(value));
     }
 
     template <typename T>
     void push_unsafe (key_type const & key, T const & value)
     {
-        serializer_type out {_ar};
-        key_value_serializer_type(out, key, value);
+        // Modes are changed with writer mutex locked, so can be checked without slots mutex
+        auto timestamp = _encoding == encoding_enum::compact ? now() : std::int64_t{0};
+
+        if (_conflating || _cache_enabled) {
+            std::unique_lock<std::mutex> slots_locker{_slots_mtx};
+            auto & item = *_slots.emplace(key, slot{}).first;
+            auto & s = item.second;
+            assign(s, value);
+            s.timestamp = timestamp;
+
+            if (_conflating) {
+                if (!s.dirty) {
+                    s.dirty = true;
+                    _dirty_slots.push_back(& item);
+                }
+
+                return;
+            }
+        }
+
+        encode(_ar, _encoder, key, value, timestamp);
     }
 
     void push_unsafe (key_type const & key, char const * value)
     {
-        serializer_type out {_ar};
-        key_value_serializer_type(out, key, std::string(value));
+        push_unsafe(key, std::string(value));
     }
 
     void broadcast ()
@@ -116,8 +253,16 @@ public:
 
     void broadcast_unsafe ()
     {
+        drain_staged_unsafe();
+
+        if (_conflating) {
+            std::unique_lock<std::mutex> slots_locker{_slots_mtx};
+            flush_dirty_slots();
+        }
+
         _pub.broadcast(_ar.data(), _ar.size());
         _ar.clear();
+        _encoder.reset();
     }
 
     template <typename T>
@@ -130,8 +275,7 @@ public:
     template <typename T>
     void broadcast_unsafe (key_type const & key, T const & value)
     {
-        serializer_type out {_ar};
-        key_value_serializer_type(out, key, value);
+        push_unsafe(key, value);
         broadcast_unsafe();
     }
 
@@ -146,7 +290,7 @@ public:
     unsigned int step ()
     {
         std::unique_lock<writer_mutex_type> locker{_writer_mtx};
-        return _pub.step_unsafe();
+        return step_unsafe();
     }
 
     /**
@@ -154,6 +298,7 @@ public:
      */
     unsigned int step_unsafe ()
     {
+        drain_staged_unsafe();
         return _pub.step_unsafe();
     }
 
@@ -161,6 +306,131 @@ public:
     {
         _pub.run(loop_interval);
     }
+
+private:
+    static std::int64_t now ()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static void assign (slot & s, bool value)
+    {
+        s.type = type_of<bool>();
+        s.ivalue = value ? 1 : 0;
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value, void>::type
+    assign (slot & s, T value)
+    {
+        s.type = type_of<T>();
+        s.ivalue = value;
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, void>::type
+    assign (slot & s, T value)
+    {
+        s.type = type_of<T>();
+        s.fvalue = value;
+    }
+
+    static void assign (slot & s, string_t const & value)
+    {
+        s.type = type_of<string_t>();
+        s.svalue = value;
+    }
+
+    template <typename T>
+    void encode (archive_type & ar, compact_encoder_type & encoder, key_type const & key
+        , T const & value, std::int64_t timestamp)
+    {
+        serializer_type out {ar};
+
+        if (_encoding == encoding_enum::compact)
+            encoder.encode(out, key, value, timestamp);
+        else
+            key_value_serializer_type(out, key, value);
+    }
+
+    void encode_slot (archive_type & ar, compact_encoder_type & encoder, key_type const & key
+        , slot const & s)
+    {
+        switch (s.type) {
+            case type_of<bool>():      encode(ar, encoder, key, s.ivalue != 0, s.timestamp); break;
+            case type_of<int8_t>():    encode(ar, encoder, key, static_cast<int8_t>(s.ivalue), s.timestamp); break;
+            case type_of<int16_t>():   encode(ar, encoder, key, static_cast<int16_t>(s.ivalue), s.timestamp); break;
+            case type_of<int32_t>():   encode(ar, encoder, key, static_cast<int32_t>(s.ivalue), s.timestamp); break;
+            case type_of<int64_t>():   encode(ar, encoder, key, static_cast<int64_t>(s.ivalue), s.timestamp); break;
+            case type_of<float32_t>(): encode(ar, encoder, key, static_cast<float32_t>(s.fvalue), s.timestamp); break;
+            case type_of<float64_t>(): encode(ar, encoder, key, s.fvalue, s.timestamp); break;
+            case type_of<string_t>():  encode(ar, encoder, key, s.svalue, s.timestamp); break;
+            default: break;
+        }
+    }
+
+    template <typename T>
+    void stage (key_type const & key, T const & value)
+    {
+        staged_record rec;
+        rec.key = key;
+        assign(rec.value, value);
+        rec.value.timestamp = now();
+        _staged.push(std::move(rec));
+    }
+
+    void drain_staged_unsafe ()
+    {
+        _staged.drain([this] (staged_record && rec) {
+            apply_unsafe(rec.key, std::move(rec.value));
+        });
+    }
+
+    // Same as `push_unsafe` for the typed value
+    void apply_unsafe (key_type const & key, slot && value)
+    {
+        if (_conflating || _cache_enabled) {
+            std::unique_lock<std::mutex> slots_locker{_slots_mtx};
+            auto & item = *_slots.emplace(key, slot{}).first;
+            auto & s = item.second;
+            auto dirty = s.dirty;
+
+            s = std::move(value);
+            s.dirty = dirty;
+
+            if (_conflating) {
+                if (!s.dirty) {
+                    s.dirty = true;
+                    _dirty_slots.push_back(& item);
+                }
+            } else {
+                encode_slot(_ar, _encoder, key, s);
+            }
+
+            return;
+        }
+
+        encode_slot(_ar, _encoder, key, value);
+    }
+
+    // Must be called with _slots_mtx locked
+    void flush_dirty_slots ()
+    {
+        for (auto * item: _dirty_slots) {
+            encode_slot(_ar, _encoder, item->first, item->second);
+            item->second.dirty = false;
+        }
+
+        _dirty_slots.clear();
+    }
+
+    // Must be called with _slots_mtx locked
+    void shrink_slots ()
+    {
+        if (!_conflating && !_cache_enabled)
+            _slots.clear();
+    }
 };
 
 } // namespace telemetry
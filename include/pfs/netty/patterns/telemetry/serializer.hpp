@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2025.08.07 Initial version.
+//      2026.05.24 Added `key_value_view_deserializer`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "visitor.hpp"
@@ -164,6 +165,103 @@ private:
     }
 };
 
+/**
+ * Devirtualized and allocation-free variant of key_value_deserializer.
+ *
+ * @details Visitor is any class providing `on(key, value)` overloads for bool, int8_t ... int64_t,
+ *          float32_t, float64_t and string_view_t values and `on_error(std::string const &)`
+ *          method. Methods are called directly (can be inlined). String keys and values are
+ *          passed as string_view_t pointing into the input buffer, so they are valid during the
+ *          call only. Key type passed to the visitor is `view_key<KeyT>::type`.
+ */
+template <typename KeyT, typename Deserializer>
+class key_value_view_deserializer
+{
+    using key_type = typename view_key<KeyT>::type;
+
+private:
+    char const * _data {nullptr};
+    std::size_t _size {0};
+    std::size_t _pos {0};
+    bool _good {true};
+
+public:
+    template <typename Visitor>
+    void decode (char const * data, std::size_t size, Visitor & visitor)
+    {
+        _data = data;
+        _size = size;
+        _pos = 0;
+        _good = true;
+
+        while (_good && _pos < _size) {
+            std::int8_t type = 0;
+            key_type key;
+
+            read(type);
+            read(key);
+
+            if (!_good)
+                break;
+
+            switch (type) {
+                case type_of<string_t>():  read_and_visit<string_view_t>(key, visitor); break;
+                case type_of<bool>():      read_and_visit<bool>(key, visitor); break;
+                case type_of<int8_t>():    read_and_visit<int8_t>(key, visitor); break;
+                case type_of<int16_t>():   read_and_visit<int16_t>(key, visitor); break;
+                case type_of<int32_t>():   read_and_visit<int32_t>(key, visitor); break;
+                case type_of<int64_t>():   read_and_visit<int64_t>(key, visitor); break;
+                case type_of<float32_t>(): read_and_visit<float32_t>(key, visitor); break;
+                case type_of<float64_t>(): read_and_visit<float64_t>(key, visitor); break;
+                default:
+                    visitor.on_error(tr::f_("unsupported telemetry type={}", type));
+                    return;
+            }
+        }
+
+        PFS__THROW_UNEXPECTED(_good, "bad or corrupted telemetry data received");
+    }
+
+private:
+    template <typename T>
+    void read (T & value)
+    {
+        Deserializer in {_data + _pos, _size - _pos};
+        in >> value;
+        _good = in.is_good();
+
+        if (_good)
+            _pos = _size - in.available();
+    }
+
+    void read (string_view_t & value)
+    {
+        std::uint16_t n = 0;
+        read(n);
+
+        if (!_good)
+            return;
+
+        if (_size - _pos < n) {
+            _good = false;
+            return;
+        }
+
+        value = string_view_t{_data + _pos, n};
+        _pos += n;
+    }
+
+    template <typename T, typename Visitor>
+    void read_and_visit (key_type const & key, Visitor & visitor)
+    {
+        T value;
+        read(value);
+
+        if (_good)
+            visitor.on(key, value);
+    }
+};
+
 } // namespace telemetry
 
 NETTY__NAMESPACE_END
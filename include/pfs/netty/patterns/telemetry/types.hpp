@@ -5,9 +5,12 @@
 //
 // Changelog:
 //      2025.07.29 Initial version.
+//      2026.05.20 Added `encoding_enum`.
+//      2026.05.24 Added `string_view_t` and `view_key`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "../../namespace.hpp"
+#include <pfs/string_view.hpp>
 #include <cstdint>
 #include <string>
 
@@ -22,6 +25,7 @@ using int64_t = std::int64_t;
 using float32_t = float;
 using float64_t = double;
 using string_t = std::string;
+using string_view_t = pfs::string_view;
 
 static_assert(sizeof(float32_t) == 4, "Expected size of float32_t 4 bytes");
 static_assert(sizeof(float64_t) == 8, "Expected size of float64_t 8 bytes");
@@ -38,6 +42,26 @@ template <> constexpr std::int8_t type_of<float32_t> () noexcept { return 6; }
 template <> constexpr std::int8_t type_of<float64_t> () noexcept { return 7; }
 template <> constexpr std::int8_t type_of<string_t> () noexcept  { return 8; }
 
+/// Key type passed to the static visitor (string keys are passed as views)
+template <typename KeyT>
+struct view_key
+{
+    using type = KeyT;
+};
+
+template <>
+struct view_key<string_t>
+{
+    using type = string_view_t;
+};
+
+/// Telemetry wire encoding
+enum class encoding_enum
+{
+      plain = 1   /// Type tag, full-width key and value for each sample
+    , compact = 2 /// Batch-scoped key interning, varints, delta/XOR values and timestamps
+};
+
 } // namespace telemetry
 
 NETTY__NAMESPACE_END
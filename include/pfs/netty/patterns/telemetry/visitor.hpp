@@ -5,9 +5,11 @@
 //
 // Changelog:
 //      2025.08.05 Initial version.
+//      2026.05.20 Added `on_timestamp` method.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "types.hpp"
+#include <cstdint>
 #include <string>
 
 NETTY__NAMESPACE_BEGIN
@@ -30,6 +32,12 @@ public:
     virtual void on (key_type const & key, float64_t value) = 0;
     virtual void on (key_type const & key, string_t const & value) = 0;
 
+    /**
+     * Called before `on()` with the sample time (milliseconds since epoch) if encoding
+     * provides it (compact encoding).
+     */
+    virtual void on_timestamp (key_type const & /*key*/, std::int64_t /*msecs*/) {}
+
     virtual void on_error (std::string const & errstr) = 0;
 };
 
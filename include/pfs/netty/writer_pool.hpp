@@ -7,6 +7,10 @@
 //      2024.12.27 Initial version.
 //      2025.05.07 Replaced `std::function` with `callback_t`.
 //      2025.06.30 Method `ensure()` renamed to `set_frame_size()`.
+//      2026.05.12 Added queue limits and watermark callbacks.
+//      2026.05.14 Added `on_queue_overflow` callback.
+//      2026.06.09 Added `on_frame_sent` callback.
+//      2026.06.27 Added enqueue with the conflation key.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "namespace.hpp"
@@ -15,6 +19,7 @@
 #include "send_result.hpp"
 #include "tag.hpp"
 #include "trace.hpp"
+#include "writer_queue_limits.hpp"
 #include <pfs/assert.hpp>
 #include <pfs/i18n.hpp>
 #include <pfs/stopwatch.hpp>
@@ -24,6 +29,7 @@
 #include <cstring>
 #include <functional>
 #include <limits>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -76,6 +82,9 @@ private:
         time_point_type writable_time_point;
         std::uint16_t writable_counter {0};
 
+        // High watermark reached (queue is congested)
+        bool queue_high {false};
+
         bandwidth_data bwd;
     };
 
@@ -85,6 +94,7 @@ private:
 
     bandwidth_throttling _default_throttling {bandwidth_throttling::adaptive};
     std::size_t _default_rate_limit = (std::numeric_limits<std::size_t>::max)();
+    writer_queue_limits _default_queue_limits;
 
 public:
     mutable callback_t<void (socket_id, error const &)> on_failure = [] (socket_id, error const &) {};
@@ -95,6 +105,18 @@ public:
     };
     mutable callback_t<void (socket_id, std::size_t)> on_data_rate;
 
+    // Called when queued bytes for the socket reach the high watermark
+    mutable callback_t<void (socket_id, std::size_t /*bytes*/)> on_queue_high;
+
+    // Called when queued bytes for the congested socket fall to the low watermark
+    mutable callback_t<void (socket_id, std::size_t /*bytes*/)> on_queue_low;
+
+    // Called when message rejected or some messages dropped according to the queue limits
+    mutable callback_t<void (socket_id, queue_occupancy const &)> on_queue_overflow;
+
+    // Called when frame (or part of it) sent successfully
+    mutable callback_t<void (socket_id, std::size_t /*bytes*/)> on_frame_sent;
+
 public:
     writer_pool (bandwidth_throttling default_throttling = bandwidth_throttling::adaptive
         , std::size_t default_rate_limit = (std::numeric_limits<std::size_t>::max)())
@@ -197,6 +219,58 @@ public:
         }
     }
 
+    /**
+     * Returns default output queue limits.
+     */
+    writer_queue_limits const & queue_limits () const noexcept
+    {
+        return _default_queue_limits;
+    }
+
+    /**
+     * Sets default output queue limits and associates them with all existing socket IDs.
+     */
+    void set_queue_limits (writer_queue_limits const & limits)
+    {
+        _default_queue_limits = limits;
+
+        for (auto & x: _accounts)
+            x.second.q.set_limits(limits);
+    }
+
+    /**
+     * Associates output queue limits with specified socket ID @a sid.
+     */
+    void set_queue_limits (socket_id sid, writer_queue_limits const & limits)
+    {
+        auto pacc = locate_account(sid);
+
+        if (pacc != nullptr)
+            pacc->q.set_limits(limits);
+    }
+
+    /**
+     * Returns output queue occupancy for specified socket ID @a sid.
+     */
+    queue_occupancy occupancy (socket_id sid)
+    {
+        auto pacc = locate_account(sid);
+        return pacc != nullptr ? pacc->q.occupancy() : queue_occupancy{};
+    }
+
+    /**
+     * Iterates over output queues occupancy.
+     *
+     * @details Callback @a f signature must match:
+     *          void (socket_id, queue_occupancy const &)
+     */
+    template <typename F>
+    void for_each_occupancy (F && f) const
+    {
+        for (auto const & x: _accounts)
+            f(x.first, x.second.q.occupancy());
+    }
+
     void add (socket_id sid)
     {
         (void)ensure_account(sid);
@@ -219,36 +293,66 @@ public:
         }
     }
 
-    void enqueue (socket_id sid, int priority, char const * data, std::size_t len)
+    /**
+     * Enqueues data to send.
+     *
+     * @return Output queue occupancy, queue_occupancy::accepted is @c false if data rejected
+     *         according to the queue limits.
+     */
+    queue_occupancy enqueue (socket_id sid, int priority, char const * data, std::size_t len)
     {
         check_priority(priority);
 
         if (len == 0)
-            return;
+            return queue_occupancy{};
 
         auto acc = ensure_account(sid);
-        acc->q.enqueue(priority, data, len);
+        auto occupancy = acc->q.enqueue(priority, data, len);
+        check_occupancy(*acc, occupancy);
+        return occupancy;
     }
 
-    void enqueue (socket_id sid, char const * data, std::size_t len)
+    queue_occupancy enqueue (socket_id sid, char const * data, std::size_t len)
     {
-        enqueue(sid, 0, data, len);
+        return enqueue(sid, 0, data, len);
     }
 
-    void enqueue (socket_id sid, int priority, archive_type data)
+    /**
+     * Enqueues data with the conflation @a key: on overflow with queue_overflow_policy::conflate
+     * only pending messages with the same key are dropped.
+     *
+     * @note Writer queue must support conflation keys.
+     */
+    queue_occupancy enqueue (socket_id sid, int priority, char const * data, std::size_t len
+        , std::string const & key)
+    {
+        check_priority(priority);
+
+        if (len == 0)
+            return queue_occupancy{};
+
+        auto acc = ensure_account(sid);
+        auto occupancy = acc->q.enqueue(priority, data, len, key);
+        check_occupancy(*acc, occupancy);
+        return occupancy;
+    }
+
+    queue_occupancy enqueue (socket_id sid, int priority, archive_type data)
     {
         check_priority(priority);
 
         if (data.empty())
-            return;
+            return queue_occupancy{};
 
         auto acc = ensure_account(sid);
-        acc->q.enqueue(priority, std::move(data));
+        auto occupancy = acc->q.enqueue(priority, std::move(data));
+        check_occupancy(*acc, occupancy);
+        return occupancy;
     }
 
-    void enqueue (socket_id sid, archive_type data)
+    queue_occupancy enqueue (socket_id sid, archive_type data)
     {
-        enqueue(sid, 0, std::move(data));
+        return enqueue(sid, 0, std::move(data));
     }
 
     /**
@@ -353,6 +457,8 @@ private:
                     break;
             }
 
+            a.q.set_limits(_default_queue_limits);
+
             auto res = _accounts.emplace(sid, std::move(a));
 
             acc = & res.first->second;
@@ -382,6 +488,37 @@ private:
         acc.bwd.tune_frame_size = tune_frame_size_adaptive;
     }
 
+    void check_occupancy (account & acc, queue_occupancy const & occupancy)
+    {
+        if (!occupancy.accepted || occupancy.dropped > 0) {
+            if (on_queue_overflow)
+                on_queue_overflow(acc.sid, occupancy);
+        }
+
+        auto high_watermark = acc.q.limits().high_watermark;
+
+        if (high_watermark > 0 && !acc.queue_high && occupancy.bytes >= high_watermark) {
+            acc.queue_high = true;
+
+            if (on_queue_high)
+                on_queue_high(acc.sid, occupancy.bytes);
+        }
+    }
+
+    void check_low_watermark (account & acc)
+    {
+        if (acc.queue_high) {
+            auto bytes = acc.q.occupancy().bytes;
+
+            if (bytes <= acc.q.limits().low_watermark) {
+                acc.queue_high = false;
+
+                if (on_queue_low)
+                    on_queue_low(acc.sid, bytes);
+            }
+        }
+    }
+
     /**
      * @return Number of successful frame sendings.
      */
@@ -409,6 +546,8 @@ private:
                 if (frame.empty())
                     continue;
 
+                check_low_watermark(acc);
+
                 // A missing socket is less common than an empty frame, so optimally locate socket
                 // after frame acquiring.
                 auto sock = this->locate_socket(acc.sid);
@@ -450,6 +589,9 @@ private:
                             acc.q.shift(res.n);
                             acc.bwd.recent_bytes_sent += res.n;
                             result++;
+
+                            if (on_frame_sent)
+                                on_frame_sent(acc.sid, res.n);
                         }
 
                         break;
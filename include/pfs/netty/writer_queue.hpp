@@ -7,11 +7,16 @@
 // Changelog:
 //      2025.08.07 Initial version.
 //      2026.04.24 Moved from patterns/pubsub/writer_queue.hpp.
+//      2026.05.12 Added limits and overflow policies.
+//      2026.06.27 Added conflation key support.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "namespace.hpp"
+#include "bounded_queue_pool.hpp"
+#include "writer_queue_limits.hpp"
 #include <pfs/assert.hpp>
 #include <algorithm>
-#include <queue>
+#include <string>
 
 NETTY__NAMESPACE_BEGIN
 
@@ -26,7 +31,7 @@ public:
     using archive_type = typename serializer_traits_type::archive_type;
 
 private:
-    using chunk_queue_type = std::queue<archive_type>;
+    using chunk_queue_type = bounded_queue_pool<archive_type, 1>;
     using frame_type = Frame;
 
 private:
@@ -38,25 +43,60 @@ public:
 
 public:
     // Writer Pool requirement
-    //                      |
-    //                      v
-    void enqueue (int /*priority*/, char const * data, std::size_t size)
+    writer_queue_limits const & limits () const noexcept
+    {
+        return _q.limits();
+    }
+
+    /**
+     * Sets queue limits (Writer Pool requirement).
+     *
+     * @note The queue has a single priority, so queue_overflow_policy::drop_lowest_priority
+     *       is equivalent to queue_overflow_policy::drop_oldest here.
+     */
+    void set_limits (writer_queue_limits const & limits)
+    {
+        _q.set_limits(limits);
+    }
+
+    // Writer Pool requirement
+    queue_occupancy occupancy () const noexcept
+    {
+        return _q.occupancy();
+    }
+
+    // Writer Pool requirement
+    //                                 |
+    //                                 v
+    queue_occupancy enqueue (int /*priority*/, char const * data, std::size_t size)
     {
         if (size == 0)
-            return;
+            return _q.occupancy();
 
-        _q.push(archive_type{data, size});
+        return _q.push(0, archive_type{data, size});
     }
 
     // Writer Pool requirement
-    //                      |
-    //                      v
-    void enqueue (int /*priority*/, archive_type data)
+    //                                 |
+    //                                 v
+    queue_occupancy enqueue (int /*priority*/, archive_type data)
     {
         if (data.empty())
-            return;
+            return _q.occupancy();
 
-        _q.push(std::move(data));
+        return _q.push(0, std::move(data));
+    }
+
+    /**
+     * Enqueues message with the conflation @a key (see queue_overflow_policy::conflate).
+     */
+    queue_occupancy enqueue (int /*priority*/, char const * data, std::size_t size
+        , std::string const & key)
+    {
+        if (size == 0)
+            return _q.occupancy();
+
+        return _q.push(0, archive_type{data, size}, key);
     }
 
     /**
@@ -75,15 +115,11 @@ public:
         if (_q.empty())
             return _frame; // _frame is empty here
 
-        auto & front = _q.front();
-
         PFS__THROW_UNEXPECTED(_frame.empty(), "");
 
-        frame_type::pack(_frame, front, frame_size);
-
-        // Check topmost message is processed
-        if (front.empty())
-            _q.pop();
+        _q.consume_front(0, [this, frame_size] (archive_type & front) {
+            frame_type::pack(_frame, front, frame_size);
+        });
 
         return _frame;
     }
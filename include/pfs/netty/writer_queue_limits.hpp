@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.05.12 Initial version.
+//      2026.05.14 Added `queue_overflow_policy::conflate`.
+//      2026.06.27 `queue_overflow_policy::conflate` applies to the messages with the same key.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include <cstddef>
+
+NETTY__NAMESPACE_BEGIN
+
+/**
+ * Writer queue overflow policy.
+ */
+enum class queue_overflow_policy
+{
+    // Reject new message.
+      reject
+
+    // Drop the oldest messages of the same priority to accept the new one.
+    , drop_oldest
+
+    // Drop the oldest messages starting from the lowest priority (but not higher than the
+    // priority of the new message) to accept the new one.
+    , drop_lowest_priority
+
+    // Drop pending messages of the same priority with the same conflation key (e.g. topic), i.e.
+    // keep the latest message per key. The oldest messages with other keys are dropped only if
+    // it's not enough to accept the new one.
+    , conflate
+};
+
+/**
+ * Writer queue limits (per socket).
+ *
+ * @details Zero value means unlimited. Limits are applied to all messages including
+ *          service packets (handshake, heartbeat etc), so they should leave some headroom.
+ *          Message partially packed into a frame is never dropped.
+ */
+struct writer_queue_limits
+{
+    // Limits for the whole queue
+    std::size_t max_bytes {0};
+    std::size_t max_messages {0};
+
+    // Limits for each priority queue
+    std::size_t max_priority_bytes {0};
+    std::size_t max_priority_messages {0};
+
+    queue_overflow_policy overflow_policy {queue_overflow_policy::reject};
+
+    // Queued bytes thresholds for backpressure notification (zero high watermark disables
+    // notification).
+    std::size_t high_watermark {0};
+    std::size_t low_watermark {0};
+};
+
+/**
+ * Writer queue occupancy reported by enqueue operation.
+ */
+struct queue_occupancy
+{
+    bool accepted {true};     // Message accepted by the queue
+    std::size_t dropped {0};  // Number of messages dropped to accept the new one
+    std::size_t bytes {0};    // Total bytes queued
+    std::size_t messages {0}; // Total messages queued
+};
+
+NETTY__NAMESPACE_END
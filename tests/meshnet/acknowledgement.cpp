@@ -0,0 +1,560 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.27 Initial version.
+//                 Added retransmission tests with the full congestion window.
+//                 Added acknowledgement test for the peer without SACK support.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+#include "../serializer_traits.hpp"
+#include "pfs/netty/patterns/priority_tracker.hpp"
+#include "pfs/netty/patterns/delivery/delivery_controller.hpp"
+#include "pfs/netty/patterns/delivery/multipart_assembler.hpp"
+#include "pfs/netty/patterns/delivery/multipart_tracker.hpp"
+#include "pfs/netty/patterns/delivery/protocol.hpp"
+#include <pfs/universal_id.hpp>
+#include <pfs/universal_id_pack.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace netty::delivery;
+using node_id = pfs::universal_id;
+using message_id = pfs::universal_id;
+using ranges_t = std::vector<std::pair<serial_number, serial_number>>;
+using serializer_t = serializer_traits_t::serializer_type;
+using deserializer_t = serializer_traits_t::deserializer_type;
+
+struct distribution
+{
+    std::array<std::size_t, 2> distrib {2, 1};
+
+    static constexpr std::size_t SIZE = 2;
+
+    constexpr std::size_t operator [] (std::size_t i) const noexcept
+    {
+        return distrib[i];
+    }
+};
+
+using delivery_controller_t = delivery_controller<node_id, message_id, serializer_traits_t
+    , netty::priority_tracker<distribution>>;
+
+static archive_t serialize_sack (serial_number cumulative_sn, ranges_t ranges)
+{
+    archive_t ar;
+    serializer_t out {ar};
+    sack_packet pkt {cumulative_sn, std::move(ranges)};
+    pkt.serialize(out);
+    return ar;
+}
+
+static std::string make_payload (std::size_t size)
+{
+    std::string s;
+
+    for (std::size_t i = 0; i < size; i++)
+        s.push_back(static_cast<char>('a' + i % 26));
+
+    return s;
+}
+
+struct wire_packet
+{
+    node_id addr;
+    int priority;
+    archive_t data;
+};
+
+// Manager of the delivery controller: packets are transmitted through the wire
+class manager
+{
+    std::deque<wire_packet> * _wire {nullptr};
+
+public:
+    std::size_t parts {0};
+    std::size_t acks {0};
+    std::size_t part_acks {0}; // ACK packets (peer without SACK support)
+    std::size_t drop_first {0}; // Ordinal number of the first lost part
+    std::size_t drop_count {0}; // Number of the lost parts
+    std::size_t delivered {0};
+    std::vector<archive_t> received;
+    archive_t last_ack;
+
+public:
+    manager (std::deque<wire_packet> * wire)
+        : _wire(wire)
+    {}
+
+public:
+    bool enqueue_private (node_id addr, archive_t ar, int priority)
+    {
+        deserializer_t in {ar.data(), ar.size()};
+        header h {in};
+
+        if (h.type() == packet_enum::sack) {
+            acks++;
+            last_ack = archive_t{ar.data(), ar.size()};
+        } else if (h.type() == packet_enum::ack) {
+            part_acks++;
+        } else if (h.type() == packet_enum::message || h.type() == packet_enum::part) {
+            auto ordinal = parts++;
+
+            // Part is lost
+            if (ordinal >= drop_first && ordinal < drop_first + drop_count)
+                return true;
+        }
+
+        _wire->push_back(wire_packet{addr, priority, std::move(ar)});
+        return true;
+    }
+
+    sack_packet last_sack () const
+    {
+        deserializer_t in {last_ack.data(), last_ack.size()};
+        header h {in};
+        REQUIRE_EQ(h.type(), packet_enum::sack);
+        return sack_packet {h, in};
+    }
+
+    void process_error (std::string const & text) { MESSAGE(text); }
+    void process_report_received (node_id, int, archive_t) {}
+    void process_message_lost (node_id, message_id) {}
+    void process_message_begin (node_id, message_id, std::size_t) {}
+    void process_message_progress (node_id, message_id, std::size_t, std::size_t) {}
+    void process_message_received (node_id, message_id, int, archive_t msg) { received.push_back(std::move(msg)); }
+    void process_message_delivered (node_id, message_id) { delivered++; }
+    void process_receiver_ready (node_id) {}
+};
+
+TEST_CASE("sack_packet") {
+    // Empty ranges
+    {
+        auto ar = serialize_sack(42, ranges_t{});
+        deserializer_t in {ar.data(), ar.size()};
+        header h {in};
+
+        REQUIRE(in.is_good());
+        CHECK_EQ(h.type(), packet_enum::sack);
+        CHECK_EQ(h.sn(), 42);
+
+        sack_packet pkt {h, in};
+
+        CHECK(in.is_good());
+        CHECK_EQ(in.available(), 0);
+        CHECK(pkt.ranges().empty());
+    }
+
+    // Maximum number of the ranges
+    {
+        ranges_t ranges;
+
+        for (serial_number i = 0; i < sack_packet::MAX_RANGES(); i++)
+            ranges.emplace_back(100 + i * 4, 101 + i * 4);
+
+        auto ar = serialize_sack(99, ranges);
+        deserializer_t in {ar.data(), ar.size()};
+        header h {in};
+        sack_packet pkt {h, in};
+
+        CHECK(in.is_good());
+        CHECK_EQ(in.available(), 0);
+        CHECK_EQ(pkt.sn(), 99);
+        CHECK(pkt.ranges() == ranges);
+
+        // Too many ranges
+        ranges.emplace_back(500, 500);
+        CHECK_THROWS(serialize_sack(99, ranges));
+    }
+
+    // Maximum value of the range count field
+    {
+        archive_t ar;
+        serializer_t out {ar};
+        out << static_cast<std::uint8_t>(0x10 | static_cast<std::uint8_t>(packet_enum::sack))
+            << serial_number{7} << std::uint8_t{255};
+
+        for (serial_number i = 0; i < 255; i++)
+            out << serial_number{10 + i * 2} << serial_number{10 + i * 2};
+
+        deserializer_t in {ar.data(), ar.size()};
+        header h {in};
+        sack_packet pkt {h, in};
+
+        CHECK(in.is_good());
+        CHECK_EQ(pkt.sn(), 7);
+        REQUIRE_EQ(pkt.ranges().size(), 255);
+        CHECK_EQ(pkt.ranges().back().first, 518);
+    }
+
+    // Truncated packet
+    {
+        auto ar = serialize_sack(5, ranges_t{{7, 8}, {10, 12}});
+        deserializer_t in {ar.data(), ar.size() - 1};
+        header h {in};
+        sack_packet pkt {h, in};
+
+        CHECK_FALSE(in.is_good());
+    }
+}
+
+TEST_CASE("assembler") {
+    using multipart_assembler_t = multipart_assembler<message_id, archive_t>;
+
+    archive_t part {"abcd", 4};
+    multipart_assembler_t a {pfs::generate_uuid(), 40, 4, 1, 10};
+
+    CHECK_EQ(a.cumulative_sn(), 0);
+    CHECK(a.received_ranges(sack_packet::MAX_RANGES()).empty());
+
+    // Parts received out of order, heading is not received yet
+    CHECK(a.acknowledge_part(3, part));
+    CHECK(a.acknowledge_part(4, part));
+    CHECK(a.acknowledge_part(7, part));
+    CHECK_FALSE(a.acknowledge_part(7, part));
+
+    CHECK_EQ(a.cumulative_sn(), 0);
+    CHECK(a.received_ranges(sack_packet::MAX_RANGES()) == ranges_t{{3, 4}, {7, 7}});
+
+    CHECK(a.acknowledge_part(1, part));
+    CHECK_EQ(a.cumulative_sn(), 1);
+    CHECK(a.received_ranges(sack_packet::MAX_RANGES()) == ranges_t{{3, 4}, {7, 7}});
+
+    // Gap is filled
+    CHECK(a.acknowledge_part(2, part));
+    CHECK_EQ(a.cumulative_sn(), 4);
+    CHECK(a.received_ranges(sack_packet::MAX_RANGES()) == ranges_t{{7, 7}});
+
+    // Lowest ranges only
+    CHECK(a.acknowledge_part(9, part));
+    CHECK(a.received_ranges(sack_packet::MAX_RANGES()) == ranges_t{{7, 7}, {9, 9}});
+    CHECK(a.received_ranges(1) == ranges_t{{7, 7}});
+    CHECK(a.received_ranges(0).empty());
+
+    for (serial_number sn: {5, 6, 8, 10})
+        CHECK(a.acknowledge_part(sn, part));
+
+    CHECK(a.is_complete());
+    CHECK_EQ(a.cumulative_sn(), 10);
+    CHECK(a.received_ranges(sack_packet::MAX_RANGES()).empty());
+}
+
+TEST_CASE("tracker") {
+    using multipart_tracker_t = multipart_tracker<message_id, archive_t>;
+
+    auto payload = make_payload(40);
+    multipart_tracker_t t {pfs::generate_uuid(), 0, 4, 1, payload.data(), payload.size()};
+
+    REQUIRE_EQ(t.first_sn(), 1);
+    REQUIRE_EQ(t.last_sn(), 10);
+
+    // Cumulative serial number is out of bounds (e.g. acknowledgement of the previous message)
+    CHECK_FALSE(t.acknowledge_parts(0, ranges_t{{2, 3}}));
+    CHECK_FALSE(t.acknowledge_parts(11, ranges_t{}));
+    CHECK_FALSE(t.is_complete());
+
+    // Out of bounds and inverted ranges are ignored
+    {
+        ack_summary summary;
+        CHECK(t.acknowledge_parts(1, ranges_t{{3, 4}, {12, 13}, {8, 6}, {9, 11}}, & summary));
+        CHECK_EQ(summary.newly_acked, 3);
+    }
+
+    // Stale cumulative acknowledgement
+    {
+        ack_summary summary;
+        CHECK(t.acknowledge_parts(1, ranges_t{}, & summary));
+        CHECK_EQ(summary.newly_acked, 0);
+    }
+
+    // Cumulative acknowledgement covers the selectively acknowledged parts
+    {
+        ack_summary summary;
+        CHECK(t.acknowledge_parts(5, ranges_t{{7, 7}}, & summary));
+        CHECK_EQ(summary.newly_acked, 3);
+    }
+
+    // Ranges are processed with the stale cumulative acknowledgement
+    {
+        ack_summary summary;
+        CHECK(t.acknowledge_parts(2, ranges_t{{6, 6}, {7, 7}}, & summary));
+        CHECK_EQ(summary.newly_acked, 1);
+        CHECK_FALSE(t.is_complete());
+    }
+
+    {
+        ack_summary summary;
+        CHECK(t.acknowledge_parts(10, ranges_t{}, & summary));
+        CHECK_EQ(summary.newly_acked, 3);
+        CHECK(t.is_complete());
+    }
+}
+
+// Delivers SYN request of the @a version to the controller @a c
+static void receive_syn (delivery_controller_t & c, manager & m, int version)
+{
+    archive_t ar;
+    serializer_t out {ar};
+    out << static_cast<std::uint8_t>((version << 4) | static_cast<int>(packet_enum::syn_req))
+        << serial_number{0};
+
+    c.process_input(& m, 0, std::move(ar));
+}
+
+TEST_CASE("batched acknowledgement") {
+    std::deque<wire_packet> wire;
+    manager m {& wire};
+    delivery_controller_t c {pfs::generate_uuid(), 4, std::chrono::milliseconds{1000}};
+
+    auto payload = make_payload(160);
+    auto msgid = pfs::generate_uuid();
+
+    receive_syn(c, m, syn_packet<message_id>::VERSION());
+
+    auto receive_part = [&] (serial_number sn) {
+        archive_t ar;
+        serializer_t out {ar};
+        auto data = payload.data() + (sn - 1) * 4;
+
+        if (sn == 1) {
+            message_packet<message_id> pkt {sn};
+            pkt.msgid = msgid;
+            pkt.total_size = payload.size();
+            pkt.part_size = 4;
+            pkt.last_sn = 40;
+            pkt.serialize(out, data, 4);
+        } else {
+            part_packet pkt {sn};
+            pkt.serialize(out, data, 4);
+        }
+
+        c.process_input(& m, 0, std::move(ar));
+    };
+
+    // Message heading is acknowledged immediately
+    receive_part(1);
+    REQUIRE_EQ(m.acks, 1);
+    CHECK_EQ(m.last_sack().sn(), 1);
+
+    // Acknowledgement is delayed
+    receive_part(2);
+    receive_part(3);
+    c.step(& m);
+    CHECK_EQ(m.acks, 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    c.step(& m);
+    REQUIRE_EQ(m.acks, 2);
+    CHECK_EQ(m.last_sack().sn(), 3);
+    CHECK(m.last_sack().ranges().empty());
+
+    // Batch of the parts is acknowledged by the single acknowledgement (part 4 is lost)
+    for (serial_number sn = 5; sn < 20; sn++)
+        receive_part(sn);
+
+    CHECK_EQ(m.acks, 2);
+    receive_part(20);
+    REQUIRE_EQ(m.acks, 3);
+    CHECK_EQ(m.last_sack().sn(), 3);
+    CHECK(m.last_sack().ranges() == ranges_t{{5, 20}});
+
+    // Repeated part is acknowledged immediately
+    receive_part(3);
+    REQUIRE_EQ(m.acks, 4);
+    CHECK_EQ(m.last_sack().sn(), 3);
+
+    // Complete message is acknowledged immediately
+    receive_part(4);
+
+    for (serial_number sn = 21; sn <= 40; sn++)
+        receive_part(sn);
+
+    CHECK_EQ(m.acks, 6);
+    CHECK_EQ(m.last_sack().sn(), 40);
+    CHECK(m.last_sack().ranges().empty());
+
+    REQUIRE_EQ(m.received.size(), 1);
+    CHECK(m.received[0] == archive_t(payload.data(), payload.size()));
+    CHECK_EQ(m.part_acks, 0);
+}
+
+TEST_CASE("acknowledgement without SACK support") {
+    std::deque<wire_packet> wire;
+    manager m {& wire};
+    delivery_controller_t c {pfs::generate_uuid(), 4, std::chrono::milliseconds{1000}};
+
+    auto payload = make_payload(40);
+    auto msgid = pfs::generate_uuid();
+
+    // Peer of the previous version
+    receive_syn(c, m, 1);
+
+    for (serial_number sn = 1; sn <= 10; sn++) {
+        archive_t ar;
+        serializer_t out {ar};
+        auto data = payload.data() + (sn - 1) * 4;
+
+        if (sn == 1) {
+            message_packet<message_id> pkt {sn};
+            pkt.msgid = msgid;
+            pkt.total_size = payload.size();
+            pkt.part_size = 4;
+            pkt.last_sn = 10;
+            pkt.serialize(out, data, 4);
+        } else {
+            part_packet pkt {sn};
+            pkt.serialize(out, data, 4);
+        }
+
+        c.process_input(& m, 0, std::move(ar));
+
+        // Each part is acknowledged immediately by the ACK packet
+        CHECK_EQ(m.part_acks, sn);
+    }
+
+    CHECK_EQ(m.acks, 0);
+    REQUIRE_EQ(m.received.size(), 1);
+    CHECK(m.received[0] == archive_t(payload.data(), payload.size()));
+}
+
+TEST_CASE("retransmission with full window") {
+    using multipart_tracker_t = multipart_tracker<message_id, archive_t>;
+    using multipart_assembler_t = multipart_assembler<message_id, archive_t>;
+
+    auto payload = make_payload(40);
+    auto msgid = pfs::generate_uuid();
+    multipart_tracker_t t {msgid, 0, 4, 1, payload.data(), payload.size(), std::chrono::milliseconds{20}};
+    multipart_assembler_t a {msgid, payload.size(), 4, 1, 10};
+
+    std::size_t const window = 2;
+
+    // First transmission of all parts in flight is lost
+    std::vector<serial_number> lost {3, 4};
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{2};
+
+    while (!t.is_complete() && std::chrono::steady_clock::now() < deadline) {
+        archive_t ar;
+        serializer_t out {ar};
+        auto sn = t.acquire_next_part(out, t.in_flight_count() < window);
+
+        if (sn == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            continue;
+        }
+
+        auto pos = std::find(lost.begin(), lost.end(), sn);
+
+        if (pos != lost.end()) {
+            lost.erase(pos);
+            continue;
+        }
+
+        deserializer_t in {ar.data(), ar.size()};
+        header h {in};
+        archive_t part;
+
+        if (h.type() == packet_enum::message)
+            message_packet<message_id> pkt {h, in, part};
+        else
+            part_packet pkt {h, in, part};
+
+        a.acknowledge_part(sn, part);
+        t.acknowledge_parts(a.cumulative_sn(), a.received_ranges(sack_packet::MAX_RANGES()));
+    }
+
+    CHECK(t.is_complete());
+    CHECK(a.is_complete());
+    CHECK_EQ(t.retransmission_count(), 2);
+    CHECK(a.payload() == archive_t(payload.data(), payload.size()));
+}
+
+static void exchange (delivery_controller_t & sender, manager & sender_m
+    , delivery_controller_t & receiver, manager & receiver_m, node_id receiver_addr
+    , std::deque<wire_packet> & wire, std::size_t message_count)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+    while (sender_m.delivered < message_count && std::chrono::steady_clock::now() < deadline) {
+        sender.step(& sender_m);
+        receiver.step(& receiver_m);
+
+        while (!wire.empty()) {
+            auto pkt = std::move(wire.front());
+            wire.pop_front();
+
+            if (pkt.addr == receiver_addr)
+                receiver.process_input(& receiver_m, pkt.priority, std::move(pkt.data));
+            else
+                sender.process_input(& sender_m, pkt.priority, std::move(pkt.data));
+        }
+    }
+}
+
+TEST_CASE("loopback") {
+    std::deque<wire_packet> wire;
+    auto sender_addr = pfs::generate_uuid();
+    auto receiver_addr = pfs::generate_uuid();
+    manager sender_m {& wire};
+    manager receiver_m {& wire};
+    delivery_controller_t sender {receiver_addr, 64, std::chrono::milliseconds{1000}};
+    delivery_controller_t receiver {sender_addr, 64, std::chrono::milliseconds{1000}};
+
+    std::size_t const message_count = 3;
+    auto payload = make_payload(100 * 64);
+
+    for (std::size_t i = 0; i < message_count; i++)
+        sender.enqueue_message(pfs::generate_uuid(), 0, archive_t(payload.data(), payload.size()));
+
+    exchange(sender, sender_m, receiver, receiver_m, receiver_addr, wire, message_count);
+
+    CHECK_EQ(sender_m.delivered, message_count);
+    REQUIRE_EQ(receiver_m.received.size(), message_count);
+
+    for (auto const & msg: receiver_m.received)
+        CHECK(msg == archive_t(payload.data(), payload.size()));
+
+    // Parts are acknowledged by batches
+    CHECK_EQ(sender_m.parts, message_count * 100);
+    CHECK_LT(receiver_m.acks * 4, sender_m.parts);
+}
+
+TEST_CASE("lossy loopback") {
+    std::deque<wire_packet> wire;
+    auto sender_addr = pfs::generate_uuid();
+    auto receiver_addr = pfs::generate_uuid();
+    manager sender_m {& wire};
+    manager receiver_m {& wire};
+    delivery_controller_t sender {receiver_addr, 64, std::chrono::milliseconds{50}};
+    delivery_controller_t receiver {sender_addr, 64, std::chrono::milliseconds{50}};
+
+    // Burst of the lost parts exceeds the congestion window
+    sender_m.drop_first = 20;
+    sender_m.drop_count = 2 * congestion_window::INITIAL_SIZE();
+
+    std::size_t const message_count = 2;
+    auto payload = make_payload(100 * 64);
+
+    for (std::size_t i = 0; i < message_count; i++)
+        sender.enqueue_message(pfs::generate_uuid(), 0, archive_t(payload.data(), payload.size()));
+
+    exchange(sender, sender_m, receiver, receiver_m, receiver_addr, wire, message_count);
+
+    CHECK_EQ(sender_m.delivered, message_count);
+    REQUIRE_EQ(receiver_m.received.size(), message_count);
+
+    for (auto const & msg: receiver_m.received)
+        CHECK(msg == archive_t(payload.data(), payload.size()));
+
+    CHECK_GT(sender_m.parts, message_count * 100);
+}
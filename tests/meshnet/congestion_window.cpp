@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.25 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+#include "pfs/netty/patterns/delivery/congestion_window.hpp"
+#include <chrono>
+
+using namespace netty::delivery;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+TEST_CASE("slow start and congestion avoidance") {
+    congestion_window cw;
+
+    CHECK_EQ(cw.size(), congestion_window::INITIAL_SIZE());
+
+    // Application limited: window is not validated
+    cw.acknowledged(4, 4);
+    CHECK_EQ(cw.size(), congestion_window::INITIAL_SIZE());
+
+    // Slow start: window grows by the number of acknowledged parts
+    cw.acknowledged(16, 16);
+    CHECK_EQ(cw.size(), 32);
+
+    // Loss: window is halved
+    auto now = congestion_window::clock_type::now();
+    cw.lost(now);
+    CHECK_EQ(cw.size(), 16);
+
+    // Losses of the same congestion event are ignored
+    cw.lost(now + milliseconds{10});
+    CHECK_EQ(cw.size(), 16);
+
+    // Congestion avoidance: about one part per window
+    for (int i = 0; i < 16; i++)
+        cw.acknowledged(1, 16);
+
+    CHECK_EQ(cw.size(), 16);
+
+    cw.acknowledged(1, 16);
+    CHECK_EQ(cw.size(), 17);
+
+    // Next congestion event
+    cw.lost(now + milliseconds{2000});
+    CHECK_EQ(cw.size(), 8);
+
+    for (int i = 0; i < 10; i++)
+        cw.lost(now + milliseconds{2000 * (i + 2)});
+
+    CHECK_EQ(cw.size(), congestion_window::MIN_SIZE());
+}
+
+TEST_CASE("upper bound") {
+    congestion_window cw;
+
+    for (int i = 0; i < 1000; i++)
+        cw.acknowledged(cw.size(), cw.size());
+
+    CHECK_EQ(cw.size(), congestion_window::MAX_SIZE());
+}
+
+TEST_CASE("round-trip time") {
+    congestion_window cw;
+
+    CHECK_EQ(cw.info().srtt, microseconds{0});
+
+    cw.rtt_sample(microseconds{1000});
+    CHECK_EQ(cw.srtt(), microseconds{1000});
+    CHECK_EQ(cw.rttvar(), microseconds{500});
+
+    for (int i = 0; i < 100; i++)
+        cw.rtt_sample(microseconds{2000});
+
+    CHECK_LT(cw.srtt() - microseconds{2000}, microseconds{10});
+    CHECK_LT(cw.rttvar(), microseconds{10});
+
+    auto info = cw.info();
+    CHECK_EQ(info.window, cw.size());
+    CHECK_EQ(info.srtt, cw.srtt());
+}
@@ -5,12 +5,20 @@
 //
 // Changelog:
 //      2025.11.22 Initial version.
+//      2026.06.01 Added RTT measurement test.
+//      2026.06.09 Added heartbeat scheduling and suppression tests.
+//      2026.06.11 Added failure detectors tests.
+//      2026.06.27 Added heartbeat format compatibility test.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../doctest.h"
 #include "../serializer_traits.hpp"
 #include "pfs/netty/posix/tcp_socket.hpp"
 #include "pfs/netty/patterns/meshnet/heartbeat_controller.hpp"
+#include "pfs/netty/patterns/meshnet/phi_accrual_detector.hpp"
+#include <chrono>
+#include <thread>
+#include <vector>
 
 using namespace netty::meshnet;
 using socket_id = netty::posix::tcp_socket::socket_id;
@@ -23,3 +31,248 @@ TEST_CASE("basic") {
 
     // TODO
 }
+
+TEST_CASE("rtt") {
+    using heartbeat_controller_t = netty::meshnet::heartbeat_controller<socket_id
+        , serializer_traits_t>;
+
+    // Heartbeats are sent on each step
+    heartbeat_controller_t a {std::chrono::seconds{15}, std::chrono::seconds{0}};
+    heartbeat_controller_t b {std::chrono::seconds{15}, std::chrono::seconds{0}};
+
+    socket_id const a_sid = 1; // Channel socket on `a` side
+    socket_id const b_sid = 2; // Channel socket on `b` side
+
+    std::vector<archive_t> a_out;
+    std::vector<archive_t> b_out;
+    std::chrono::microseconds a_srtt {0};
+    int a_updates = 0;
+
+    a.enqueue_packet = [& a_out] (socket_id, archive_t ar) { a_out.push_back(std::move(ar)); };
+    b.enqueue_packet = [& b_out] (socket_id, archive_t ar) { b_out.push_back(std::move(ar)); };
+
+    a.on_rtt_updated = [&] (socket_id sid, std::chrono::microseconds srtt, std::chrono::microseconds) {
+        CHECK_EQ(sid, a_sid);
+        a_srtt = srtt;
+        a_updates++;
+    };
+
+    auto deliver = [] (std::vector<archive_t> & out, heartbeat_controller_t & hc, socket_id sid) {
+        for (auto & ar: out) {
+            serializer_traits_t::deserializer_type in {ar.data(), ar.size()};
+            header h {in};
+            heartbeat_packet pkt {h, in};
+
+            CHECK(pkt.has_timestamps());
+            hc.process(sid, sid, pkt);
+        }
+
+        out.clear();
+    };
+
+    a.update(a_sid);
+    b.update(b_sid);
+
+    // Both sides support timestamps (negotiated by handshake)
+    a.enable_timestamps(a_sid);
+    b.enable_timestamps(b_sid);
+
+    CHECK_EQ(a.srtt(a_sid), std::chrono::microseconds{0});
+
+    // `a` -> `b` with 10 ms of network delay: no echo yet
+    a.step();
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    deliver(a_out, b, b_sid);
+    CHECK_EQ(a_updates, 0);
+
+    // `b` -> `a` with the echoed timestamp of `a`
+    b.step();
+    deliver(b_out, a, a_sid);
+
+    CHECK_EQ(a_updates, 1);
+    CHECK_GE(a_srtt, std::chrono::milliseconds{10});
+    CHECK_LT(a_srtt, std::chrono::seconds{1});
+    CHECK_EQ(a.srtt(a_sid), a_srtt);
+
+    // Time spent by `b` between receiving and echoing is excluded from RTT
+    a.step();
+    deliver(a_out, b, b_sid);
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    b.step();
+    deliver(b_out, a, a_sid);
+
+    CHECK_EQ(a_updates, 2);
+    CHECK_LT(a.srtt(a_sid), std::chrono::milliseconds{50});
+
+    a.remove(a_sid);
+    CHECK_EQ(a.srtt(a_sid), std::chrono::microseconds{0});
+}
+
+TEST_CASE("compatibility") {
+    using heartbeat_controller_t = netty::meshnet::heartbeat_controller<socket_id
+        , serializer_traits_t>;
+
+    heartbeat_controller_t hc {std::chrono::seconds{15}, std::chrono::seconds{0}};
+    socket_id const sid = 1;
+    std::vector<archive_t> out;
+
+    hc.enqueue_packet = [& out] (socket_id, archive_t ar) { out.push_back(std::move(ar)); };
+
+    auto has_timestamps = [& out] () {
+        REQUIRE_EQ(out.size(), 1);
+        serializer_traits_t::deserializer_type in {out[0].data(), out[0].size()};
+        header h {in};
+        heartbeat_packet pkt {h, in};
+        out.clear();
+        return pkt.has_timestamps();
+    };
+
+    hc.update(sid);
+
+    // Remote side support is unknown: previous heartbeat format
+    hc.step();
+    CHECK_FALSE(has_timestamps());
+
+    // Heartbeat with timestamps received: remote side supports them
+    hc.process(sid, sid, heartbeat_packet{0, 1, 0, 0});
+    hc.step();
+    CHECK(has_timestamps());
+
+    hc.remove(sid);
+    hc.update(sid);
+    hc.step();
+    CHECK_FALSE(has_timestamps());
+
+    hc.enable_timestamps(sid);
+    hc.step();
+    CHECK(has_timestamps());
+}
+
+TEST_CASE("schedule") {
+    using heartbeat_controller_t = netty::meshnet::heartbeat_controller<socket_id
+        , serializer_traits_t>;
+
+    // Heartbeats are sent on each step
+    heartbeat_controller_t hc {std::chrono::seconds{15}, std::chrono::seconds{0}};
+    std::vector<socket_id> sent;
+
+    hc.enqueue_packet = [& sent] (socket_id sid, archive_t) { sent.push_back(sid); };
+
+    for (socket_id sid = 1; sid <= 1000; sid++)
+        hc.update(sid);
+
+    // Repeated update does not duplicate heartbeats
+    hc.update(1);
+
+    CHECK_EQ(hc.step(), 1000);
+    CHECK_EQ(sent.size(), 1000);
+
+    for (socket_id sid = 1; sid <= 1000; sid += 2)
+        hc.remove(sid);
+
+    sent.clear();
+    CHECK_EQ(hc.step(), 500);
+    CHECK_EQ(sent.size(), 500);
+
+    for (auto sid: sent)
+        CHECK_EQ(sid % 2, 0);
+}
+
+TEST_CASE("suppression") {
+    using heartbeat_controller_t = netty::meshnet::heartbeat_controller<socket_id
+        , serializer_traits_t>;
+
+    heartbeat_controller_t hc {std::chrono::seconds{1}, std::chrono::seconds{1}};
+    socket_id const sid = 1;
+    int sent = 0;
+    int expired = 0;
+
+    hc.enqueue_packet = [& sent] (socket_id, archive_t) { sent++; };
+    hc.on_expired = [& expired] (socket_id) { expired++; };
+    hc.set_suppression(true);
+
+    hc.update(sid);
+    hc.process(sid, heartbeat_packet{0});
+
+    // Active channel: no heartbeats sent and liveness is refreshed by any frame
+    for (int i = 0; i < 15; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{100});
+        hc.notify_sent(sid);
+        hc.notify_received(sid);
+        hc.step();
+    }
+
+    CHECK_EQ(sent, 0);
+    CHECK_EQ(expired, 0);
+
+    // Idle channel: heartbeat sent, then channel expired
+    std::this_thread::sleep_for(std::chrono::milliseconds{1100});
+    hc.step();
+
+    CHECK_EQ(sent, 1);
+    CHECK_EQ(expired, 1);
+}
+
+TEST_CASE("failure detectors") {
+    using std::chrono::milliseconds;
+    using std::chrono::seconds;
+
+    auto t = std::chrono::steady_clock::now();
+
+    timeout_detector td {seconds{15}, t};
+    phi_accrual_detector pd {seconds{15}, t};
+
+    CHECK(td.deadline() == t + seconds{15});
+    CHECK_EQ(td.suspicion(t + milliseconds{7500}), doctest::Approx(0.5));
+
+    // Not enough samples: fixed timeout is used
+    CHECK(pd.deadline() == t + seconds{15});
+
+    // Heartbeats with 100 ms interval and small jitter
+    for (int i = 0; i < 20; i++) {
+        t += milliseconds{i % 2 == 0 ? 95 : 105};
+        pd.heartbeat(t);
+        td.heartbeat(t);
+    }
+
+    CHECK(td.deadline() == t + seconds{15});
+
+    CHECK(pd.deadline() > t + milliseconds{100});
+    CHECK(pd.deadline() < t + seconds{1});
+    CHECK_LT(pd.suspicion(t + milliseconds{100}), 1);
+    CHECK_GE(pd.suspicion(t + seconds{1}), pd.threshold());
+
+    // Other frames postpone the detection
+    pd.refresh(t + milliseconds{500});
+    CHECK(pd.deadline() > t + milliseconds{600});
+}
+
+TEST_CASE("phi accrual") {
+    using heartbeat_controller_t = netty::meshnet::heartbeat_controller<socket_id
+        , serializer_traits_t, phi_accrual_detector>;
+
+    heartbeat_controller_t hc {std::chrono::seconds{15}, std::chrono::seconds{5}};
+    socket_id const sid = 1;
+    int expired = 0;
+
+    hc.enqueue_packet = [] (socket_id, archive_t) {};
+    hc.on_expired = [& expired] (socket_id) { expired++; };
+
+    CHECK_EQ(hc.suspicion(sid), 0);
+
+    for (int i = 0; i < 10; i++) {
+        hc.process(sid, heartbeat_packet{0});
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    }
+
+    // Heartbeats stopped: failure is detected much earlier than the expiration timeout
+    auto start = std::chrono::steady_clock::now();
+
+    while (expired == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds{2}) {
+        hc.step();
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+
+    CHECK_EQ(expired, 1);
+    CHECK_EQ(hc.suspicion(sid), 0);
+}
@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2025.11.20 Initial version.
+//      2026.06.05 Added cut-through forwarding test.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../doctest.h"
@@ -13,6 +14,8 @@
 #include "pfs/netty/patterns/meshnet/input_controller.hpp"
 #include <pfs/universal_id.hpp>
 #include <pfs/universal_id_pack.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace {
 constexpr int kPRIORITY_COUNT = 2;
@@ -302,3 +305,102 @@ TEST_CASE("gdata") {
     CHECK(payload.empty());
     CHECK_EQ(counter, 3);
 }
+
+TEST_CASE("gdata cut-through") {
+    using gdata_packet_t = gdata_packet<node_id>;
+
+#if NETTY__QT_ENABLED
+    QByteArray msg_sample {"Hello,World!"};
+#else
+    std::vector<char> msg_sample {'H', 'e', 'l', 'l', 'o', ',', 'W', 'o', 'r', 'l', 'd', '!'};
+#endif
+
+    auto self_id = pfs::generate_uuid();
+    auto sender_id = pfs::generate_uuid();
+    auto receiver_id = pfs::generate_uuid();
+
+    archive_t forward_packet;
+    archive_t payload;
+    serializer_traits_t::serializer_type out {payload};
+
+    {
+        gdata_packet_t pkt {sender_id, receiver_id};
+        pkt.serialize(out, msg_sample.data(), msg_sample.size());
+
+        serializer_traits_t::serializer_type out1 {forward_packet};
+        pkt.serialize(out1, msg_sample.data(), msg_sample.size());
+    }
+
+    {
+        gdata_packet_t pkt {sender_id, self_id};
+        pkt.serialize(out, msg_sample.data(), msg_sample.size());
+    }
+
+    {
+        gdata_packet_t pkt {sender_id, receiver_id};
+        pkt.serialize(out, msg_sample.data(), msg_sample.size());
+    }
+
+    input_controller_t ic;
+    int gdata_counter = 0;
+    int forward_counter = 0;
+
+    ic.add(kSID);
+    ic.enable_cut_through(self_id);
+
+    ic.on_gdata = [&] (socket_id, int, gdata_packet_t && pkt, archive_t && msg) {
+        CHECK_EQ(pkt.receiver_id(), self_id);
+
+        auto && c = msg.move_container();
+        CHECK_EQ(c, msg_sample);
+        gdata_counter++;
+    };
+
+    ic.on_gdata_forward = [&] (socket_id sid, int priority, gdata_packet_t const & pkt
+            , char const * data, std::size_t len) {
+        REQUIRE_EQ(sid, kSID);
+        CHECK_EQ(priority, 1);
+        CHECK_EQ(pkt.sender_id(), sender_id);
+        CHECK_EQ(pkt.receiver_id(), receiver_id);
+
+        // Packet is passed as is
+        REQUIRE_EQ(len, forward_packet.size());
+        CHECK(std::equal(data, data + len, forward_packet.data()));
+        forward_counter++;
+    };
+
+    archive_t frames;
+    pack_payload(1, frames, payload);
+    ic.process_input(kSID, std::move(frames));
+
+    CHECK_EQ(gdata_counter, 1);
+    CHECK_EQ(forward_counter, 2);
+
+    // Corrupted payload is forwarded without checksum verification ...
+    std::vector<char> corrupted (forward_packet.data(), forward_packet.data() + forward_packet.size());
+    corrupted.back() ^= 0x01;
+
+    {
+        archive_t frames1;
+        archive_t payload1 {corrupted.data(), corrupted.size()};
+        pack_payload(1, frames1, payload1);
+
+        ic.on_gdata_forward = [&] (socket_id, int, gdata_packet_t const &, char const *, std::size_t) {
+            forward_counter++;
+        };
+
+        ic.process_input(kSID, std::move(frames1));
+        CHECK_EQ(forward_counter, 3);
+    }
+
+    // ... and rejected with it
+    {
+        archive_t frames1;
+        archive_t payload1 {corrupted.data(), corrupted.size()};
+        pack_payload(1, frames1, payload1);
+
+        ic.verify_forwarded_checksum(true);
+        CHECK_THROWS_AS(ic.process_input(kSID, std::move(frames1)), netty::error);
+        CHECK_EQ(forward_counter, 3);
+    }
+}
@@ -5,6 +5,10 @@
 //
 // Changelog:
 //      2025.12.09 Initial version.
+//      2026.06.03 Added `send_multicast` method.
+//      2026.06.09 Added `set_staging` method.
+//      2026.06.13 Added `set_route_propagation` and `control_traffic` methods.
+//      2026.06.15 Added `set_segment_resolver` and `routing_record_count` methods.
 ////////////////////////////////////////////////////////////////////////////////
 #include "mesh_network.hpp"
 #include "pfs/netty/socket4_addr.hpp"
@@ -248,6 +252,71 @@ bool mesh_network::send_message (std::string const & sender_name, std::string co
 #endif
 }
 
+#ifndef NETTY__TESTS_USE_MESHNET_RELIABLE_NODE
+bool mesh_network::send_multicast (std::string const & sender_name
+    , std::vector<std::string> const & receiver_names, std::string const & bytes, int priority)
+{
+    auto sender_ctx = get_context_ptr(sender_name);
+    std::vector<node_id> receivers;
+
+    for (auto const & name: receiver_names)
+        receivers.push_back(_dict.get_entry(name).id);
+
+    PFS__ASSERT(sender_ctx->node_ptr, "Fix send_multicast() method call");
+
+    return sender_ctx->node_ptr->enqueue_multicast(receivers, priority, bytes.data(), bytes.size());
+}
+
+void mesh_network::set_staging (std::string const & name, bool enable)
+{
+    auto ctx = get_context_ptr(name);
+
+    PFS__ASSERT(ctx->node_ptr, "Fix set_staging() method call");
+    ctx->node_ptr->set_staging(enable);
+}
+
+void mesh_network::set_route_propagation (netty::meshnet::route_propagation mode)
+{
+    for (auto & x: _nodes) {
+        if (x.second->node_ptr)
+            x.second->node_ptr->set_route_propagation(mode);
+    }
+}
+
+netty::meshnet::control_counters mesh_network::control_traffic ()
+{
+    netty::meshnet::control_counters result;
+
+    for (auto & x: _nodes) {
+        if (x.second->node_ptr) {
+            auto c = x.second->node_ptr->control_traffic();
+            result.packets += c.packets;
+            result.bytes += c.bytes;
+        }
+    }
+
+    return result;
+}
+
+void mesh_network::set_segment_resolver (std::function<std::uint32_t (std::string const &)> f)
+{
+    auto resolver = [this, f] (node_id id) -> netty::meshnet::segment_id_t {
+        return f(_dict.get_entry(id).name);
+    };
+
+    for (auto & x: _nodes) {
+        if (x.second->node_ptr)
+            x.second->node_ptr->set_segment_resolver(resolver);
+    }
+}
+
+std::size_t mesh_network::routing_record_count (std::string const & name)
+{
+    auto pctx = get_context_ptr(name);
+    return pctx->node_ptr ? pctx->node_ptr->dump_routing_records().size() : 0;
+}
+#endif
+
 #ifdef NETTY__TESTS_USE_MESHNET_RELIABLE_NODE
 void mesh_network::send_report (std::string const & sender_name, std::string const & receiver_name
     , std::string const & bytes, int priority)
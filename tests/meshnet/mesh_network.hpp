@@ -5,6 +5,10 @@
 //
 // Changelog:
 //      2025.12.08 Initial version.
+//      2026.06.03 Added `send_multicast` method.
+//      2026.06.09 Added `set_staging` method.
+//      2026.06.13 Added `set_route_propagation` and `control_traffic` methods.
+//      2026.06.15 Added `set_segment_resolver` and `routing_record_count` methods.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "node_dictionary.hpp"
@@ -145,6 +149,21 @@ public:
     bool send_message (std::string const & sender_name, std::string const & receiver_name
         , std::string const & bytes, int priority = 1);
 
+#ifndef NETTY__TESTS_USE_MESHNET_RELIABLE_NODE
+    bool send_multicast (std::string const & sender_name
+        , std::vector<std::string> const & receiver_names, std::string const & bytes, int priority = 1);
+    void set_staging (std::string const & name, bool enable);
+    void set_route_propagation (netty::meshnet::route_propagation mode);
+
+    // Control traffic sent by all nodes
+    netty::meshnet::control_counters control_traffic ();
+
+    // Sets segment resolver (by node name) for all nodes
+    void set_segment_resolver (std::function<std::uint32_t (std::string const &)> f);
+
+    std::size_t routing_record_count (std::string const & name);
+#endif
+
 #ifdef NETTY__TESTS_USE_MESHNET_RELIABLE_NODE
     void send_report (std::string const & sender_name, std::string const & receiver_name
         , std::string const & bytes, int priority = 2);
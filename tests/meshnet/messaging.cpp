@@ -6,6 +6,8 @@
 // Changelog:
 //      2025.04.16 Initial version.
 //      2025.12.23 Refactored and fixed with new version of `mesh_network`.
+//      2026.06.03 Added multicast test.
+//      2026.06.09 Added staging mode test.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../doctest.h"
@@ -15,8 +17,12 @@
 #include <pfs/lorem/utils.hpp>
 #include <pfs/lorem/wait_atomic_counter.hpp>
 #include <pfs/lorem/wait_bitmatrix.hpp>
+#include <chrono>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 // =================================================================================================
@@ -59,6 +65,8 @@
 #define TEST_SCHEME_2_ENABLED 1
 #define TEST_SCHEME_3_ENABLED 1
 #define TEST_SCHEME_4_ENABLED 1
+#define TEST_MULTICAST_ENABLED 1
+#define TEST_STAGING_ENABLED 1
 
 using namespace std::placeholders;
 using colorzr_t = pfs::term::colorizer;
@@ -354,3 +362,164 @@ TEST_CASE("scheme 4") {
     }
 }
 #endif
+
+#if TEST_MULTICAST_ENABLED && !defined(NETTY__TESTS_USE_MESHNET_RELIABLE_NODE)
+TEST_CASE("multicast") {
+    // Scheme 3
+    static constexpr std::size_t N = 9;
+    static constexpr std::size_t C = 8;
+
+    START_TEST_MESSAGE
+
+    mesh_network net {"a", "b", "c", "d", "e", "A0", "B0", "C0", "D0"};
+    auto pnet = mesh_network::instance();
+
+    std::vector<std::string> receivers {"a", "B0", "C0", "D0", "e"};
+    std::string message = lorem::random_binary_data(1024);
+
+    lorem::wait_atomic_counter8 channel_established_counter {C * 2};
+    lorem::wait_atomic_counter32 message_received_counter {receivers.size()};
+    lorem::wait_bitmatrix<N> route_matrix;
+    std::map<std::string, int> received;
+    std::mutex received_mtx;
+
+    pnet->set_main_diagonal(route_matrix);
+    pnet->on_channel_established = std::bind(channel_established_cb
+        , std::ref(channel_established_counter), _1, _2, _3, _4);
+    pnet->on_channel_destroyed = channel_destroyed_cb;
+    pnet->on_route_ready = std::bind(route_ready_cb<N>, std::ref(route_matrix), _1, _2, _3);
+
+    pnet->on_data_received = [&] (node_spec_t const & receiver, node_spec_t const & sender, int
+            , archive_t bytes) {
+        CHECK_EQ(sender.first, "A0");
+        CHECK_EQ(std::string(bytes.data(), bytes.size()), message);
+
+        std::unique_lock<std::mutex> locker{received_mtx};
+        received[receiver.first]++;
+        ++message_received_counter;
+    };
+
+    pnet->set_scenario([&] () {
+        REQUIRE(channel_established_counter.wait());
+        REQUIRE(route_matrix.wait());
+
+        CHECK(pnet->send_multicast("A0", receivers, message));
+
+        REQUIRE(message_received_counter.wait());
+
+        // Wait for possible duplicates
+        std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+        std::unique_lock<std::mutex> locker{received_mtx};
+
+        for (auto const & name: receivers)
+            CHECK_EQ(received[name], 1);
+
+        CHECK_EQ(received.size(), receivers.size());
+
+        pnet->interrupt_all();
+    });
+
+    pnet->listen_all();
+
+    net.connect("a", "e");
+    net.connect("e", "a");
+    net.connect("b", "e");
+    net.connect("e", "b");
+    net.connect("c", "e");
+    net.connect("e", "c");
+    net.connect("d", "e");
+    net.connect("e", "d");
+
+    net.connect("A0", "a", BEHIND_NAT);
+    net.connect("B0", "b", BEHIND_NAT);
+    net.connect("C0", "c", BEHIND_NAT);
+    net.connect("D0", "d", BEHIND_NAT);
+
+    pnet->run_all();
+
+    END_TEST_MESSAGE
+}
+#endif
+
+#if TEST_STAGING_ENABLED && !defined(NETTY__TESTS_USE_MESHNET_RELIABLE_NODE)
+TEST_CASE("staging") {
+    // Scheme 2
+    static constexpr std::size_t N = 5;
+    static constexpr std::size_t C = 4;
+    static constexpr int PRODUCER_COUNT = 4;
+    static constexpr int MESSAGE_COUNT = 100;
+
+    START_TEST_MESSAGE
+
+    mesh_network net {"a", "b", "e", "A0", "B0"};
+    auto pnet = mesh_network::instance();
+
+    lorem::wait_atomic_counter8 channel_established_counter {C * 2};
+    lorem::wait_atomic_counter32 message_received_counter {PRODUCER_COUNT * MESSAGE_COUNT};
+    lorem::wait_bitmatrix<N> route_matrix;
+    std::vector<int> last(PRODUCER_COUNT, -1);
+    std::mutex last_mtx;
+
+    pnet->set_main_diagonal(route_matrix);
+    pnet->on_channel_established = std::bind(channel_established_cb
+        , std::ref(channel_established_counter), _1, _2, _3, _4);
+    pnet->on_channel_destroyed = channel_destroyed_cb;
+    pnet->on_route_ready = std::bind(route_ready_cb<N>, std::ref(route_matrix), _1, _2, _3);
+
+    pnet->on_data_received = [&] (node_spec_t const & receiver, node_spec_t const & sender, int
+            , archive_t bytes) {
+        CHECK_EQ(receiver.first, "B0");
+        CHECK_EQ(sender.first, "A0");
+
+        auto value = std::stoi(std::string(bytes.data(), bytes.size()));
+        auto producer_index = value / MESSAGE_COUNT;
+
+        std::unique_lock<std::mutex> locker{last_mtx};
+
+        // Order of messages from the same producer is preserved
+        CHECK_LT(last[producer_index], value);
+        last[producer_index] = value;
+
+        ++message_received_counter;
+    };
+
+    pnet->set_scenario([&] () {
+        REQUIRE(channel_established_counter.wait());
+        REQUIRE(route_matrix.wait());
+
+        pnet->set_staging("A0", true);
+
+        std::vector<std::thread> producers;
+
+        for (int i = 0; i < PRODUCER_COUNT; i++) {
+            producers.emplace_back([pnet, i] () {
+                for (int j = 0; j < MESSAGE_COUNT; j++)
+                    CHECK(pnet->send_message("A0", "B0", std::to_string(i * MESSAGE_COUNT + j)));
+            });
+        }
+
+        for (auto & t: producers)
+            t.join();
+
+        REQUIRE(message_received_counter.wait());
+
+        pnet->set_staging("A0", false);
+        pnet->interrupt_all();
+    });
+
+    pnet->listen_all();
+
+    net.connect("a", "e");
+    net.connect("e", "a");
+    net.connect("b", "e");
+    net.connect("e", "b");
+
+    net.connect("A0", "a", BEHIND_NAT);
+    net.connect("B0", "b", BEHIND_NAT);
+
+    pnet->run_all();
+
+    END_TEST_MESSAGE
+}
+#endif
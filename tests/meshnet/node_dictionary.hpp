@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2025.12.08 Initial version.
+//      2026.06.13 Added nodes for the scaled up schemes.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "transport.hpp"
@@ -48,6 +49,7 @@ public:
             , { "c", "01JQN2NGY47H3R81Y9SG0F0C00"_uuid, GATEWAY_FLAG, 4230 }
             , { "d", "01JQN2NGY47H3R81Y9SG0F0D00"_uuid, GATEWAY_FLAG, 4240 }
             , { "e", "01JQN2NGY47H3R81Y9SG0F0E00"_uuid, GATEWAY_FLAG, 4250 }
+            , { "f", "01JQN2NGY47H3R81Y9SG0F0F00"_uuid, GATEWAY_FLAG, 4260 }
 
             // Regular nodes
             , { "A0", "01JQC29M6RC2EVS1ZST11P0VA0"_uuid, REGULAR_NODE_FLAG, 4211 }
@@ -58,6 +60,10 @@ public:
             , { "C1", "01JQC29M6RC2EVS1ZST11P0VC1"_uuid, REGULAR_NODE_FLAG, 4232 }
             , { "D0", "01JQC29M6RC2EVS1ZST11P0VD0"_uuid, REGULAR_NODE_FLAG, 4241 }
             , { "D1", "01JQC29M6RC2EVS1ZST11P0VD1"_uuid, REGULAR_NODE_FLAG, 4242 }
+            , { "E0", "01JQC29M6RC2EVS1ZST11P0VE0"_uuid, REGULAR_NODE_FLAG, 4251 }
+            , { "E1", "01JQC29M6RC2EVS1ZST11P0VE1"_uuid, REGULAR_NODE_FLAG, 4252 }
+            , { "F0", "01JQC29M6RC2EVS1ZST11P0VF0"_uuid, REGULAR_NODE_FLAG, 4261 }
+            , { "F1", "01JQC29M6RC2EVS1ZST11P0VF1"_uuid, REGULAR_NODE_FLAG, 4262 }
 
             // For test duplication
             , { "A0_dup", "01JQC29M6RC2EVS1ZST11P0VA0"_uuid, REGULAR_NODE_FLAG, 4213 }
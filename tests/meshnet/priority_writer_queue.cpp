@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2025.11.22 Initial version.
+//      2026.05.12 Added tests for queue limits.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../doctest.h"
@@ -35,3 +36,109 @@ TEST_CASE("basic") {
     // TODO
 }
 
+
+TEST_CASE("reject") {
+    priority_writer_queue_t q;
+    netty::writer_queue_limits limits;
+    limits.max_bytes = 10;
+    limits.max_priority_messages = 2;
+    q.set_limits(limits);
+
+    auto occupancy = q.enqueue(0, "ABCD", 4);
+    CHECK(occupancy.accepted);
+    CHECK_EQ(occupancy.bytes, 4);
+    CHECK_EQ(occupancy.messages, 1);
+
+    occupancy = q.enqueue(1, "EFGH", 4);
+    CHECK(occupancy.accepted);
+    CHECK_EQ(occupancy.bytes, 8);
+
+    // Queue bytes limit exceeded
+    occupancy = q.enqueue(2, "IJKL", 4);
+    CHECK_FALSE(occupancy.accepted);
+    CHECK_EQ(occupancy.bytes, 8);
+    CHECK_EQ(occupancy.messages, 2);
+
+    // Priority messages limit exceeded
+    CHECK(q.enqueue(0, "M", 1).accepted);
+    CHECK_FALSE(q.enqueue(0, "N", 1).accepted);
+
+    // Message never fits the limits
+    CHECK_FALSE(q.enqueue(3, "0123456789A", 11).accepted);
+    CHECK_EQ(q.occupancy().bytes, 9);
+    CHECK_EQ(q.occupancy().messages, 3);
+}
+
+TEST_CASE("drop oldest") {
+    priority_writer_queue_t q;
+    netty::writer_queue_limits limits;
+    limits.max_messages = 3;
+    limits.overflow_policy = netty::queue_overflow_policy::drop_oldest;
+    q.set_limits(limits);
+
+    CHECK(q.enqueue(1, "A", 1).accepted);
+    CHECK(q.enqueue(1, "BB", 2).accepted);
+    CHECK(q.enqueue(0, "CCC", 3).accepted);
+
+    auto occupancy = q.enqueue(1, "DDDD", 4);
+    CHECK(occupancy.accepted);
+    CHECK_EQ(occupancy.dropped, 1);
+    CHECK_EQ(occupancy.messages, 3);
+    CHECK_EQ(occupancy.bytes, 9);
+
+    // No messages of the same priority to drop
+    CHECK_FALSE(q.enqueue(2, "E", 1).accepted);
+}
+
+TEST_CASE("drop lowest priority") {
+    priority_writer_queue_t q;
+    netty::writer_queue_limits limits;
+    limits.max_bytes = 6;
+    limits.overflow_policy = netty::queue_overflow_policy::drop_lowest_priority;
+    q.set_limits(limits);
+
+    CHECK(q.enqueue(0, "AA", 2).accepted);
+    CHECK(q.enqueue(6, "BB", 2).accepted);
+    CHECK(q.enqueue(3, "CC", 2).accepted);
+
+    auto occupancy = q.enqueue(1, "DDDD", 4);
+    CHECK(occupancy.accepted);
+    CHECK_EQ(occupancy.dropped, 2);
+    CHECK_EQ(occupancy.bytes, 6);
+    CHECK_EQ(occupancy.messages, 2);
+
+    // Higher priority messages are never dropped in favour of lower priority ones
+    CHECK_FALSE(q.enqueue(5, "E", 1).accepted);
+}
+
+TEST_CASE("partially sent message") {
+    priority_writer_queue_t q;
+    netty::writer_queue_limits limits;
+    limits.max_messages = 1;
+    limits.overflow_policy = netty::queue_overflow_policy::drop_oldest;
+    q.set_limits(limits);
+
+    std::string text(100, 'x');
+
+    CHECK(q.enqueue(0, text.data(), text.size()).accepted);
+
+    // Acquire frame less than message size
+    auto frame = q.acquire_frame(64);
+    REQUIRE_FALSE(frame.empty());
+    q.shift(frame.size());
+
+    CHECK_LT(q.occupancy().bytes, text.size());
+    CHECK_EQ(q.occupancy().messages, 1);
+
+    // Partially sent message can't be dropped
+    CHECK_FALSE(q.enqueue(0, "A", 1).accepted);
+
+    while (q.occupancy().messages > 0) {
+        frame = q.acquire_frame(64);
+        REQUIRE_FALSE(frame.empty());
+        q.shift(frame.size());
+    }
+
+    CHECK_EQ(q.occupancy().bytes, 0);
+    CHECK(q.enqueue(0, "A", 1).accepted);
+}
@@ -5,6 +5,13 @@
 //
 // Changelog:
 //      2025.08.12 Initial version.
+//      2026.06.01 Added heartbeat timestamps and route latencies tests.
+//      2026.06.03 Added multicast gdata test.
+//      2026.06.13 Added route update packet test.
+//                 Added aggregated unreachable packet test.
+//      2026.06.15 Added segment entries to route update packet test.
+//      2026.06.27 Added test of the non-aggregated unreachable packet.
+//                 Added protocol version mismatch test.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../doctest.h"
@@ -58,6 +65,7 @@ TEST_CASE("handshake_packet") {
         CHECK_FALSE(req_hp1.has_checksum());
         CHECK(req_hp1.is_gateway());
         CHECK(req_hp1.behind_nat());
+        CHECK(req_hp1.supports_timestamps());
         CHECK_EQ(req_hp1.id(), id_sample);
     }
 
@@ -76,6 +84,7 @@ TEST_CASE("handshake_packet") {
         CHECK_FALSE(rep_hp1.has_checksum());
         CHECK_FALSE(rep_hp1.is_gateway());
         CHECK_FALSE(rep_hp1.behind_nat());
+        CHECK(rep_hp1.supports_timestamps());
         CHECK_EQ(rep_hp1.id(), id_sample);
     }
 }
@@ -106,11 +115,33 @@ TEST_CASE("heartbeat_packet") {
     CHECK_EQ(hbp1.health_data(), health_data);
 }
 
+TEST_CASE("heartbeat_packet with timestamps") {
+    heartbeat_packet hbp {42, 1000000, 999000, 250};
+
+    CHECK(hbp.has_timestamps());
+
+    archive_t ar;
+    serializer_traits_t::serializer_type out {ar};
+    hbp.serialize(out);
+
+    serializer_traits_t::deserializer_type in {ar.data(), ar.size()};
+    header h {in};
+    heartbeat_packet hbp1 {h, in};
+
+    CHECK(hbp1.has_timestamps());
+    CHECK_EQ(hbp1.health_data(), 42);
+    CHECK_EQ(hbp1.timestamp(), 1000000);
+    CHECK_EQ(hbp1.echo_timestamp(), 999000);
+    CHECK_EQ(hbp1.echo_delay(), 250);
+}
+
 TEST_CASE("unreachable_packet") {
     using unreachable_packet_t = unreachable_packet<node_id>;
 
     unreachable_info<node_id> uinfo_sample {
-        pfs::generate_uuid() // gw_id
+          pfs::generate_uuid() // gw_id
+        , {pfs::generate_uuid(), pfs::generate_uuid()}
+        , 42
     };
 
     unreachable_packet_t up {uinfo_sample};
@@ -133,6 +164,106 @@ TEST_CASE("unreachable_packet") {
     CHECK_EQ(up1.type(), packet_enum::unreach);
     CHECK_FALSE(up1.has_checksum());
     CHECK_EQ(up.info().gw_id, uinfo_sample.gw_id);
+    CHECK_EQ(up1.info().gw_id, uinfo_sample.gw_id);
+    CHECK_EQ(up1.info().generation, uinfo_sample.generation);
+    CHECK_EQ(up1.info().ids, uinfo_sample.ids);
+
+    // Non-aggregated packet (single unreachable node ID, no generation)
+    {
+        archive_t ar;
+        serializer_traits_t::serializer_type out {ar};
+        out << static_cast<std::uint8_t>((header::VERSION() << 4) | static_cast<int>(packet_enum::unreach))
+            << std::uint8_t{0} << uinfo_sample.gw_id << uinfo_sample.ids[0];
+
+        serializer_traits_t::deserializer_type in {ar.data(), ar.size()};
+        header h {in};
+        unreachable_packet_t up2 {h, in};
+
+        CHECK_EQ(up2.info().gw_id, uinfo_sample.gw_id);
+        CHECK_EQ(up2.info().generation, 0);
+        REQUIRE_EQ(up2.info().ids.size(), 1);
+        CHECK_EQ(up2.info().ids[0], uinfo_sample.ids[0]);
+    }
+
+    // Packet of the previous protocol version is rejected
+    {
+        archive_t ar;
+        serializer_traits_t::serializer_type out {ar};
+        out << static_cast<std::uint8_t>((1 << 4) | static_cast<int>(packet_enum::unreach))
+            << std::uint8_t{0} << uinfo_sample.gw_id << uinfo_sample.ids[0];
+
+        serializer_traits_t::deserializer_type in {ar.data(), ar.size()};
+
+        try {
+            header h {in};
+            CHECK(false);
+        } catch (netty::error const & ex) {
+            CHECK_EQ(ex.code(), make_error_code(netty::errc::protocol_version_error));
+        }
+    }
+}
+
+TEST_CASE("route_update_packet") {
+    using route_update_packet_t = route_update_packet<node_id>;
+
+    std::vector<route_update_info<node_id>> entries_sample {
+          {pfs::generate_uuid(), 0, 2}
+        , {pfs::generate_uuid(), 3, 10}
+        , {pfs::generate_uuid(), route_update_info<node_id>::UNREACHABLE(), 7}
+    };
+
+    route_update_packet_t rup {entries_sample};
+
+    CHECK_EQ(rup.version(), header::VERSION());
+    CHECK_EQ(rup.type(), packet_enum::rupdate);
+    CHECK_FALSE(rup.has_checksum());
+
+    // Serialization/Deserialization
+    archive_t ar;
+    serializer_traits_t::serializer_type out {ar};
+    rup.serialize(out);
+
+    serializer_traits_t::deserializer_type in {ar.data(), ar.size()};
+    header h {in};
+    route_update_packet_t rup1 {h, in};
+
+    CHECK(in.is_good());
+    CHECK_EQ(rup1.type(), packet_enum::rupdate);
+    REQUIRE_EQ(rup1.entries().size(), entries_sample.size());
+
+    for (std::size_t i = 0; i < entries_sample.size(); i++) {
+        CHECK_EQ(rup1.entries()[i].dest_id, entries_sample[i].dest_id);
+        CHECK_EQ(rup1.entries()[i].hops, entries_sample[i].hops);
+        CHECK_EQ(rup1.entries()[i].seqno, entries_sample[i].seqno);
+    }
+
+    CHECK(rup1.segment_entries().empty());
+
+    // With segment entries
+    std::vector<route_update_info<segment_id_t>> segment_entries_sample {
+          {1, 0, 4}
+        , {42, 2, 6}
+    };
+
+    route_update_packet_t rup2 {entries_sample, segment_entries_sample};
+
+    archive_t ar2;
+    serializer_traits_t::serializer_type out2 {ar2};
+    rup2.serialize(out2);
+
+    serializer_traits_t::deserializer_type in2 {ar2.data(), ar2.size()};
+    header h2 {in2};
+    route_update_packet_t rup3 {h2, in2};
+
+    CHECK(in2.is_good());
+    CHECK_EQ(rup3.entries().size(), entries_sample.size());
+    REQUIRE_EQ(rup3.segment_entries().size(), segment_entries_sample.size());
+
+    for (std::size_t i = 0; i < segment_entries_sample.size(); i++) {
+        CHECK_EQ(rup3.segment_entries()[i].dest_id, segment_entries_sample[i].dest_id);
+        CHECK_EQ(rup3.segment_entries()[i].hops, segment_entries_sample[i].hops);
+        CHECK_EQ(rup3.segment_entries()[i].seqno, segment_entries_sample[i].seqno);
+    }
 }
 
 TEST_CASE("route_packet") {
@@ -199,6 +330,29 @@ TEST_CASE("route_packet") {
         REQUIRE_EQ(rp1_rep.info().route.size(), 2);
         REQUIRE_EQ(rp1_rep.info().route[0], rinfo_sample.route[0]);
         REQUIRE_EQ(rp1_rep.info().route[1], rinfo_sample.route[1]);
+        CHECK(rp1_rep.info().latencies.empty());
+    }
+
+    // With link latencies
+    {
+        auto rinfo = rinfo_sample;
+        rinfo.latencies = std::vector<std::uint32_t>{100, 200, 300};
+
+        route_packet_t rp {packet_way_enum::response, rinfo};
+
+        archive_t ar;
+        serializer_traits_t::serializer_type out {ar};
+        rp.serialize(out);
+
+        serializer_traits_t::deserializer_type in {ar.data(), ar.size()};
+        header h {in};
+        route_packet_t rp1 {h, in};
+
+        REQUIRE_EQ(rp1.info().route.size(), 2);
+        CHECK_EQ(rp1.info().responder_id, rinfo_sample.responder_id);
+        CHECK_EQ(rp1.info().latencies, rinfo.latencies);
+        CHECK_EQ(rp1.info().latency(), 600);
+        CHECK_EQ(rp1.info().latency(1), 500);
     }
 }
 
@@ -262,3 +416,40 @@ TEST_CASE("gdata_packet") {
     CHECK_EQ(gdp1.receiver_id(), received_id_sample);
     CHECK_EQ(msg, msg_sample);
 }
+
+TEST_CASE("multicast gdata_packet") {
+    using gdata_packet_t = gdata_packet<node_id>;
+
+    std::vector<char> msg_sample {'H', 'e', 'l', 'l', 'o', ',', 'W', 'o', 'r', 'l', 'd', '!',};
+
+    auto sender_id_sample = pfs::generate_uuid();
+    std::vector<node_id> receivers_sample {pfs::generate_uuid(), pfs::generate_uuid()
+        , pfs::generate_uuid()};
+
+    gdata_packet_t gdp {sender_id_sample, receivers_sample};
+
+    CHECK_EQ(gdp.type(), packet_enum::gdata);
+    CHECK(gdp.is_multicast());
+    CHECK(gdp.has_checksum());
+
+    // Serialization/Deserialization
+    archive_t ar;
+    serializer_traits_t::serializer_type out {ar};
+    gdp.serialize(out, msg_sample.data(), msg_sample.size());
+
+    serializer_traits_t::deserializer_type in {ar.data(), ar.size()};
+    header h {in};
+    std::vector<char> msg;
+    gdata_packet_t gdp1 {h, in, msg};
+
+    CHECK_EQ(gdp1.type(), packet_enum::gdata);
+    CHECK(gdp1.is_multicast());
+    CHECK_EQ(gdp1.sender_id(), sender_id_sample);
+    CHECK_EQ(gdp1.receivers(), receivers_sample);
+    CHECK_EQ(msg, msg_sample);
+
+    // Unicast packet
+    gdata_packet_t gdp2 {sender_id_sample, receivers_sample[0]};
+    CHECK_FALSE(gdp2.is_multicast());
+    CHECK(gdp2.receivers().empty());
+}
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.21 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+#include "pfs/netty/patterns/meshnet/infinite_reconnection_policy.hpp"
+#include "pfs/netty/patterns/meshnet/jittered_reconnection_policy.hpp"
+#include <chrono>
+#include <set>
+
+using namespace netty::meshnet;
+
+TEST_CASE("infinite") {
+    infinite_reconnection_policy policy {false};
+
+    CHECK(policy.required());
+    CHECK_EQ(policy.fetch_timeout(), std::chrono::seconds{5});
+    CHECK_EQ(policy.attempts(), 1);
+}
+
+TEST_CASE("jittered") {
+    auto const base = jittered_reconnection_policy::BASE_TIMEOUT();
+    auto const max = jittered_reconnection_policy::MAX_TIMEOUT();
+
+    std::set<std::chrono::milliseconds::rep> first_timeouts;
+
+    for (int i = 0; i < 100; i++) {
+        jittered_reconnection_policy policy {true};
+
+        // Fast first retry
+        auto timeout = policy.fetch_timeout();
+        CHECK_LE(timeout, base);
+        first_timeouts.insert(timeout.count());
+
+        auto prev = base;
+
+        for (int j = 0; j < 50; j++) {
+            timeout = policy.fetch_timeout();
+
+            CHECK(policy.required());
+            CHECK_GE(timeout, base);
+            CHECK_LE(timeout, max);
+            CHECK_LE(timeout, prev * 3);
+
+            prev = timeout;
+        }
+
+        CHECK_EQ(policy.attempts(), 51);
+    }
+
+    // Reconnections of the different peers are not synchronized
+    CHECK_GT(first_timeouts.size(), 10);
+}
+
+TEST_CASE("jittered growth") {
+    std::chrono::milliseconds total {0};
+
+    for (int i = 0; i < 100; i++) {
+        jittered_reconnection_policy policy {false};
+
+        for (int j = 0; j < 20; j++)
+            policy.fetch_timeout();
+
+        total += policy.fetch_timeout();
+    }
+
+    // Timeouts approach the upper bound after several attempts
+    CHECK_GT(total / 100, jittered_reconnection_policy::MAX_TIMEOUT() / 4);
+}
@@ -6,6 +6,8 @@
 // Changelog:
 //      2025.03.11 Initial version (routing_table.cpp).
 //      2025.12.10 Refactored with new version of `mesh_network`.
+//      2026.06.13 Added route propagation modes comparison.
+//      2026.06.15 Added hierarchical (segment) routing test.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../doctest.h"
@@ -14,7 +16,13 @@
 #include <pfs/term.hpp>
 #include <pfs/lorem/wait_atomic_counter.hpp>
 #include <pfs/lorem/wait_bitmatrix.hpp>
+#include <cctype>
+#include <chrono>
 #include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
 #include <vector>
 
 // =================================================================================================
@@ -69,6 +77,17 @@
 //              |   |
 //             D0---D1
 //
+// =================================================================================================
+// Scheme 7 (scaled up)
+// -------------------------------------------------------------------------------------------------
+//  A0---A1       B0---B1       C0---C1
+//   |    |        |    |        |    |
+//   +-a--+--------+-b--+--------+-c--+
+//     |                           |
+//   +-f--+--------+-e--+--------+-d--+
+//   |    |        |    |        |    |
+//  F0---F1       E0---E1       D0---D1
+//
 #define ITERATION_COUNT 5;
 
 #define TEST_SCHEME_1_ENABLED 1
@@ -77,6 +96,8 @@
 #define TEST_SCHEME_4_ENABLED 1
 #define TEST_SCHEME_5_ENABLED 1
 #define TEST_SCHEME_6_ENABLED 1
+#define TEST_ROUTE_PROPAGATION_ENABLED 1
+#define TEST_SEGMENT_ROUTING_ENABLED 1
 
 using namespace std::placeholders;
 using colorzr_t = pfs::term::colorizer;
@@ -313,3 +334,204 @@ TEST_CASE("scheme 6") {
     }
 }
 #endif
+
+#if TEST_ROUTE_PROPAGATION_ENABLED && !defined(NETTY__TESTS_USE_MESHNET_RELIABLE_NODE)
+
+struct propagation_result
+{
+    std::chrono::milliseconds convergence_time {0};
+    netty::meshnet::control_counters traffic;
+};
+
+// N - Number of nodes
+// C - number of expected direct links
+template <std::size_t N, std::size_t C>
+propagation_result measure_propagation (std::initializer_list<std::string> node_names
+    , netty::meshnet::route_propagation mode
+    , std::function<void (mesh_network & net)> connect_scenario)
+{
+    propagation_result result;
+    std::vector<std::string> node_list {node_names};
+    mesh_network net {node_names};
+
+    lorem::wait_atomic_counter8 channel_established_counter {C * 2};
+    lorem::wait_bitmatrix<N> route_matrix {std::chrono::milliseconds{20000}};
+    net.set_main_diagonal(route_matrix);
+    net.on_channel_established = std::bind(channel_established_cb
+        , std::ref(channel_established_counter)
+        , _1, _2, _3, _4);
+    net.on_channel_destroyed = channel_destroyed_cb;
+    net.on_route_ready = std::bind(route_ready_cb<N>, std::ref(route_matrix), _1, _2, _3);
+    net.on_node_unreachable = node_unreachable_cb;
+    net.set_route_propagation(mode);
+
+    auto start = std::chrono::steady_clock::now();
+
+    net.set_scenario([&] () {
+        CHECK(channel_established_counter.wait());
+        CHECK(route_matrix.wait());
+
+        result.convergence_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        result.traffic = net.control_traffic();
+
+        tools::print_matrix(route_matrix.value(), node_list);
+        net.interrupt_all();
+    });
+
+    net.listen_all();
+    connect_scenario(net);
+    net.run_all();
+
+    return result;
+}
+
+TEST_CASE("route propagation") {
+    START_TEST_MESSAGE
+
+    auto connect_scenario = [] (mesh_network & net)
+    {
+        std::vector<std::string> gateways {"a", "b", "c", "d", "e", "f"};
+        std::vector<std::string> nodes {"A", "B", "C", "D", "E", "F"};
+
+        for (std::size_t i = 0; i < gateways.size(); i++) {
+            auto const & gw = gateways[i];
+            auto const & next_gw = gateways[(i + 1) % gateways.size()];
+            auto n0 = nodes[i] + "0";
+            auto n1 = nodes[i] + "1";
+
+            net.connect(gw, next_gw);
+            net.connect(next_gw, gw);
+
+            net.connect(n0, gw, BEHIND_NAT);
+            net.connect(n1, gw, BEHIND_NAT);
+
+            net.connect(n0, n1);
+            net.connect(n1, n0);
+        }
+    };
+
+    auto discovery = measure_propagation<18, 24>({"a", "b", "c", "d", "e", "f"
+        , "A0", "A1", "B0", "B1", "C0", "C1", "D0", "D1", "E0", "E1", "F0", "F1"}
+        , netty::meshnet::route_propagation::discovery, connect_scenario);
+
+    auto incremental = measure_propagation<18, 24>({"a", "b", "c", "d", "e", "f"
+        , "A0", "A1", "B0", "B1", "C0", "C1", "D0", "D1", "E0", "E1", "F0", "F1"}
+        , netty::meshnet::route_propagation::incremental, connect_scenario);
+
+    MESSAGE("discovery  : convergence time: " << discovery.convergence_time.count()
+        << " ms, control packets: " << discovery.traffic.packets
+        << ", control bytes: " << discovery.traffic.bytes);
+
+    MESSAGE("incremental: convergence time: " << incremental.convergence_time.count()
+        << " ms, control packets: " << incremental.traffic.packets
+        << ", control bytes: " << incremental.traffic.bytes);
+
+    CHECK_LT(incremental.traffic.bytes, discovery.traffic.bytes);
+
+    END_TEST_MESSAGE
+}
+#endif
+
+#if TEST_SEGMENT_ROUTING_ENABLED && !defined(NETTY__TESTS_USE_MESHNET_RELIABLE_NODE)
+TEST_CASE("segment routing") {
+    START_TEST_MESSAGE
+
+    // Gateway and its regular nodes form the segment (scheme 7)
+    std::vector<std::string> gateways {"a", "b", "c", "d", "e", "f"};
+    std::vector<std::string> nodes {"A0", "A1", "B0", "B1", "C0", "C1", "D0", "D1", "E0", "E1"
+        , "F0", "F1"};
+
+    mesh_network net {"a", "b", "c", "d", "e", "f"
+        , "A0", "A1", "B0", "B1", "C0", "C1", "D0", "D1", "E0", "E1", "F0", "F1"};
+
+    lorem::wait_atomic_counter8 channel_established_counter {24 * 2};
+    lorem::wait_atomic_counter32 message_received_counter {12 * 10};
+
+    std::mutex received_mtx;
+    std::set<std::pair<std::string, std::string>> received;
+
+    net.on_channel_established = std::bind(channel_established_cb
+        , std::ref(channel_established_counter), _1, _2, _3, _4);
+    net.on_channel_destroyed = channel_destroyed_cb;
+    net.on_node_unreachable = node_unreachable_cb;
+
+    net.on_data_received = [&] (node_spec_t const & receiver, node_spec_t const & sender, int
+            , archive_t) {
+        std::unique_lock<std::mutex> locker{received_mtx};
+
+        if (received.emplace(sender.first, receiver.first).second)
+            ++message_received_counter;
+    };
+
+    net.set_route_propagation(netty::meshnet::route_propagation::incremental);
+    net.set_segment_resolver([] (std::string const & name) -> std::uint32_t {
+        return static_cast<std::uint32_t>(std::toupper(name[0]) - 'A' + 1);
+    });
+
+    net.set_scenario([&] () {
+        REQUIRE(channel_established_counter.wait());
+
+        // Routes to the remote segments converge asynchronously, so resend undelivered messages
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            std::vector<std::pair<std::string, std::string>> pending;
+
+            {
+                std::unique_lock<std::mutex> locker{received_mtx};
+
+                for (auto const & sender: nodes) {
+                    for (auto const & receiver: nodes) {
+                        if (sender[0] != receiver[0] && received.count(std::make_pair(sender, receiver)) == 0)
+                            pending.emplace_back(sender, receiver);
+                    }
+                }
+            }
+
+            if (pending.empty())
+                break;
+
+            for (auto const & x: pending)
+                net.send_message(x.first, x.second, "hello");
+
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        }
+
+        CHECK(message_received_counter.wait());
+
+        // Regular node knows the nodes of own segment and one route per remote segment only
+        for (auto const & name: nodes) {
+            net.print_routing_records(name);
+            CHECK_LT(net.routing_record_count(name), net.node_count() - 1);
+        }
+
+        for (auto const & name: gateways)
+            CHECK_LT(net.routing_record_count(name), net.node_count() - 1);
+
+        net.interrupt_all();
+    });
+
+    net.listen_all();
+
+    for (std::size_t i = 0; i < gateways.size(); i++) {
+        auto const & gw = gateways[i];
+        auto const & next_gw = gateways[(i + 1) % gateways.size()];
+        auto n0 = nodes[i * 2];
+        auto n1 = nodes[i * 2 + 1];
+
+        net.connect(gw, next_gw);
+        net.connect(next_gw, gw);
+
+        net.connect(n0, gw, BEHIND_NAT);
+        net.connect(n1, gw, BEHIND_NAT);
+
+        net.connect(n0, n1);
+        net.connect(n1, n0);
+    }
+
+    net.run_all();
+
+    END_TEST_MESSAGE
+}
+#endif
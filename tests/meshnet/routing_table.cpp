@@ -0,0 +1,674 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.05.26 Initial version.
+//      2026.05.28 Added benchmark with 10k routes.
+//      2026.05.30 Added multipath test.
+//      2026.06.01 Added latency metric test.
+//      2026.06.13 Added incremental routes test.
+//      2026.06.15 Added segment routes test.
+//      2026.06.17 Added long gateway chains test.
+//      2026.06.19 Added routing snapshot test.
+//      2026.06.27 Added multipath with latency metric test.
+//                 Added route latencies serialization test.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+#include "../serializer_traits.hpp"
+#include "pfs/netty/patterns/meshnet/routing_table.hpp"
+#include <pfs/universal_id.hpp>
+#include <pfs/universal_id_hash.hpp>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+using namespace netty::meshnet;
+using node_id = pfs::universal_id;
+using routing_table_t = routing_table<node_id, serializer_traits_t>;
+
+TEST_CASE("next hop") {
+    //
+    // A---a---b---c---C
+    //     |
+    //     +---d---C
+    //
+    auto a = pfs::generate_uuid();
+    auto b = pfs::generate_uuid();
+    auto c = pfs::generate_uuid();
+    auto d = pfs::generate_uuid();
+    auto C = pfs::generate_uuid();
+
+    routing_table_t rtab;
+
+    auto route_lost = [] (node_id, std::size_t) {};
+    auto node_unreachable = [] (node_id) {};
+
+    CHECK_FALSE(rtab.gateway_for(C));
+
+    CHECK(rtab.add_sibling(a));
+    CHECK_EQ(*rtab.gateway_for(a), a);
+
+    CHECK(rtab.add_route(C, {a, b, c}).second);
+    CHECK_EQ(*rtab.gateway_for(C), a);
+
+    // Shorter route to `C` through the sibling `d`
+    CHECK(rtab.add_sibling(d));
+    CHECK(rtab.add_route(C, {d}).second);
+    CHECK_EQ(*rtab.gateway_for(C), d);
+
+    // Route through `d` lost
+    CHECK_EQ(rtab.remove_routes(node_id{}, d, route_lost, node_unreachable), 2);
+    CHECK_FALSE(rtab.gateway_for(d));
+    CHECK_EQ(*rtab.gateway_for(C), a);
+
+    // `b` disconnected from `c`
+    CHECK_EQ(rtab.remove_routes(b, c, route_lost, node_unreachable), 1);
+    CHECK_FALSE(rtab.gateway_for(C));
+    CHECK_EQ(*rtab.gateway_for(a), a);
+
+    // `C` became a sibling node
+    CHECK(rtab.add_route(C, {a, b, c}).second);
+    CHECK_EQ(*rtab.gateway_for(C), a);
+    CHECK(rtab.add_sibling(C));
+    CHECK_EQ(*rtab.gateway_for(C), C);
+
+    rtab.remove_sibling(C);
+    CHECK_FALSE(rtab.gateway_for(C));
+}
+
+TEST_CASE("long gateway chains") {
+    // Chains longer than inline capacity of the compact chain
+    std::vector<node_id> gw_chain;
+
+    for (int i = 0; i < 12; i++)
+        gw_chain.push_back(pfs::generate_uuid());
+
+    auto C = pfs::generate_uuid();
+
+    routing_table_t rtab;
+
+    auto route_lost = [] (node_id, std::size_t) {};
+    auto node_unreachable = [] (node_id) {};
+
+    REQUIRE(rtab.add_sibling(gw_chain[0]));
+
+    auto res = rtab.add_route(C, gw_chain);
+    REQUIRE(res.second);
+    CHECK_EQ(rtab.hops(res.first), gw_chain.size());
+    CHECK_EQ(rtab.gateway_chain_by_index(res.first), gw_chain);
+    CHECK_EQ(*rtab.gateway_for(C), gw_chain[0]);
+
+    // Same chain is not duplicated
+    CHECK_FALSE(rtab.add_route(C, gw_chain).second);
+
+    // Reversed subroute to gw_chain[3]: gw_chain[2] -> gw_chain[1] -> gw_chain[0]
+    auto sub = rtab.add_subroute(gw_chain[3], gw_chain[3], gw_chain, true);
+    REQUIRE(sub.second);
+    CHECK_EQ(rtab.hops(sub.first), 3);
+    CHECK_EQ(rtab.gateway_chain_by_index(sub.first)[0], gw_chain[2]);
+
+    // Gateway in the middle of the chain disconnected
+    CHECK_EQ(rtab.remove_routes(gw_chain[8], gw_chain[9], route_lost, node_unreachable), 1);
+    CHECK_FALSE(rtab.is_reachable(C));
+    CHECK(rtab.is_reachable(gw_chain[3]));
+}
+
+TEST_CASE("multipath") {
+    //
+    //     +---a---+
+    //     |       |
+    // A---+---b---+---c---C
+    //     |               |
+    //     +---d---e---f---+
+    //
+    auto a = pfs::generate_uuid();
+    auto b = pfs::generate_uuid();
+    auto c = pfs::generate_uuid();
+    auto d = pfs::generate_uuid();
+    auto e = pfs::generate_uuid();
+    auto f = pfs::generate_uuid();
+    auto C = pfs::generate_uuid();
+
+    routing_table_t rtab;
+
+    rtab.add_sibling(a);
+    rtab.add_sibling(b);
+    rtab.add_sibling(d);
+    rtab.add_route(C, {a, c});
+    rtab.add_route(C, {b, c});
+    rtab.add_route(C, {d, e, f});
+
+    std::map<node_id, std::size_t> load {{a, 0}, {b, 0}, {d, 0}};
+    auto load_fn = [& load] (node_id id) { return load[id]; };
+
+    // Multipath disabled: always the optimal route
+    auto gw = *rtab.gateway_for(C);
+    CHECK_EQ(*rtab.select_gateway(C, 1, 10, load_fn), gw);
+    CHECK_EQ(*rtab.select_gateway(C, 2, 10, load_fn), gw);
+
+    // Sibling node
+    rtab.set_multipath(multipath_mode::per_message);
+    CHECK_EQ(*rtab.select_gateway(a, 1, 10, load_fn), a);
+
+    // Per message: equal-cost routes are used alternately
+    std::map<node_id, int> selected;
+
+    for (int i = 0; i < 10; i++)
+        selected[*rtab.select_gateway(C, 0, 10, load_fn)]++;
+
+    CHECK_EQ(selected[a], 5);
+    CHECK_EQ(selected[b], 5);
+    CHECK_EQ(selected[d], 0);
+
+    // Least loaded gateway is preferred
+    load[a] = 1000;
+
+    for (int i = 0; i < 10; i++)
+        CHECK_EQ(*rtab.select_gateway(C, 0, 10, load_fn), b);
+
+    // Near-equal-cost routes
+    rtab.set_multipath(multipath_mode::per_message, 1);
+    load[b] = 1000;
+    CHECK_EQ(*rtab.select_gateway(C, 0, 10, load_fn), d);
+
+    // ... are not allowed for forwarded messages
+    CHECK_NE(*rtab.select_gateway(C, 0, 10, load_fn, false), d);
+
+    // Per flow: the same flow always uses the same route
+    rtab.set_multipath(multipath_mode::per_flow);
+    selected.clear();
+
+    for (std::size_t flow = 0; flow < 10; flow++) {
+        auto flow_gw = *rtab.select_gateway(C, flow, 10, load_fn);
+        selected[flow_gw]++;
+
+        for (int i = 0; i < 5; i++)
+            CHECK_EQ(*rtab.select_gateway(C, flow, 10, load_fn), flow_gw);
+    }
+
+    CHECK_EQ(selected[a], 5);
+    CHECK_EQ(selected[b], 5);
+
+    // Counters
+    std::uint64_t messages = 0;
+    std::uint64_t bytes = 0;
+
+    rtab.foreach_route_counters([&] (node_id dest, std::size_t route_index, route_counters const & rc) {
+        CHECK_EQ(dest, C);
+        CHECK_GT(route_index, 0);
+        messages += rc.messages;
+        bytes += rc.bytes;
+    });
+
+    CHECK_EQ(messages, 10 + 10 + 1 + 1 + 60);
+    CHECK_EQ(bytes, messages * 10);
+}
+
+TEST_CASE("latency metric") {
+    //
+    // A---a---c---C
+    //     |
+    // A---b---C
+    //
+    using std::chrono::microseconds;
+
+    auto a = pfs::generate_uuid();
+    auto b = pfs::generate_uuid();
+    auto c = pfs::generate_uuid();
+    auto C = pfs::generate_uuid();
+
+    routing_table_t rtab;
+
+    rtab.add_sibling(a);
+    rtab.add_sibling(b);
+
+    auto r1 = rtab.add_route(C, {a, c}).first;
+    auto r2 = rtab.add_route(C, {b}).first;
+
+    rtab.set_route_latency(C, r1, {100, 100});
+    rtab.set_route_latency(C, r2, {5000});
+    rtab.set_link_latency(a, microseconds{100});
+    rtab.set_link_latency(b, microseconds{100});
+
+    CHECK_EQ(rtab.link_latency(a), 100);
+
+    // Hops metric
+    CHECK_EQ(*rtab.gateway_for(C), b);
+
+    // Latency metric: 300 us through `a` vs 5100 us through `b`
+    rtab.set_route_metric(route_metric::latency, 20);
+    CHECK_EQ(*rtab.gateway_for(C), a);
+
+    // Link to `a` became slower: 4100 us vs 5100 us
+    rtab.set_link_latency(a, microseconds{3900});
+    CHECK_EQ(*rtab.gateway_for(C), a);
+
+    // Hysteresis: 5100 us vs 5000 us through `b` is not enough to switch
+    rtab.set_link_latency(a, microseconds{4900});
+    CHECK_EQ(*rtab.gateway_for(C), a);
+
+    // 7100 us vs 5100 us
+    rtab.set_link_latency(a, microseconds{6900});
+    CHECK_EQ(*rtab.gateway_for(C), b);
+
+    // ... and back: 5200 us vs 5100 us
+    rtab.set_link_latency(a, microseconds{5000});
+    CHECK_EQ(*rtab.gateway_for(C), b);
+
+    // Route through `b` lost
+    auto route_lost = [] (node_id, std::size_t) {};
+    auto node_unreachable = [] (node_id) {};
+
+    rtab.remove_routes(node_id{}, b, route_lost, node_unreachable);
+    CHECK_EQ(*rtab.gateway_for(C), a);
+
+    // Unknown latencies (of the link to `b` and the tail) are replaced by the default one
+    rtab.set_default_link_latency(microseconds{10});
+    rtab.add_sibling(b);
+    auto r3 = rtab.add_route(C, {b}).first;
+    rtab.set_route_latency(C, r3, {});
+    CHECK_EQ(rtab.link_latency(b), 0);
+    CHECK_EQ(*rtab.gateway_for(C), b);
+}
+
+TEST_CASE("multipath latency metric") {
+    //
+    //     +---a---c-------+
+    //     |               |
+    // A---+---b-----------+---C
+    //     |               |
+    //     +---d---e---f---+
+    //
+    using std::chrono::microseconds;
+
+    auto a = pfs::generate_uuid();
+    auto b = pfs::generate_uuid();
+    auto c = pfs::generate_uuid();
+    auto d = pfs::generate_uuid();
+    auto e = pfs::generate_uuid();
+    auto f = pfs::generate_uuid();
+    auto C = pfs::generate_uuid();
+
+    routing_table_t rtab;
+
+    rtab.add_sibling(a);
+    rtab.add_sibling(b);
+    rtab.add_sibling(d);
+
+    auto r1 = rtab.add_route(C, {a, c}).first;
+    auto r2 = rtab.add_route(C, {b}).first;
+    auto r3 = rtab.add_route(C, {d, e, f}).first;
+
+    // 300 us through `a`, 5100 us through `b` and 350 us through `d`
+    rtab.set_route_latency(C, r1, {100, 100});
+    rtab.set_route_latency(C, r2, {5000});
+    rtab.set_route_latency(C, r3, {100, 100, 100});
+    rtab.set_link_latency(a, microseconds{100});
+    rtab.set_link_latency(b, microseconds{100});
+    rtab.set_link_latency(d, microseconds{50});
+
+    rtab.set_route_metric(route_metric::latency, 20);
+    rtab.set_multipath(multipath_mode::per_message);
+    CHECK_EQ(*rtab.gateway_for(C), a);
+
+    auto load_fn = [] (node_id) { return std::size_t{0}; };
+
+    // Routes with latency close to the fastest one are used alternately, the shortest route
+    // (through `b`) is too slow
+    std::map<node_id, int> selected;
+
+    for (int i = 0; i < 10; i++)
+        selected[*rtab.select_gateway(C, 0, 10, load_fn)]++;
+
+    CHECK_EQ(selected[a], 5);
+    CHECK_EQ(selected[b], 0);
+    CHECK_EQ(selected[d], 5);
+
+    // Forwarded messages do not use routes longer than the fastest one
+    for (int i = 0; i < 10; i++)
+        CHECK_EQ(*rtab.select_gateway(C, 0, 10, load_fn, false), a);
+}
+
+TEST_CASE("route latencies serialization") {
+    route_info<node_id> rinfo;
+    rinfo.session_id = generate_session_id();
+    rinfo.initiator_id = pfs::generate_uuid();
+    rinfo.route.push_back(pfs::generate_uuid());
+    rinfo.latencies.push_back(100);
+
+    auto gw = pfs::generate_uuid();
+
+    auto parse = [] (archive_t const & ar) {
+        serializer_traits_t::deserializer_type in {ar.data(), ar.size()};
+        header h {in};
+        return route_packet<node_id> {h, in};
+    };
+
+    routing_table_t rtab;
+
+    // Hops metric: no latencies (compatible with the nodes unaware of them)
+    CHECK_FALSE(parse(rtab.serialize_request(gw, rinfo, 200)).is_f1());
+    CHECK_FALSE(parse(rtab.serialize_response(gw, rinfo, 200)).is_f1());
+    CHECK_FALSE(parse(rtab.serialize_response(rinfo)).is_f1());
+
+    rtab.set_route_metric(route_metric::latency);
+
+    auto pkt = parse(rtab.serialize_request(gw, rinfo, 200));
+    REQUIRE(pkt.is_f1());
+    CHECK_EQ(pkt.info().latencies, std::vector<std::uint32_t>{100, 200});
+
+    pkt = parse(rtab.serialize_response(gw, rinfo, 200));
+    REQUIRE(pkt.is_f1());
+    CHECK_EQ(pkt.info().latencies, std::vector<std::uint32_t>{100, 200});
+
+    pkt = parse(rtab.serialize_response(rinfo));
+    REQUIRE(pkt.is_f1());
+    CHECK_EQ(pkt.info().latencies, std::vector<std::uint32_t>{100});
+}
+
+TEST_CASE("incremental routes") {
+    //
+    // A---a---b---c---C
+    //     |       |
+    //     +---d---+
+    //
+    using update_t = route_update_info<node_id>;
+    constexpr auto UNREACHABLE = route_update_info<node_id>::UNREACHABLE();
+
+    auto b = pfs::generate_uuid();
+    auto d = pfs::generate_uuid();
+    auto C = pfs::generate_uuid();
+
+    // Routing table of the gateway `a`
+    routing_table_t rtab;
+
+    rtab.add_sibling(b);
+    rtab.add_sibling(d);
+    rtab.add_sibling_gateway(b);
+    rtab.add_sibling_gateway(d);
+
+    CHECK_FALSE(rtab.is_reachable(C));
+
+    // Own entries of the siblings do not produce new routes
+    CHECK_EQ(rtab.update_route(b, true, update_t{b, 0, 2}), route_update_result::updated);
+    CHECK_EQ(rtab.incremental_hops(b), 0);
+
+    // `C` advertised by `b` (b->c->C)
+    CHECK_EQ(rtab.update_route(b, true, update_t{C, 1, 4}), route_update_result::route_ready);
+    CHECK(rtab.is_reachable(C));
+    CHECK_EQ(*rtab.gateway_for(C), b);
+    CHECK_EQ(rtab.incremental_hops(C), 2);
+
+    // Same sequence number with the same metric through the other neighbor is ignored
+    CHECK_EQ(rtab.update_route(d, true, update_t{C, 1, 4}), route_update_result::ignored);
+    CHECK_EQ(*rtab.gateway_for(C), b);
+
+    // Newer sequence number through `d`
+    CHECK_EQ(rtab.update_route(d, true, update_t{C, 1, 6}), route_update_result::updated);
+    CHECK_EQ(*rtab.gateway_for(C), d);
+
+    // Stale update
+    CHECK_EQ(rtab.update_route(b, true, update_t{C, 0, 4}), route_update_result::ignored);
+
+    // Regular nodes advertise themselves only
+    CHECK_EQ(rtab.update_route(C, false, update_t{b, 0, 100}), route_update_result::ignored);
+
+    // Link to `d` lost
+    std::vector<node_id> lost;
+    rtab.invalidate_routes_via(d, [& lost] (node_id id) { lost.push_back(id); });
+
+    REQUIRE_EQ(lost.size(), 1);
+    CHECK_EQ(lost[0], C);
+    CHECK_FALSE(rtab.gateway_for(C));
+    CHECK_FALSE(rtab.is_reachable(C));
+    CHECK_EQ(rtab.route_update_for(C)->hops, UNREACHABLE);
+    CHECK_EQ(rtab.route_update_for(C)->seqno, 7);
+
+    // Unreachability with the same sequence number does not resurrect the route
+    CHECK_EQ(rtab.update_route(b, true, update_t{C, 1, 6}), route_update_result::ignored);
+    CHECK_EQ(rtab.update_route(b, true, update_t{C, UNREACHABLE, 7}), route_update_result::ignored);
+
+    // `C` outdated the unreachability by the next sequence number
+    CHECK_EQ(rtab.update_route(b, true, update_t{C, 1, 8}), route_update_result::route_ready);
+    CHECK_EQ(*rtab.gateway_for(C), b);
+
+    // Unreachability advertised by the next hop
+    CHECK_EQ(rtab.update_route(b, true, update_t{C, UNREACHABLE, 9}), route_update_result::route_lost);
+    CHECK_FALSE(rtab.is_reachable(C));
+
+    std::size_t count = 0;
+    rtab.foreach_route_update([& count] (update_t const &) { count++; });
+    CHECK_EQ(count, 2);
+}
+
+TEST_CASE("segment routes") {
+    //
+    // A0---a---b---c---C0
+    //
+    // Segments: A (1), B (2), C (3). Routing table of the gateway `a`.
+    //
+    using segment_update_t = route_update_info<segment_id_t>;
+    constexpr auto UNREACHABLE = route_update_info<segment_id_t>::UNREACHABLE();
+
+    auto A0 = pfs::generate_uuid();
+    auto b = pfs::generate_uuid();
+
+    routing_table_t rtab;
+
+    rtab.add_sibling(A0);
+    rtab.add_sibling(b);
+    rtab.add_sibling_gateway(b);
+
+    // Segment routes are advertised by gateways only
+    CHECK_EQ(rtab.update_segment_route(A0, false, segment_update_t{3, 0, 2}), route_update_result::ignored);
+    CHECK_FALSE(rtab.gateway_for_segment(3));
+
+    CHECK_EQ(rtab.update_segment_route(b, true, segment_update_t{2, 0, 2}), route_update_result::route_ready);
+    CHECK_EQ(rtab.update_segment_route(b, true, segment_update_t{3, 1, 2}), route_update_result::route_ready);
+    CHECK_EQ(*rtab.gateway_for_segment(2), b);
+    CHECK_EQ(*rtab.gateway_for_segment(3), b);
+    CHECK_EQ(rtab.segment_route_update_for(3)->hops, 2);
+
+    // Segment routes do not make the individual nodes reachable
+    CHECK_FALSE(rtab.is_reachable(pfs::generate_uuid()));
+
+    std::size_t count = 0;
+    rtab.foreach_segment_route([& count] (segment_id_t, node_id) { count++; });
+    CHECK_EQ(count, 2);
+
+    // Link to `b` lost
+    std::vector<segment_id_t> lost;
+    rtab.invalidate_segment_routes_via(b, [& lost] (segment_id_t segment) { lost.push_back(segment); });
+
+    CHECK_EQ(lost.size(), 2);
+    CHECK_FALSE(rtab.gateway_for_segment(2));
+    CHECK_EQ(rtab.segment_route_update_for(2)->hops, UNREACHABLE);
+    CHECK_EQ(rtab.segment_route_update_for(2)->seqno, 3);
+
+    count = 0;
+    rtab.foreach_segment_route_update([& count] (segment_update_t const &) { count++; });
+    CHECK_EQ(count, 2);
+}
+
+TEST_CASE("snapshot") {
+    //
+    // A---a---b---B
+    // |   |
+    // |   +---c---C
+    // |           |
+    // +---d-------+
+    //
+    auto a = pfs::generate_uuid();
+    auto b = pfs::generate_uuid();
+    auto c = pfs::generate_uuid();
+    auto d = pfs::generate_uuid();
+    auto B = pfs::generate_uuid();
+    auto C = pfs::generate_uuid();
+
+    archive_t snapshot;
+
+    {
+        routing_table_t rtab;
+
+        rtab.add_sibling(a);
+        rtab.add_sibling(d);
+        rtab.add_route(b, {a});
+        rtab.add_route(B, {a, b});
+        rtab.add_route(C, {a, c});
+        rtab.add_route(C, {d});
+
+        serializer_traits_t::serializer_type out {snapshot};
+        rtab.export_snapshot(out);
+    }
+
+    routing_table_t rtab;
+
+    {
+        serializer_traits_t::deserializer_type in {snapshot.data(), snapshot.size()};
+        CHECK(rtab.import_snapshot(in));
+    }
+
+    // Provisional routes are not used until the first gateway is reconnected
+    CHECK_FALSE(rtab.gateway_for(B));
+    CHECK_FALSE(rtab.is_reachable(B));
+
+    CHECK(rtab.add_sibling(a));
+    CHECK_EQ(*rtab.gateway_for(B), a);
+    CHECK(rtab.is_reachable(B));
+
+    // Route to `B` confirmed by the route discovery
+    auto res = rtab.add_route(B, {a, b});
+    CHECK_FALSE(rtab.is_provisional(B, res.first));
+    CHECK(res.second);
+
+    // Route to `C` through `d` is shorter when `d` reconnected
+    CHECK_EQ(*rtab.gateway_for(C), a);
+    CHECK(rtab.add_sibling(d));
+    CHECK_EQ(*rtab.gateway_for(C), d);
+
+    // Confirmed route is preferred
+    res = rtab.add_route(C, {a, c});
+    CHECK(res.second);
+    CHECK_FALSE(rtab.is_provisional(C, res.first));
+    CHECK_FALSE(rtab.add_route(C, {a, c}).second);
+    CHECK_EQ(*rtab.gateway_for(C), a);
+
+    std::vector<node_id> unreachable;
+
+    // Not confirmed routes: `b` and `C` through `d`
+    CHECK_EQ(rtab.remove_provisional_routes([& unreachable] (node_id id) {
+        unreachable.push_back(id);
+    }), 2);
+
+    CHECK_EQ(unreachable, std::vector<node_id>{b});
+    CHECK_FALSE(rtab.gateway_for(b));
+    CHECK_EQ(*rtab.gateway_for(B), a);
+    CHECK_EQ(*rtab.gateway_for(C), a);
+
+    // Malformed snapshot
+    {
+        routing_table_t rtab1;
+        serializer_traits_t::deserializer_type in {snapshot.data(), snapshot.size() - 1};
+        CHECK_FALSE(rtab1.import_snapshot(in));
+        CHECK_FALSE(rtab1.is_reachable(C));
+    }
+}
+
+TEST_CASE("benchmark") {
+    //
+    // 10 sibling gateways, 10 gateways behind each of them and 100 destination nodes behind each
+    // second level gateway: 10000 routes.
+    //
+    constexpr std::size_t GW_LIMIT = 10;
+    constexpr std::size_t DEST_LIMIT = 100;
+
+    using clock_type = std::chrono::steady_clock;
+
+    auto elapsed_us = [] (clock_type::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start).count();
+    };
+
+    std::vector<node_id> gws;
+    std::vector<std::vector<node_id>> subgws(GW_LIMIT);
+    std::vector<node_id> dests;
+
+    routing_table_t rtab;
+
+    for (std::size_t i = 0; i < GW_LIMIT; i++) {
+        gws.push_back(pfs::generate_uuid());
+        rtab.add_sibling(gws.back());
+        rtab.add_sibling_gateway(gws.back());
+
+        for (std::size_t j = 0; j < GW_LIMIT; j++)
+            subgws[i].push_back(pfs::generate_uuid());
+    }
+
+    auto start = clock_type::now();
+
+    for (std::size_t i = 0; i < GW_LIMIT; i++) {
+        for (std::size_t j = 0; j < GW_LIMIT; j++) {
+            for (std::size_t k = 0; k < DEST_LIMIT; k++) {
+                dests.push_back(pfs::generate_uuid());
+                rtab.add_route(dests.back(), {gws[i], subgws[i][j]});
+            }
+        }
+    }
+
+    MESSAGE("add 10000 routes: ", elapsed_us(start), " us");
+
+    // Duplicate routes
+    start = clock_type::now();
+
+    for (std::size_t i = 0; i < dests.size(); i++) {
+        auto n = i / DEST_LIMIT;
+        CHECK_FALSE(rtab.add_route(dests[i], {gws[n / GW_LIMIT], subgws[n / GW_LIMIT][n % GW_LIMIT]}).second);
+    }
+
+    MESSAGE("check 10000 duplicate routes: ", elapsed_us(start), " us");
+
+    for (int pass = 0; pass < 2; pass++) {
+        start = clock_type::now();
+
+        for (std::size_t i = 0; i < dests.size(); i++)
+            CHECK_EQ(*rtab.gateway_for(dests[i]), gws[i / (GW_LIMIT * DEST_LIMIT)]);
+
+        if (pass == 0)
+            MESSAGE("gateway_for 10000 destinations (cold): ", elapsed_us(start), " us");
+        else
+            MESSAGE("gateway_for 10000 destinations (cached): ", elapsed_us(start), " us");
+    }
+
+    std::size_t lost = 0;
+    std::size_t unreachable = 0;
+    auto route_lost = [& lost] (node_id, std::size_t) { lost++; };
+    auto node_unreachable = [& unreachable] (node_id) { unreachable++; };
+
+    // Link flap between the second level gateway and its destination
+    start = clock_type::now();
+    CHECK_EQ(rtab.remove_routes(subgws[5][5], dests[5 * GW_LIMIT * DEST_LIMIT + 5 * DEST_LIMIT]
+        , route_lost, node_unreachable), 1);
+    MESSAGE("remove route to destination: ", elapsed_us(start), " us");
+
+    // Second level gateway unreachable
+    start = clock_type::now();
+    CHECK_EQ(rtab.remove_routes(gws[1], subgws[1][1], route_lost, node_unreachable), DEST_LIMIT);
+    MESSAGE("remove routes through gateway: ", elapsed_us(start), " us");
+
+    // Sibling gateway lost
+    start = clock_type::now();
+    CHECK_EQ(rtab.remove_routes(node_id{}, gws[0], route_lost, node_unreachable)
+        , 1 + GW_LIMIT * DEST_LIMIT);
+    MESSAGE("remove routes through sibling gateway: ", elapsed_us(start), " us");
+
+    CHECK_EQ(lost, 2 + DEST_LIMIT + GW_LIMIT * DEST_LIMIT);
+    CHECK_EQ(unreachable, lost);
+
+    CHECK_FALSE(rtab.gateway_for(dests[0]));
+    CHECK_FALSE(rtab.gateway_for(dests[GW_LIMIT * DEST_LIMIT + DEST_LIMIT]));
+    CHECK_EQ(*rtab.gateway_for(dests[GW_LIMIT * DEST_LIMIT]), gws[1]);
+    CHECK_EQ(*rtab.gateway_for(dests.back()), gws.back());
+}
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.06.27 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+#include "pfs/netty/patterns/meshnet/unreachable_tracker.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace netty::meshnet;
+using std::chrono::milliseconds;
+using tracker_t = unreachable_tracker<int>;
+
+TEST_CASE("hold-down") {
+    tracker_t ut;
+    auto now = tracker_t::time_point_type{} + std::chrono::hours{1};
+
+    ut.set_hold_down(milliseconds{50});
+
+    ut.lost(1, now);
+    ut.lost(2, now + milliseconds{10});
+
+    // Notifications are not sent before the hold-down deadline
+    CHECK(ut.fetch_expired(now + milliseconds{49}).empty());
+    CHECK_EQ(ut.pending_count(), 2);
+
+    // Nodes lost during the hold-down interval are aggregated
+    auto ids = ut.fetch_expired(now + milliseconds{60});
+    std::sort(ids.begin(), ids.end());
+
+    CHECK_EQ(ids, std::vector<int>{1, 2});
+    CHECK_EQ(ut.pending_count(), 0);
+    CHECK(ut.fetch_expired(now + milliseconds{100}).empty());
+}
+
+TEST_CASE("flapping") {
+    tracker_t ut;
+    auto now = tracker_t::time_point_type{} + std::chrono::hours{1};
+
+    ut.set_hold_down(milliseconds{50});
+
+    ut.lost(1, now);
+    ut.lost(2, now);
+
+    // Channel with node 1 reestablished during the hold-down interval
+    CHECK(ut.restored(1));
+    CHECK_FALSE(ut.restored(3));
+
+    CHECK_EQ(ut.fetch_expired(now + milliseconds{50}), std::vector<int>{2});
+
+    // Repeated loss is held down again
+    ut.lost(1, now + milliseconds{100});
+    CHECK(ut.restored(1));
+    CHECK(ut.fetch_expired(now + milliseconds{200}).empty());
+}
+
+TEST_CASE("duplicates") {
+    tracker_t ut;
+    auto now = tracker_t::time_point_type{} + std::chrono::hours{1};
+    int const gw1 = 100;
+    int const gw2 = 200;
+
+    CHECK(ut.accept(gw1, 1, 10, now));
+
+    // Same notification received by the other path
+    CHECK_FALSE(ut.accept(gw1, 1, 10, now));
+
+    // Outdated notification
+    CHECK_FALSE(ut.accept(gw1, 1, 9, now));
+
+    // Newer notification, other node or other gateway
+    CHECK(ut.accept(gw1, 1, 11, now));
+    CHECK(ut.accept(gw1, 2, 10, now));
+    CHECK(ut.accept(gw2, 1, 10, now));
+
+    // Generation wraparound
+    CHECK(ut.accept(gw1, 3, 0xFFFFFFFF, now));
+    CHECK(ut.accept(gw1, 3, 1, now));
+
+    // Notifications in the previous format (no generation) are never suppressed
+    CHECK(ut.accept(gw1, 4, 0, now));
+    CHECK(ut.accept(gw1, 4, 0, now));
+
+    // Expired records do not suppress notifications of the restarted gateway
+    ut.purge(now + tracker_t::SEEN_TIMEOUT());
+    CHECK(ut.accept(gw1, 1, 5, now + tracker_t::SEEN_TIMEOUT()));
+}
+
+TEST_CASE("generation") {
+    tracker_t ut1;
+    auto g1 = ut1.next_generation();
+    auto g2 = ut1.next_generation();
+
+    CHECK_NE(g1, 0);
+    CHECK_EQ(static_cast<std::int32_t>(g2 - g1), 1);
+
+    // Generations of the node restarted later outdate the previous ones
+    std::this_thread::sleep_for(milliseconds{10});
+    tracker_t ut2;
+    CHECK_GT(static_cast<std::int32_t>(ut2.next_generation() - g2), 0);
+}
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.05.22 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/netty/mpsc_queue.hpp"
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("basic") {
+    netty::mpsc_queue<std::string> q;
+    std::string value;
+
+    CHECK_FALSE(q.try_pop(value));
+
+    q.push(std::string{"A"});
+    q.push(std::string{"B"});
+    q.push(std::string{"C"});
+
+    CHECK(q.try_pop(value));
+    CHECK_EQ(value, "A");
+
+    std::vector<std::string> rest;
+    CHECK_EQ(q.drain([& rest] (std::string && s) { rest.push_back(std::move(s)); }), 2);
+    CHECK_EQ(rest, std::vector<std::string>{"B", "C"});
+    CHECK_FALSE(q.try_pop(value));
+
+    // Not popped values are released by destructor
+    q.push(std::string{"D"});
+}
+
+TEST_CASE("multiple producers") {
+    constexpr int PRODUCER_COUNT = 4;
+    constexpr int VALUE_COUNT = 10000;
+
+    netty::mpsc_queue<int> q;
+    std::array<std::thread, PRODUCER_COUNT> producers;
+    std::atomic_int finished {0};
+
+    for (int i = 0; i < PRODUCER_COUNT; i++) {
+        producers[i] = std::thread {[&, i] () {
+            for (int j = 0; j < VALUE_COUNT; j++)
+                q.push(i * VALUE_COUNT + j);
+
+            ++finished;
+        }};
+    }
+
+    std::vector<int> last(PRODUCER_COUNT, -1);
+    int total = 0;
+
+    auto consume = [&] (int && value) {
+        auto producer_index = value / VALUE_COUNT;
+
+        // Order of values from the same producer is preserved
+        CHECK_LT(last[producer_index], value);
+        last[producer_index] = value;
+        total++;
+    };
+
+    while (finished.load() < PRODUCER_COUNT)
+        q.drain(consume);
+
+    for (auto & t: producers)
+        t.join();
+
+    q.drain(consume);
+
+    CHECK_EQ(total, PRODUCER_COUNT * VALUE_COUNT);
+}
@@ -5,11 +5,14 @@
 //
 // Changelog:
 //      2025.11.27 Initial version.
+//      2026.05.16 Added tests for topic and subscription packets.
+//      2026.06.27 Added test for corrupted topic.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../doctest.h"
 #include "../serializer_traits.hpp"
 #include "pfs/netty/patterns/pubsub/input_controller.hpp"
+#include <string>
 #include <vector>
 
 using input_controller_t = netty::pubsub::input_controller<serializer_traits_t>;
@@ -51,3 +54,97 @@ TEST_CASE("data") {
     CHECK(payload.empty());
     CHECK_EQ(counter, 3);
 }
+
+TEST_CASE("topic") {
+    using data_packet_t = netty::pubsub::data_packet;
+
+    int counter = 0;
+    int topic_counter = 0;
+
+    archive_t payload;
+    serializer_traits_t::serializer_type out {payload};
+
+    data_packet_t pkt1;
+    pkt1.serialize(out, "ABC", 3);
+
+    data_packet_t pkt2;
+    pkt2.set_topic("quotes/AAPL");
+    pkt2.serialize(out, "DEF", 3);
+
+    input_controller_t ic;
+
+    ic.on_data_ready = [&] (archive_t && msg) {
+        CHECK_EQ(msg, archive_t{"ABC", 3});
+        counter++;
+    };
+
+    ic.on_topic_data_ready = [&] (std::string const & topic, archive_t && msg) {
+        CHECK_EQ(topic, std::string{"quotes/AAPL"});
+        CHECK_EQ(msg, archive_t{"DEF", 3});
+        topic_counter++;
+    };
+
+    archive_t frames;
+    pack_payload(frames, payload);
+    ic.process_input(std::move(frames));
+
+    CHECK_EQ(counter, 1);
+    CHECK_EQ(topic_counter, 1);
+}
+
+TEST_CASE("corrupted topic") {
+    using data_packet_t = netty::pubsub::data_packet;
+
+    archive_t payload;
+    serializer_traits_t::serializer_type out {payload};
+
+    data_packet_t pkt;
+    pkt.set_topic("quotes/AAPL");
+    pkt.serialize(out, "DEF", 3);
+
+    std::string bytes {payload.data(), payload.size()};
+    auto pos = bytes.find("AAPL");
+    REQUIRE_NE(pos, std::string::npos);
+    bytes[pos] = 'B';
+
+    archive_t corrupted {bytes.data(), bytes.size()};
+    archive_t frames;
+    pack_payload(frames, corrupted);
+
+    input_controller_t ic;
+    int topic_counter = 0;
+
+    ic.on_topic_data_ready = [&] (std::string const &, archive_t &&) {
+        topic_counter++;
+    };
+
+    CHECK_THROWS_AS(ic.process_input(std::move(frames)), netty::error);
+    CHECK_EQ(topic_counter, 0);
+}
+
+TEST_CASE("subscription") {
+    using subscription_packet_t = netty::pubsub::subscription_packet;
+    using packet_enum = netty::pubsub::packet_enum;
+
+    std::vector<std::string> subscribed;
+    std::vector<std::string> unsubscribed;
+
+    archive_t payload;
+    serializer_traits_t::serializer_type out {payload};
+
+    subscription_packet_t {packet_enum::subscribe, "quotes/*"}.serialize(out);
+    subscription_packet_t {packet_enum::subscribe, "trades/AAPL"}.serialize(out);
+    subscription_packet_t {packet_enum::unsubscribe, "quotes/*"}.serialize(out);
+
+    input_controller_t ic;
+
+    ic.on_subscribe = [&] (std::string const & pattern) { subscribed.push_back(pattern); };
+    ic.on_unsubscribe = [&] (std::string const & pattern) { unsubscribed.push_back(pattern); };
+
+    archive_t frames;
+    pack_payload(frames, payload);
+    ic.process_input(std::move(frames));
+
+    CHECK_EQ(subscribed, std::vector<std::string>{"quotes/*", "trades/AAPL"});
+    CHECK_EQ(unsubscribed, std::vector<std::string>{"quotes/*"});
+}
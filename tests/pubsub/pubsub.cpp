@@ -5,6 +5,8 @@
 //
 // Changelog:
 //      2025.08.08 Initial version.
+//      2026.05.14 Added test for slow subscriber policy.
+//      2026.05.16 Added test for topic-based subscriptions.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../doctest.h"
@@ -22,6 +24,8 @@
 #endif
 
 constexpr std::uint16_t PORT1 = 4242;
+constexpr std::uint16_t PORT2 = 4243;
+constexpr std::uint16_t PORT3 = 4244;
 constexpr int SUBSCRIBER_LIMIT = 10;
 constexpr int MESSAGE_LIMIT = 100;
 
@@ -112,3 +116,161 @@ TEST_CASE("basic") {
     pub1.interrupt();
     pub1_thread.join();
 }
+
+TEST_CASE("slow subscriber") {
+    using publisher_t = netty::pubsub::suitable_publisher<serializer_traits_t>;
+    using subscriber_t = netty::pubsub::suitable_subscriber<serializer_traits_t>;
+
+    netty::startup_guard netty_startup;
+
+    std::atomic_bool pub_ready_flag {false};
+    std::atomic_int accepted_counter {0};
+    int slow_subscriber_counter = 0;
+
+    netty::listener_options listener_opts;
+    listener_opts.saddr = netty::socket4_addr{netty::inet4_addr::any_addr_value, PORT2};
+
+    publisher_t pub {listener_opts};
+    subscriber_t sub;
+
+    pub.set_slow_subscriber_policy(256, netty::pubsub::slow_subscriber_policy::disconnect);
+    pub.on_accepted([& accepted_counter] (netty::socket4_addr) { ++accepted_counter; });
+    pub.on_slow_subscriber([& slow_subscriber_counter] (netty::socket4_addr) {
+        ++slow_subscriber_counter;
+    });
+
+    pub.listen();
+
+    auto pub_thread = std::thread {[&] () {
+        pub_ready_flag.store(true);
+        pub.run();
+    }};
+
+    auto sub_thread = std::thread {[&] () {
+        CHECK(tools::wait_atomic_bool(pub_ready_flag));
+
+        netty::connection_options conn_opts;
+        conn_opts.remote_saddr = netty::socket4_addr{netty::inet4_addr::localhost_addr_value, PORT2};
+        REQUIRE(sub.connect(conn_opts));
+        sub.run();
+    }};
+
+    CHECK(tools::wait_atomic_counter(accepted_counter, 1));
+
+    // Stop the publisher loop to accumulate the backlog
+    pub.interrupt();
+    pub_thread.join();
+
+    std::string text(32, 'x');
+
+    for (int i = 0; i < 3; i++)
+        pub.broadcast(text.data(), text.size());
+
+    int lag_counter = 0;
+
+    pub.foreach_subscriber_lag([& lag_counter] (netty::pubsub::subscriber_lag const & lag) {
+        CHECK_EQ(lag.backlog_messages, 3);
+        CHECK_EQ(lag.dropped_messages, 0);
+        ++lag_counter;
+    });
+
+    CHECK_EQ(lag_counter, 1);
+
+    for (int i = 0; i < 10; i++)
+        pub.broadcast(text.data(), text.size());
+
+    CHECK_EQ(slow_subscriber_counter, 1);
+
+    pub.step();
+
+    lag_counter = 0;
+    pub.foreach_subscriber_lag([& lag_counter] (netty::pubsub::subscriber_lag const &) { ++lag_counter; });
+    CHECK_EQ(lag_counter, 0);
+
+    sub.interrupt();
+    sub_thread.join();
+}
+
+TEST_CASE("topics") {
+    using publisher_t = netty::pubsub::suitable_publisher<serializer_traits_t>;
+    using subscriber_t = netty::pubsub::suitable_subscriber<serializer_traits_t>;
+
+    netty::startup_guard netty_startup;
+
+    std::atomic_bool pub_ready_flag {false};
+    std::atomic_int accepted_counter {0};
+    std::atomic_int subscribed_counter {0};
+    std::atomic_int aapl_counter {0};
+    std::atomic_int quotes_counter {0};
+    std::atomic_int broadcast_counter {0};
+
+    netty::listener_options listener_opts;
+    listener_opts.saddr = netty::socket4_addr{netty::inet4_addr::any_addr_value, PORT3};
+
+    publisher_t pub {listener_opts};
+    std::array<subscriber_t, 2> subs;
+
+    pub.on_accepted([& accepted_counter] (netty::socket4_addr) { ++accepted_counter; });
+    pub.on_subscribed([& subscribed_counter] (netty::socket4_addr, std::string const &) {
+        ++subscribed_counter;
+    });
+    pub.listen();
+
+    auto pub_thread = std::thread {[&] () {
+        pub_ready_flag.store(true);
+        pub.run();
+    }};
+
+    subs[0].subscribe("quotes/AAPL");
+    subs[1].subscribe("quotes/*");
+
+    subs[0].on_topic_data_ready([&] (std::string const & topic, archive_t) {
+        CHECK_EQ(topic, std::string{"quotes/AAPL"});
+        ++aapl_counter;
+    });
+
+    subs[1].on_topic_data_ready([&] (std::string const & topic, archive_t) {
+        CHECK_EQ(topic.substr(0, 7), std::string{"quotes/"});
+        ++quotes_counter;
+    });
+
+    for (auto & sub: subs)
+        sub.on_data_ready([&] (archive_t) { ++broadcast_counter; });
+
+    std::array<std::thread, 2> sub_threads;
+
+    for (std::size_t i = 0; i < subs.size(); i++) {
+        sub_threads[i] = std::thread {[&, i] () {
+            CHECK(tools::wait_atomic_bool(pub_ready_flag));
+
+            netty::connection_options conn_opts;
+            conn_opts.remote_saddr = netty::socket4_addr{netty::inet4_addr::localhost_addr_value, PORT3};
+            REQUIRE(subs[i].connect(conn_opts));
+            subs[i].run();
+        }};
+    }
+
+    CHECK(tools::wait_atomic_counter(accepted_counter, 2));
+
+    // Wait for subscription requests
+    CHECK(tools::wait_atomic_counter(subscribed_counter, 2));
+
+    std::string text {"HELLO"};
+
+    pub.publish("quotes/AAPL", text.data(), text.size());
+    pub.publish("quotes/MSFT", text.data(), text.size());
+    pub.publish("trades/AAPL", text.data(), text.size());
+    pub.broadcast(text.data(), text.size());
+
+    CHECK(tools::wait_atomic_counter(broadcast_counter, 2));
+    CHECK(tools::wait_atomic_counter(quotes_counter, 2));
+    CHECK(tools::wait_atomic_counter(aapl_counter, 1));
+
+    for (std::size_t i = 0; i < subs.size(); i++) {
+        subs[i].interrupt();
+        sub_threads[i].join();
+    }
+
+    pub.interrupt();
+    pub_thread.join();
+}
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.05.16 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+#include "pfs/netty/patterns/pubsub/topic_index.hpp"
+#include <string>
+#include <vector>
+
+using topic_index_t = netty::pubsub::topic_index<int>;
+
+static std::vector<int> match (topic_index_t const & index, std::string const & topic)
+{
+    std::vector<int> result;
+    index.match(topic, [& result] (int sid) { result.push_back(sid); });
+    return result;
+}
+
+TEST_CASE("exact") {
+    topic_index_t index;
+
+    CHECK(index.empty());
+
+    index.subscribe(1, "quotes/AAPL");
+    index.subscribe(2, "quotes/MSFT");
+    index.subscribe(3, "quotes/AAPL");
+
+    CHECK_FALSE(index.empty());
+    CHECK_EQ(match(index, "quotes/AAPL"), std::vector<int>{1, 3});
+    CHECK_EQ(match(index, "quotes/MSFT"), std::vector<int>{2});
+    CHECK(match(index, "quotes/GOOG").empty());
+    CHECK(match(index, "quotes").empty());
+
+    index.unsubscribe(1, "quotes/AAPL");
+    CHECK_EQ(match(index, "quotes/AAPL"), std::vector<int>{3});
+    CHECK_FALSE(index.has_subscriptions(1));
+}
+
+TEST_CASE("prefix") {
+    topic_index_t index;
+
+    index.subscribe(1, "quotes/*");
+    index.subscribe(2, "*");
+    index.subscribe(3, "quotes/AAPL");
+    index.subscribe(3, "quotes/A*");
+
+    // Subscriber matched by several patterns is reported once
+    CHECK_EQ(match(index, "quotes/AAPL"), std::vector<int>{1, 2, 3});
+    CHECK_EQ(match(index, "quotes/MSFT"), std::vector<int>{1, 2});
+    CHECK_EQ(match(index, "trades/AAPL"), std::vector<int>{2});
+
+    index.remove(3);
+    CHECK_FALSE(index.has_subscriptions(3));
+    CHECK_EQ(match(index, "quotes/AAPL"), std::vector<int>{1, 2});
+
+    index.unsubscribe(2, "*");
+    CHECK(match(index, "trades/AAPL").empty());
+
+    index.remove(1);
+    CHECK(index.empty());
+}
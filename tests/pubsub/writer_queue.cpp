@@ -5,6 +5,9 @@
 //
 // Changelog:
 //      2025.11.27 Initial version.
+//      2026.05.12 Added test for queue limits.
+//      2026.05.14 Added test for conflate policy.
+//      2026.06.27 Added test for conflation by key.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../doctest.h"
@@ -50,3 +53,93 @@ TEST_CASE("basic") {
     REQUIRE_EQ(counter, 3);
 }
 
+
+TEST_CASE("limits") {
+    writer_queue_t wq;
+    netty::writer_queue_limits limits;
+    limits.max_bytes = 8;
+    limits.overflow_policy = netty::queue_overflow_policy::drop_oldest;
+    wq.set_limits(limits);
+
+    CHECK(wq.enqueue(0, "ABC", 3).accepted);
+    CHECK(wq.enqueue(0, "DEF", 3).accepted);
+
+    auto occupancy = wq.enqueue(0, "JHI", 3);
+    CHECK(occupancy.accepted);
+    CHECK_EQ(occupancy.dropped, 1);
+    CHECK_EQ(occupancy.bytes, 6);
+    CHECK_EQ(occupancy.messages, 2);
+
+    limits.overflow_policy = netty::queue_overflow_policy::reject;
+    wq.set_limits(limits);
+
+    occupancy = wq.enqueue(0, "KLM", 3);
+    CHECK_FALSE(occupancy.accepted);
+    CHECK_EQ(occupancy.bytes, 6);
+
+    auto frame = wq.acquire_frame(100);
+    REQUIRE_FALSE(frame.empty());
+    wq.shift(frame.size());
+
+    CHECK_EQ(wq.occupancy().bytes, 3);
+    CHECK_EQ(wq.occupancy().messages, 1);
+}
+
+TEST_CASE("conflate") {
+    writer_queue_t wq;
+    netty::writer_queue_limits limits;
+    limits.max_bytes = 8;
+    limits.overflow_policy = netty::queue_overflow_policy::conflate;
+    wq.set_limits(limits);
+
+    CHECK(wq.enqueue(0, "ABC", 3).accepted);
+    CHECK(wq.enqueue(0, "DEF", 3).accepted);
+
+    auto occupancy = wq.enqueue(0, "JHI", 3);
+    CHECK(occupancy.accepted);
+    CHECK_EQ(occupancy.dropped, 2);
+    CHECK_EQ(occupancy.bytes, 3);
+    CHECK_EQ(occupancy.messages, 1);
+
+    auto frame = wq.acquire_frame(100);
+    REQUIRE_FALSE(frame.empty());
+    CHECK_NE(std::string(frame.data(), frame.size()).find("JHI"), std::string::npos);
+}
+
+TEST_CASE("conflate by key") {
+    writer_queue_t wq;
+    netty::writer_queue_limits limits;
+    limits.max_bytes = 8;
+    limits.overflow_policy = netty::queue_overflow_policy::conflate;
+    wq.set_limits(limits);
+
+    CHECK(wq.enqueue(0, "A1", 2, "a").accepted);
+    CHECK(wq.enqueue(0, "B1", 2, "b").accepted);
+    CHECK(wq.enqueue(0, "A2", 2, "a").accepted);
+    CHECK(wq.enqueue(0, "B2", 2, "b").accepted);
+
+    // Overflow: the pending messages with the key `b` are dropped only
+    auto occupancy = wq.enqueue(0, "B3", 2, "b");
+    CHECK(occupancy.accepted);
+    CHECK_EQ(occupancy.dropped, 2);
+    CHECK_EQ(occupancy.messages, 3);
+
+    // Message with the key `c` doesn't fit: the oldest message is dropped
+    occupancy = wq.enqueue(0, "C1C1C1", 6, "c");
+    CHECK(occupancy.accepted);
+    CHECK_EQ(occupancy.dropped, 2);
+    CHECK_EQ(occupancy.messages, 2);
+
+    std::string content;
+
+    for (auto frame = wq.acquire_frame(100); !frame.empty(); frame = wq.acquire_frame(100)) {
+        content.append(frame.data(), frame.size());
+        wq.shift(frame.size());
+    }
+
+    CHECK_EQ(content.find("A1"), std::string::npos);
+    CHECK_EQ(content.find("A2"), std::string::npos);
+    CHECK_EQ(content.find("B2"), std::string::npos);
+    CHECK_NE(content.find("B3"), std::string::npos);
+    CHECK_NE(content.find("C1C1C1"), std::string::npos);
+}
@@ -0,0 +1,389 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.05.20 Initial version.
+//      2026.05.24 Added static visitor tests.
+//      2026.06.27 Added bad key index test.
+//                 Added previous values table test.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+#include "../serializer_traits.hpp"
+#include "pfs/netty/patterns/telemetry/compact_serializer.hpp"
+#include "pfs/netty/patterns/telemetry/serializer.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using serializer_t = serializer_traits_t::serializer_type;
+using deserializer_t = serializer_traits_t::deserializer_type;
+
+template <typename KeyT>
+class collector: public netty::telemetry::visitor_interface<KeyT>
+{
+public:
+    std::vector<KeyT> keys;
+    std::vector<std::int64_t> timestamps;
+    std::vector<std::int64_t> ints;
+    std::vector<double> floats;
+    std::vector<std::string> strings;
+    std::vector<bool> bools;
+    int errors {0};
+
+public:
+    void on (KeyT const & key, bool value) override { keys.push_back(key); bools.push_back(value); }
+    void on (KeyT const & key, netty::telemetry::int8_t value) override { keys.push_back(key); ints.push_back(value); }
+    void on (KeyT const & key, netty::telemetry::int16_t value) override { keys.push_back(key); ints.push_back(value); }
+    void on (KeyT const & key, netty::telemetry::int32_t value) override { keys.push_back(key); ints.push_back(value); }
+    void on (KeyT const & key, netty::telemetry::int64_t value) override { keys.push_back(key); ints.push_back(value); }
+    void on (KeyT const & key, netty::telemetry::float32_t value) override { keys.push_back(key); floats.push_back(value); }
+    void on (KeyT const & key, netty::telemetry::float64_t value) override { keys.push_back(key); floats.push_back(value); }
+    void on (KeyT const & key, netty::telemetry::string_t const & value) override { keys.push_back(key); strings.push_back(value); }
+    void on_timestamp (KeyT const &, std::int64_t msecs) override { timestamps.push_back(msecs); }
+    void on_error (std::string const &) override { errors++; }
+};
+
+// Static visitor (no virtual methods, string keys and values as views)
+template <typename KeyT>
+struct view_collector
+{
+    using key_type = typename netty::telemetry::view_key<KeyT>::type;
+
+    std::vector<KeyT> keys;
+    std::vector<std::int64_t> timestamps;
+    std::vector<std::int64_t> ints;
+    std::vector<double> floats;
+    std::vector<std::string> strings;
+    std::vector<bool> bools;
+    int errors {0};
+
+    void add_key (key_type const & key) { keys.push_back(KeyT(key.data(), key.size())); }
+    void on (key_type const & key, bool value) { add_key(key); bools.push_back(value); }
+    void on (key_type const & key, netty::telemetry::int8_t value) { add_key(key); ints.push_back(value); }
+    void on (key_type const & key, netty::telemetry::int16_t value) { add_key(key); ints.push_back(value); }
+    void on (key_type const & key, netty::telemetry::int32_t value) { add_key(key); ints.push_back(value); }
+    void on (key_type const & key, netty::telemetry::int64_t value) { add_key(key); ints.push_back(value); }
+    void on (key_type const & key, netty::telemetry::float32_t value) { add_key(key); floats.push_back(value); }
+    void on (key_type const & key, netty::telemetry::float64_t value) { add_key(key); floats.push_back(value); }
+    void on (key_type const & key, netty::telemetry::string_view_t value) { add_key(key); strings.emplace_back(value.data(), value.size()); }
+    void on_timestamp (key_type const &, std::int64_t msecs) { timestamps.push_back(msecs); }
+    void on_error (std::string const &) { errors++; }
+};
+
+TEST_CASE("varint") {
+    std::vector<std::uint64_t> samples {0, 1, 127, 128, 300, 0xFFFFFFFFu, 0xFFFFFFFFFFFFFFFFull};
+
+    for (auto x: samples) {
+        archive_t ar;
+        serializer_t out {ar};
+        netty::telemetry::details::write_varint(out, x);
+
+        deserializer_t in {ar.data(), ar.size()};
+        CHECK_EQ(netty::telemetry::details::read_varint(in), x);
+        CHECK(in.is_good());
+    }
+
+    for (std::int64_t x: {std::int64_t{0}, std::int64_t{-1}, std::int64_t{1}, std::int64_t{-4242}
+            , std::int64_t{INT64_MIN}, std::int64_t{INT64_MAX}}) {
+        CHECK_EQ(netty::telemetry::details::zigzag_decode(netty::telemetry::details::zigzag_encode(x)), x);
+    }
+}
+
+TEST_CASE("string keys") {
+    using encoder_t = netty::telemetry::compact_encoder<std::string, serializer_t>;
+    using decoder_t = netty::telemetry::compact_key_value_deserializer<std::string, deserializer_t>;
+    using plain_serializer_t = netty::telemetry::key_value_serializer<std::string, serializer_t>;
+
+    std::int64_t base_time = 1700000000000;
+    archive_t compact;
+    archive_t plain;
+    encoder_t encoder;
+
+    for (int i = 0; i < 100; i++) {
+        serializer_t out {compact};
+        serializer_t plain_out {plain};
+        auto value = 20.5 + i * 0.25;
+
+        encoder.encode(out, std::string{"temperature"}, value, base_time + i);
+        encoder.encode(out, std::string{"counter"}, netty::telemetry::int64_t{1000000 + i}, base_time + i);
+        plain_serializer_t(plain_out, std::string{"temperature"}, value);
+        plain_serializer_t(plain_out, std::string{"counter"}, netty::telemetry::int64_t{1000000 + i});
+    }
+
+    {
+        serializer_t out {compact};
+        encoder.encode(out, std::string{"online"}, true, base_time + 100);
+        encoder.encode(out, std::string{"hello"}, std::string{"world"}, base_time + 100);
+    }
+
+    CHECK_LT(compact.size() * 2, plain.size());
+
+    auto c = std::make_shared<collector<std::string>>();
+    decoder_t{compact.data(), compact.size(), c};
+
+    REQUIRE_EQ(c->keys.size(), 202);
+    REQUIRE_EQ(c->floats.size(), 100);
+    REQUIRE_EQ(c->ints.size(), 100);
+    CHECK_EQ(c->errors, 0);
+
+    for (int i = 0; i < 100; i++) {
+        CHECK_EQ(c->keys[i * 2], std::string{"temperature"});
+        CHECK_EQ(c->keys[i * 2 + 1], std::string{"counter"});
+        CHECK_EQ(c->floats[i], 20.5 + i * 0.25);
+        CHECK_EQ(c->ints[i], 1000000 + i);
+        CHECK_EQ(c->timestamps[i * 2], base_time + i);
+    }
+
+    CHECK_EQ(c->bools, std::vector<bool>{true});
+    CHECK_EQ(c->strings, std::vector<std::string>{"world"});
+    CHECK_EQ(c->timestamps.back(), base_time + 100);
+
+    // New batch is self-contained
+    encoder.reset();
+    archive_t batch;
+
+    {
+        serializer_t out {batch};
+        encoder.encode(out, std::string{"counter"}, netty::telemetry::int8_t{-42}, base_time);
+        encoder.encode(out, std::string{"ratio"}, netty::telemetry::float32_t{0.5f}, base_time);
+    }
+
+    c = std::make_shared<collector<std::string>>();
+    decoder_t{batch.data(), batch.size(), c};
+
+    CHECK_EQ(c->keys, std::vector<std::string>{"counter", "ratio"});
+    CHECK_EQ(c->ints, std::vector<std::int64_t>{-42});
+    CHECK_EQ(c->floats, std::vector<double>{0.5});
+}
+
+TEST_CASE("integer keys") {
+    using encoder_t = netty::telemetry::compact_encoder<std::uint16_t, serializer_t>;
+    using decoder_t = netty::telemetry::compact_key_value_deserializer<std::uint16_t, deserializer_t>;
+
+    archive_t ar;
+    encoder_t encoder;
+
+    {
+        serializer_t out {ar};
+        encoder.encode(out, std::uint16_t{1001}, netty::telemetry::int32_t{-5}, 42);
+        encoder.encode(out, std::uint16_t{1001}, netty::telemetry::int32_t{INT32_MAX}, 43);
+        encoder.encode(out, std::uint16_t{1002}, netty::telemetry::int16_t{7}, 44);
+    }
+
+    auto c = std::make_shared<collector<std::uint16_t>>();
+    decoder_t{ar.data(), ar.size(), c};
+
+    CHECK_EQ(c->keys, std::vector<std::uint16_t>{1001, 1001, 1002});
+    CHECK_EQ(c->ints, std::vector<std::int64_t>{-5, INT32_MAX, 7});
+    CHECK_EQ(c->timestamps, std::vector<std::int64_t>{42, 43, 44});
+}
+
+TEST_CASE("static visitor") {
+    using plain_serializer_t = netty::telemetry::key_value_serializer<std::string, serializer_t>;
+    using plain_decoder_t = netty::telemetry::key_value_view_deserializer<std::string, deserializer_t>;
+    using encoder_t = netty::telemetry::compact_encoder<std::string, serializer_t>;
+    using compact_decoder_t = netty::telemetry::compact_key_value_view_deserializer<std::string>;
+
+    archive_t plain;
+    archive_t compact;
+    encoder_t encoder;
+
+    {
+        serializer_t out {plain};
+        serializer_t compact_out {compact};
+
+        plain_serializer_t(out, std::string{"temperature"}, 36.6);
+        plain_serializer_t(out, std::string{"counter"}, netty::telemetry::int64_t{-100});
+        plain_serializer_t(out, std::string{"online"}, true);
+        plain_serializer_t(out, std::string{"hello"}, std::string{"world"});
+
+        encoder.encode(compact_out, std::string{"temperature"}, 36.6, 1000);
+        encoder.encode(compact_out, std::string{"counter"}, netty::telemetry::int64_t{-100}, 1001);
+        encoder.encode(compact_out, std::string{"online"}, true, 1002);
+        encoder.encode(compact_out, std::string{"hello"}, std::string{"world"}, 1003);
+        encoder.encode(compact_out, std::string{"counter"}, netty::telemetry::int64_t{-99}, 1004);
+    }
+
+    view_collector<std::string> c;
+    plain_decoder_t plain_decoder;
+    plain_decoder.decode(plain.data(), plain.size(), c);
+
+    CHECK_EQ(c.errors, 0);
+    CHECK_EQ(c.keys, std::vector<std::string>{"temperature", "counter", "online", "hello"});
+    CHECK_EQ(c.floats, std::vector<double>{36.6});
+    CHECK_EQ(c.ints, std::vector<std::int64_t>{-100});
+    CHECK_EQ(c.bools, std::vector<bool>{true});
+    CHECK_EQ(c.strings, std::vector<std::string>{"world"});
+    CHECK(c.timestamps.empty());
+
+    // Decoder is reusable and its state is reset for each batch
+    compact_decoder_t compact_decoder;
+
+    for (int i = 0; i < 2; i++) {
+        view_collector<std::string> cc;
+        compact_decoder.decode(compact.data(), compact.size(), cc);
+
+        CHECK_EQ(cc.errors, 0);
+        CHECK_EQ(cc.keys, std::vector<std::string>{"temperature", "counter", "online", "hello", "counter"});
+        CHECK_EQ(cc.floats, std::vector<double>{36.6});
+        CHECK_EQ(cc.ints, std::vector<std::int64_t>{-100, -99});
+        CHECK_EQ(cc.bools, std::vector<bool>{true});
+        CHECK_EQ(cc.strings, std::vector<std::string>{"world"});
+        CHECK_EQ(cc.timestamps, std::vector<std::int64_t>{1000, 1001, 1002, 1003, 1004});
+    }
+
+    // Truncated data
+    plain_decoder_t truncated_decoder;
+    view_collector<std::string> tc;
+    CHECK_THROWS(truncated_decoder.decode(plain.data(), plain.size() - 2, tc));
+}
+
+TEST_CASE("static visitor with integer keys") {
+    using plain_serializer_t = netty::telemetry::key_value_serializer<std::uint16_t, serializer_t>;
+    using plain_decoder_t = netty::telemetry::key_value_view_deserializer<std::uint16_t, deserializer_t>;
+    using encoder_t = netty::telemetry::compact_encoder<std::uint16_t, serializer_t>;
+    using compact_decoder_t = netty::telemetry::compact_key_value_view_deserializer<std::uint16_t>;
+
+    struct counter
+    {
+        std::vector<std::uint16_t> keys;
+        std::vector<std::int64_t> ints;
+        int errors {0};
+
+        void on (std::uint16_t key, bool) { keys.push_back(key); }
+        void on (std::uint16_t key, std::int64_t value) { keys.push_back(key); ints.push_back(value); }
+        void on (std::uint16_t key, std::int32_t value) { keys.push_back(key); ints.push_back(value); }
+        void on (std::uint16_t key, std::int16_t value) { keys.push_back(key); ints.push_back(value); }
+        void on (std::uint16_t key, std::int8_t value) { keys.push_back(key); ints.push_back(value); }
+        void on (std::uint16_t key, float) { keys.push_back(key); }
+        void on (std::uint16_t key, double) { keys.push_back(key); }
+        void on (std::uint16_t key, netty::telemetry::string_view_t) { keys.push_back(key); }
+        void on_error (std::string const &) { errors++; }
+    };
+
+    archive_t plain;
+    archive_t compact;
+    encoder_t encoder;
+
+    {
+        serializer_t out {plain};
+        serializer_t compact_out {compact};
+
+        plain_serializer_t(out, std::uint16_t{1001}, netty::telemetry::int32_t{-5});
+        plain_serializer_t(out, std::uint16_t{1002}, netty::telemetry::int16_t{7});
+        encoder.encode(compact_out, std::uint16_t{1001}, netty::telemetry::int32_t{-5}, 42);
+        encoder.encode(compact_out, std::uint16_t{1001}, netty::telemetry::int32_t{INT32_MAX}, 43);
+    }
+
+    counter c;
+    plain_decoder_t{}.decode(plain.data(), plain.size(), c);
+    CHECK_EQ(c.keys, std::vector<std::uint16_t>{1001, 1002});
+    CHECK_EQ(c.ints, std::vector<std::int64_t>{-5, 7});
+
+    // No on_timestamp() method in the visitor
+    counter cc;
+    compact_decoder_t{}.decode(compact.data(), compact.size(), cc);
+    CHECK_EQ(cc.keys, std::vector<std::uint16_t>{1001, 1001});
+    CHECK_EQ(cc.ints, std::vector<std::int64_t>{-5, INT32_MAX});
+}
+
+TEST_CASE("bad key index") {
+    using decoder_t = netty::telemetry::compact_key_value_deserializer<std::string, deserializer_t>;
+    using view_decoder_t = netty::telemetry::compact_key_value_view_deserializer<std::string>;
+
+    archive_t ar;
+
+    {
+        serializer_t out {ar};
+        netty::telemetry::compact_encoder<std::string, serializer_t> encoder;
+        encoder.encode(out, std::string{"counter"}, netty::telemetry::int32_t{1}, 42);
+
+        // Key index beyond the key table
+        out << netty::telemetry::type_of<netty::telemetry::int32_t>();
+        netty::telemetry::details::write_varint(out, 5);
+        netty::telemetry::details::write_varint(out, 0);
+        netty::telemetry::details::write_varint(out, 0);
+    }
+
+    auto c = std::make_shared<collector<std::string>>();
+    decoder_t{ar.data(), ar.size(), c};
+
+    CHECK_EQ(c->keys, std::vector<std::string>{"counter"});
+    CHECK_EQ(c->errors, 1);
+
+    view_collector<std::string> v;
+    view_decoder_t d;
+    d.decode(ar.data(), ar.size(), v);
+
+    CHECK_EQ(v.keys, std::vector<std::string>{"counter"});
+    CHECK_EQ(v.errors, 1);
+}
+
+TEST_CASE("previous values table") {
+    using prev_values_t = netty::telemetry::details::compact_prev_values<std::int32_t>;
+
+    prev_values_t prev;
+
+    // Table grows, keys are not lost
+    for (std::uint64_t key = 0; key < 100; key++)
+        prev.at(key * 7919) = key + 1;
+
+    for (std::uint64_t key = 0; key < 100; key++)
+        CHECK_EQ(prev.at(key * 7919), key + 1);
+
+    // Values are reset for the new batch
+    prev.reset();
+
+    for (std::uint64_t key = 0; key < 100; key++)
+        CHECK_EQ(prev.at(key * 7919), 0);
+
+    using compact_decoder_t = netty::telemetry::compact_key_value_view_deserializer<std::int32_t>;
+    using encoder_t = netty::telemetry::compact_encoder<std::int32_t, serializer_t>;
+
+    struct counter
+    {
+        std::vector<std::int64_t> ints;
+        int errors {0};
+
+        void on (std::int32_t, bool) {}
+        void on (std::int32_t, std::int64_t value) { ints.push_back(value); }
+        void on (std::int32_t, std::int32_t value) { ints.push_back(value); }
+        void on (std::int32_t, std::int16_t value) { ints.push_back(value); }
+        void on (std::int32_t, std::int8_t value) { ints.push_back(value); }
+        void on (std::int32_t, float) {}
+        void on (std::int32_t, double) {}
+        void on (std::int32_t, netty::telemetry::string_view_t) {}
+        void on_error (std::string const &) { errors++; }
+    };
+
+    compact_decoder_t decoder;
+
+    for (int batch = 0; batch < 3; batch++) {
+        archive_t ar;
+        encoder_t encoder;
+
+        {
+            serializer_t out {ar};
+
+            for (int i = 0; i < 2; i++) {
+                for (std::int32_t key = -50; key < 50; key++)
+                    encoder.encode(out, key, netty::telemetry::int64_t{key * 1000 + batch + i}, 0);
+            }
+        }
+
+        counter c;
+        decoder.decode(ar.data(), ar.size(), c);
+
+        REQUIRE_EQ(c.ints.size(), 200);
+        CHECK_EQ(c.errors, 0);
+
+        for (int i = 0; i < 2; i++) {
+            for (std::int32_t key = -50; key < 50; key++)
+                CHECK_EQ(c.ints[i * 100 + key + 50], key * 1000 + batch + i);
+        }
+    }
+}
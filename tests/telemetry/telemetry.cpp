@@ -5,6 +5,10 @@
 //
 // Changelog:
 //      2025.08.10 Initial version.
+//      2026.05.18 Added test for conflating mode and last-value cache.
+//      2026.05.20 Added test for compact encoding.
+//      2026.05.22 Added test for staging mode.
+//      2026.05.24 Added test for static visitor.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../doctest.h"
@@ -25,6 +29,8 @@
 #endif
 
 constexpr std::uint16_t PORT1 = 4242;
+constexpr std::uint16_t PORT2 = 4243;
+constexpr std::uint16_t PORT3 = 4244;
 constexpr int CONSUMER_LIMIT = 1;
 constexpr int MESSAGE_LIMIT = 100;
 
@@ -99,6 +105,75 @@ public:
     }
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// static_visitor (devirtualized, string keys and values are views into the receive buffer)
+/////////////////////////////////////////////////////////////////////////////////////////////////
+struct static_visitor
+{
+    using string_view_t = netty::telemetry::string_view_t;
+
+    void on (string_view_t key, bool value)
+    {
+        ++g_received_counter;
+        CHECK_EQ(key, string_view_t{"bool"});
+        CHECK_EQ(value, true);
+    }
+
+    void on (string_view_t key, netty::telemetry::int8_t value)
+    {
+        ++g_received_counter;
+        CHECK_EQ(key, string_view_t{"int8"});
+        CHECK_EQ(value, netty::telemetry::int8_t{42});
+    }
+
+    void on (string_view_t key, netty::telemetry::int16_t value)
+    {
+        ++g_received_counter;
+        CHECK_EQ(key, string_view_t{"int16"});
+        CHECK_EQ(value, netty::telemetry::int16_t{4242});
+    }
+
+    void on (string_view_t key, netty::telemetry::int32_t value)
+    {
+        ++g_received_counter;
+        CHECK_EQ(key, string_view_t{"int32"});
+        CHECK_EQ(value, netty::telemetry::int32_t{424242});
+    }
+
+    void on (string_view_t key, netty::telemetry::int64_t value)
+    {
+        ++g_received_counter;
+        CHECK_EQ(key, string_view_t{"int64"});
+        CHECK_EQ(value, netty::telemetry::int64_t{42424242});
+    }
+
+    void on (string_view_t key, netty::telemetry::float32_t value)
+    {
+        ++g_received_counter;
+        CHECK_EQ(key, string_view_t{"float32"});
+        CHECK_EQ(value, netty::telemetry::float32_t{3.14159});
+    }
+
+    void on (string_view_t key, netty::telemetry::float64_t value)
+    {
+        ++g_received_counter;
+        CHECK_EQ(key, string_view_t{"float64"});
+        CHECK_EQ(value, netty::telemetry::float64_t{2.71828});
+    }
+
+    void on (string_view_t key, string_view_t value)
+    {
+        ++g_received_counter;
+        CHECK_EQ(key, string_view_t{"hello"});
+        CHECK_EQ(value, string_view_t{"world"});
+    }
+
+    void on_error (std::string const & errstr)
+    {
+        LOGE("", "{}", errstr);
+    }
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // visitor_u16
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -259,8 +334,20 @@ struct consumer_traits<std::uint16_t>
 #endif
 };
 
+template <typename Consumer, typename Visitor>
+void assign_visitor (Consumer & c, std::shared_ptr<Visitor> v)
+{
+    c.set_visitor(v);
+}
+
+template <typename Consumer>
+void assign_visitor (Consumer & c, std::shared_ptr<static_visitor> v)
+{
+    c.set_static_visitor(v);
+}
+
 template <typename KeyT, typename Visitor>
-void test_body ()
+void test_body (netty::telemetry::encoding_enum encoding = netty::telemetry::encoding_enum::plain)
 {
     using producer_t = typename producer_traits<KeyT>::type;
     using consumer_t = typename consumer_traits<KeyT>::type;
@@ -282,6 +369,7 @@ void test_body ()
     producer_t prod1 {listener_opts};
     std::array<consumer_t, CONSUMER_LIMIT> consumers;
 
+    prod1.set_encoding(encoding);
     prod1.listen();
 
     auto prod1_thread = std::thread {[&] () {
@@ -296,7 +384,7 @@ void test_body ()
     std::array<std::thread, CONSUMER_LIMIT> consumer_threads;
 
     for (int i = 0; i < CONSUMER_LIMIT; i++) {
-        consumers[i].set_visitor(std::make_shared<Visitor>());
+        assign_visitor(consumers[i], std::make_shared<Visitor>());
 
         consumer_threads[i] = std::thread {[&, i] () {
             CHECK(tools::wait_atomic_bool(prod1_ready_flag));
@@ -343,3 +431,170 @@ TEST_CASE("main") {
     test_body<std::string, visitor>();
     test_body<std::uint16_t, visitor_u16>();
 }
+
+TEST_CASE("compact") {
+    test_body<std::string, visitor>(netty::telemetry::encoding_enum::compact);
+    test_body<std::uint16_t, visitor_u16>(netty::telemetry::encoding_enum::compact);
+}
+
+TEST_CASE("static visitor") {
+    test_body<std::string, static_visitor>();
+    test_body<std::string, static_visitor>(netty::telemetry::encoding_enum::compact);
+}
+
+TEST_CASE("conflation") {
+    using producer_t = netty::telemetry::producer<std::string
+        , netty::pubsub::suitable_publisher<serializer_traits_t>>;
+    using consumer_t = netty::telemetry::consumer<std::string
+        , netty::pubsub::suitable_subscriber<serializer_traits_t>>;
+
+    netty::startup_guard netty_startup;
+
+    g_accepted_counter.store(0);
+    g_received_counter.store(0);
+
+    std::atomic_bool prod_ready_flag {false};
+    netty::listener_options listener_opts;
+    listener_opts.saddr = netty::socket4_addr{netty::any_inet4_addr(), PORT2};
+
+    producer_t prod {listener_opts};
+    consumer_t cons {std::make_shared<visitor>()};
+
+    prod.set_conflating(true);
+    prod.set_last_value_cache(true);
+    prod.listen();
+
+    // No consumers yet, values are only cached
+    for (int i = 0; i < 1000; i++)
+        prod.push("int32", netty::telemetry::int32_t{i});
+
+    prod.push("int32", netty::telemetry::int32_t{424242});
+    prod.push("hello", "world");
+    prod.broadcast();
+
+    auto prod_thread = std::thread {[&] () {
+        prod.on_accepted([] (netty::socket4_addr) {
+            ++g_accepted_counter;
+        });
+
+        prod_ready_flag.store(true);
+        prod.run();
+    }};
+
+    auto cons_thread = std::thread {[&] () {
+        CHECK(tools::wait_atomic_bool(prod_ready_flag));
+
+        netty::connection_options conn_opts;
+        conn_opts.remote_saddr = netty::socket4_addr{netty::inet4_addr::localhost_addr_value, PORT2};
+        REQUIRE(cons.connect(conn_opts));
+        cons.run();
+    }};
+
+    CHECK(tools::wait_atomic_counter(g_accepted_counter, 1));
+
+    // Snapshot: "int32" and "hello"
+    CHECK(tools::wait_atomic_counter(g_received_counter, 2));
+
+    for (int i = 0; i < 1000; i++)
+        prod.push("int32", netty::telemetry::int32_t{i});
+
+    prod.push("int32", netty::telemetry::int32_t{424242});
+    prod.broadcast();
+
+    // Only the latest value is sent
+    CHECK(tools::wait_atomic_counter(g_received_counter, 3));
+    tools::sleep_ms(100);
+    CHECK_EQ(g_received_counter.load(), 3);
+
+    cons.interrupt();
+    cons_thread.join();
+
+    prod.interrupt();
+    prod_thread.join();
+}
+
+TEST_CASE("staging") {
+    using producer_t = producer_traits<std::string>::type;
+    using consumer_t = consumer_traits<std::string>::type;
+
+    constexpr int PUSHER_LIMIT = 4;
+    constexpr int ITERATION_LIMIT = 25;
+
+    netty::startup_guard netty_startup;
+
+    g_accepted_counter.store(0);
+    g_received_counter.store(0);
+
+    std::atomic_bool prod_ready_flag {false};
+    netty::listener_options listener_opts;
+    listener_opts.saddr = netty::socket4_addr{netty::any_inet4_addr(), PORT3};
+
+#if NETTY__TEST_ENCRYPTED_SOCKETS
+    listener_opts.tls.cert_file = std::string("./cert.pem");
+    listener_opts.tls.key_file = std::string("./key.pem");
+#endif
+
+    producer_t prod {listener_opts};
+    consumer_t cons {std::make_shared<visitor>()};
+
+    prod.set_staging(true);
+    prod.listen();
+
+    auto prod_thread = std::thread {[&] () {
+        prod.on_accepted([] (netty::socket4_addr) {
+            ++g_accepted_counter;
+        });
+
+        prod_ready_flag.store(true);
+        prod.run();
+    }};
+
+    auto cons_thread = std::thread {[&] () {
+        CHECK(tools::wait_atomic_bool(prod_ready_flag));
+
+        netty::connection_options conn_opts;
+        conn_opts.remote_saddr = netty::socket4_addr{netty::inet4_addr::localhost_addr_value, PORT3};
+
+#if NETTY__TEST_ENCRYPTED_SOCKETS
+        conn_opts.tls.cert_file = std::string("./cert.pem");
+#endif
+        REQUIRE(cons.connect(conn_opts));
+        cons.run();
+    }};
+
+    CHECK(tools::wait_atomic_counter(g_accepted_counter, 1));
+
+    std::atomic_int finished_counter {0};
+    std::array<std::thread, PUSHER_LIMIT> pushers;
+
+    for (auto & t: pushers) {
+        t = std::thread {[&] () {
+            for (int i = 0; i < ITERATION_LIMIT; i++) {
+                producer_traits<std::string>::push_data_to(prod);
+                tools::sleep_ms(1);
+            }
+
+            ++finished_counter;
+        }};
+    }
+
+    while (finished_counter.load() < PUSHER_LIMIT) {
+        prod.broadcast();
+        tools::sleep_ms(10);
+    }
+
+    for (auto & t: pushers)
+        t.join();
+
+    prod.broadcast();
+
+    // 8 - number of `on()` methods in the visitor.
+    CHECK(tools::wait_atomic_counter(g_received_counter, PUSHER_LIMIT * ITERATION_LIMIT * 8
+        , std::chrono::seconds{10}));
+
+    cons.interrupt();
+    cons_thread.join();
+
+    prod.interrupt();
+    prod_thread.join();
+}
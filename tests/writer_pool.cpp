@@ -30,6 +30,7 @@ public:
 
 private:
     archive_type _frame;
+    netty::writer_queue_limits _limits;
 
 public:
     archive_type acquire_frame (std::size_t frame_size)
@@ -37,8 +38,25 @@ public:
         return _frame;
     }
 
-    void enqueue (int /*priority*/, char const * /*data*/, std::size_t /*len*/)
-    {}
+    netty::writer_queue_limits const & limits () const noexcept
+    {
+        return _limits;
+    }
+
+    void set_limits (netty::writer_queue_limits const & limits)
+    {
+        _limits = limits;
+    }
+
+    netty::queue_occupancy occupancy () const noexcept
+    {
+        return netty::queue_occupancy{};
+    }
+
+    netty::queue_occupancy enqueue (int /*priority*/, char const * /*data*/, std::size_t /*len*/)
+    {
+        return netty::queue_occupancy{};
+    }
 
     void shift (std::size_t /*n*/)
     {}